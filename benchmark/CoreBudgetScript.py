@@ -0,0 +1,63 @@
+# Copyright (c)       2026 agent
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+##############################################################################################################
+#This Script sweeps the split of the cores between HPX and the CPU OpenCL runtime
+##############################################################################################################
+
+import os
+import csv
+import subprocess
+import sys
+import multiprocessing
+
+#for headless display in python
+import matplotlib
+matplotlib.use('agg')
+
+import matplotlib.pyplot as plt
+
+if(len(sys.argv) != 2):
+    print("Usage #build_directory")
+    sys.exit()
+
+############Parameters of the mixed workload#######
+num_tasks = 256
+num_elements = 65536
+num_launches = 10
+
+num_cores = multiprocessing.cpu_count()
+
+os.chdir(os.path.join(sys.argv[1], "benchmark/opencl/core_budget/"))
+if os.path.exists("core_budgetHPX.dat"):
+    os.remove("core_budgetHPX.dat")
+
+#profiling all splits, 0 is the unrestricted baseline
+for i in range(0, num_cores):
+    subprocess.call("./core_budgetHPX " + str(i) + " " + str(num_tasks) + " "
+                    + str(num_elements) + " " + str(num_launches)
+                    + " >> core_budgetHPX.dat", shell=True)
+
+opencl_cores = []
+total_time = []
+tasks_time = []
+kernels_time = []
+with open('core_budgetHPX.dat', 'r') as f:
+    reader = csv.reader(f, delimiter=' ', quoting=csv.QUOTE_NONE)
+    for row in reader:
+        opencl_cores.append(int(row[0]))
+        total_time.append(float(row[2]))
+        tasks_time.append(float(row[3]))
+        kernels_time.append(float(row[4]))
+
+plt.plot(opencl_cores, total_time, marker='o', label='Total')
+plt.plot(opencl_cores, tasks_time, marker='o', linestyle='--', label='HPX tasks')
+plt.plot(opencl_cores, kernels_time, marker='o', linestyle='--', label='OpenCL kernels')
+
+plt.xlabel('Cores reserved for OpenCL')
+plt.ylabel('Time in milliseconds')
+plt.title('Mixed HPX and OpenCL workload')
+plt.legend()
+plt.savefig('CoreBudget.png')
@@ -0,0 +1,149 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <hpxcl/opencl.hpp>
+
+using namespace hpx::opencl;
+
+// A compute bound kernel, every work item iterates a small recurrence
+static const char budget_src_str[] =
+"                                                                          \n"
+"   __kernel void iterate(__global double *data, __global int *steps)      \n"
+"   {                                                                      \n"
+"       size_t idx = get_global_id(0);                                     \n"
+"       double x = data[idx];                                              \n"
+"       for(int i = 0; i < steps[0]; i++)                                  \n"
+"           x = x * 0.999 + 0.001;                                         \n"
+"       data[idx] = x;                                                     \n"
+"   }                                                                      \n"
+"                                                                          \n";
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+typedef hpx::serialization::serialize_buffer<double> buffer_data_type;
+typedef hpx::serialization::serialize_buffer<int> buffer_parameter_type;
+
+static buffer_type budget_src( budget_src_str,
+                               sizeof(budget_src_str),
+                               buffer_type::init_mode::reference );
+
+// The parameters, parsed before HPX starts
+static std::size_t opencl_cores = 0;
+static std::size_t num_tasks = 0;
+static std::size_t num_elements = 0;
+static std::size_t num_launches = 10;
+
+// The steps per task and per work item
+static const int task_steps = 1000000;
+static const int kernel_steps = 10000;
+
+// The HPX part of the workload
+static double host_task()
+{
+    double x = 0.0;
+    for(int i = 0; i < task_steps; i++)
+        x = x * 0.999 + 0.001;
+    return x;
+}
+
+int hpx_main(boost::program_options::variables_map &)
+{
+    {
+        std::vector<device> devices =
+            create_local_devices( CL_DEVICE_TYPE_CPU, "OpenCL 1.1" ).get();
+
+        if(devices.size() < 1)
+        {
+            hpx::cerr << "No OpenCL CPU devices found!" << hpx::endl;
+            return hpx::finalize();
+        }
+
+        device cldevice = devices[0];
+
+        buffer_data_type data(num_elements);
+        for(std::size_t i = 0; i < num_elements; i++)
+            data[i] = 0.0;
+        buffer_parameter_type steps(1);
+        steps[0] = kernel_steps;
+
+        buffer dataBuffer = cldevice.create_buffer(CL_MEM_READ_WRITE,
+                                            num_elements * sizeof(double));
+        buffer stepsBuffer = cldevice.create_buffer(CL_MEM_READ_ONLY,
+                                                    sizeof(int));
+        dataBuffer.enqueue_write(0, data).get();
+        stepsBuffer.enqueue_write(0, steps).get();
+
+        program prog = cldevice.create_program_with_source(budget_src);
+        prog.build();
+
+        kernel iterate_kernel = prog.create_kernel("iterate");
+        iterate_kernel.set_arg(0, dataBuffer);
+        iterate_kernel.set_arg(1, stepsBuffer);
+
+        hpx::opencl::work_size<1> dim;
+        dim[0].offset = 0;
+        dim[0].size = num_elements;
+
+        // Warm up
+        iterate_kernel.enqueue(dim).get();
+
+        hpx::util::high_resolution_timer timer;
+
+        // Start the kernel chain
+        hpx::shared_future<void> kernel_future = hpx::make_ready_future();
+        for(std::size_t i = 0; i < num_launches; i++)
+            kernel_future = iterate_kernel.enqueue(dim, kernel_future);
+        hpx::future<double> kernels_done = kernel_future.then(
+            [&timer](hpx::shared_future<void> && f){
+                f.get();
+                return timer.elapsed();
+            });
+
+        // Run the HPX tasks alongside
+        std::vector<hpx::future<double> > task_futures;
+        task_futures.reserve(num_tasks);
+        for(std::size_t i = 0; i < num_tasks; i++)
+            task_futures.push_back(hpx::async(&host_task));
+        hpx::wait_all(task_futures);
+        double tasks_time = timer.elapsed();
+
+        double kernels_time = kernels_done.get();
+        double total_time = timer.elapsed();
+
+        // opencl_cores hpx_threads total[ms] tasks[ms] kernels[ms]
+        std::cout << opencl_cores << " " << hpx::get_os_thread_count() << " "
+                  << total_time * 1000.0 << " " << tasks_time * 1000.0 << " "
+                  << kernels_time * 1000.0 << std::endl;
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+
+    if (argc != 4 && argc != 5) {
+        std::cout << "Usage: " << argv[0]
+                  << " #opencl_cores #tasks #elements [#launches]";
+        exit(1);
+    }
+
+    opencl_cores = std::atol(argv[1]);
+    num_tasks = std::atol(argv[2]);
+    num_elements = std::atol(argv[3]);
+    if (argc == 5)
+        num_launches = std::atol(argv[4]);
+
+    // Split the processing units before HPX starts
+    return hpx::init(1, argv, core_budget_configuration(opencl_cores));
+}
@@ -6,14 +6,30 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/include/iostreams.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <array>
+#include <cmath>
+#include <vector>
 
 #include "examples/opencl/benchmark_vector/timer.hpp"
 #include <hpxcl/opencl.hpp>
 
 using namespace hpx::opencl;
 
+// K and TILE can be baked in with program::specialize(). Without them,
+// the kernel reads k from global memory and does not unroll.
 static const char dgemm_src_str[] = 
 "                                                                          \n"
+"   #ifdef K                                                               \n"
+"   #define K_VALUE K                                                      \n"
+"   #else                                                                  \n"
+"   #define K_VALUE (k[0])                                                 \n"
+"   #endif                                                                 \n"
+"   #ifndef TILE                                                           \n"
+"   #define TILE 1                                                         \n"
+"   #endif                                                                 \n"
+"                                                                          \n"
 "   __kernel void dgemm(__global double *A,__global double *B, __global double *C,__global int *m,__global int *n,__global int *k,__global double *alpha,__global double *beta)                       \n"
 "   {                                                                      \n"
 "       int ROW = get_global_id(1);                                 	   \n"
@@ -21,8 +37,12 @@ static const char dgemm_src_str[] =
 "                                                                          \n"
 "       if(ROW<(n[0]) && COL<(m[0])){                                            \n"
 "       	double sum = 0.0;                                              \n"
-"       	for(int i = 0;i<k[0];i++)                                         \n"
-"       		sum+=(alpha[0]) * A[ROW * (k[0]) + i] * B[i*(n[0])+COL];            \n"
+"       	int i = 0;                                                     \n"
+"       	for(;i + TILE <= K_VALUE;i += TILE)                             \n"
+"       		for(int t = 0;t < TILE;t++)                                \n"
+"       			sum+=(alpha[0]) * A[ROW * (K_VALUE) + i + t] * B[(i + t)*(n[0])+COL];\n"
+"       	for(;i<K_VALUE;i++)                                             \n"
+"       		sum+=(alpha[0]) * A[ROW * (K_VALUE) + i] * B[i*(n[0])+COL];     \n"
 "       	C[ROW*(n[0])+COL] = sum + (beta[0]) * C[ROW*(n[0])+COL];                \n"
 "       }                                                                  \n"
 "                                                                          \n"
@@ -41,13 +61,19 @@ static buffer_type dgemm_src( dgemm_src_str,
 int main(int argc, char* argv[])
 {
 
-	if (argc != 4) {
-		std::cout << "Usage: " << argv[0] << " #m #n #k";
+	if (argc != 4 && argc != 5) {
+		std::cout << "Usage: " << argv[0] << " #m #n #k [#tile]";
 		exit(1);
 	}
 
 	int *m,*n,*k,i;
 
+	// If a tile size is given, the generic kernel gets compared to a variant
+	// with K and TILE baked in
+	int tile = 0;
+	if (argc == 5)
+		tile = atoi(argv[4]);
+
 	//allocating memory for the vectors
 	m = new int[1];
 	n = new int[1];
@@ -191,11 +217,20 @@ int main(int argc, char* argv[])
     hpx::opencl::work_size<2> dim;
     dim[0].offset = 0;
     dim[0].size = (int)(std::pow(2,std::ceil(std::log(m[0])/std::log(2))));
-    dim[0].local_size = 32;
     dim[1].offset = 0;
     dim[1].size = (int)(std::pow(2,std::ceil(std::log(n[0])/std::log(2))));
-    dim[1].local_size = 32;
 
+    // Let the tuner pick the local work size. beta is 0, so the repeated
+    // tuning runs don't change the result. They are not part of the
+    // measurement.
+    double tuning_start = timer_stop();
+    dgemm_kernel.autotune(dim, std::vector<std::array<std::size_t, 2> >())
+                .get();
+    time -= timer_stop() - tuning_start;
+    dim[0].local_size = hpx::opencl::local_size_auto;
+    dim[1].local_size = hpx::opencl::local_size_auto;
+
+    hpx::util::high_resolution_timer kernel_timer;
     hpx::future<void> kernel_future = dgemm_kernel.enqueue(dim); 
 
     // Start reading the buffer ( With kernel_future as dependency.
@@ -204,10 +239,60 @@ int main(int argc, char* argv[])
 
     // Wait for the data to arrive
     auto data = read_future.get();
+    double generic_time = kernel_timer.elapsed() * 1000.0;
 
     //Printing the end timing result
     time+=timer_stop();
-    std:: cout << time << std::endl;
+
+    if (tile <= 0) {
+        std:: cout << time << std::endl;
+        return 0;
+    }
+
+    // Keep the generic result for validation
+    std::vector<double> generic_result(data.data(), data.data() + data.size());
+
+    // Reset C, so that both variants compute the same thing
+    for (i = 0; i < (m[0]*n[0]); i++) {
+        C[i] = 0.0;
+    }
+    CBuffer.enqueue_write(0, C_serialized).get();
+
+    // Create the specialized kernel. The variant gets built asynchronously
+    // and cached, so this is not part of the measurement.
+    kernel specialized_kernel =
+        prog.specialize("dgemm", {{"K", k[0]}, {"TILE", tile}});
+
+    set_arg_futures.clear();
+    set_arg_futures.push_back(specialized_kernel.set_arg_async(0, ABuffer));
+    set_arg_futures.push_back(specialized_kernel.set_arg_async(1, BBuffer));
+    set_arg_futures.push_back(specialized_kernel.set_arg_async(2, CBuffer));
+    set_arg_futures.push_back(specialized_kernel.set_arg_async(3, mBuffer));
+    set_arg_futures.push_back(specialized_kernel.set_arg_async(4, nBuffer));
+    set_arg_futures.push_back(specialized_kernel.set_arg_async(5, kBuffer));
+    set_arg_futures.push_back(specialized_kernel.set_arg_async(6, alphaBuffer));
+    set_arg_futures.push_back(specialized_kernel.set_arg_async(7, betaBuffer));
+    hpx::wait_all( set_arg_futures );
+
+    kernel_timer.restart();
+    kernel_future = specialized_kernel.enqueue(dim);
+    read_future = CBuffer.enqueue_read(0, C_serialized, kernel_future);
+    data = read_future.get();
+    double specialized_time = kernel_timer.elapsed() * 1000.0;
+
+    // Validate
+    for (i = 0; i < (m[0]*n[0]); i++) {
+        double diff = std::abs(generic_result[i] - data[i]);
+        if (diff > 1e-9 * std::abs(generic_result[i])) {
+            hpx::cerr << "Specialized result differs at " << i << "!"
+                      << hpx::endl;
+            return 1;
+        }
+    }
+
+    // generic[ms] specialized[ms] speedup
+    std::cout << generic_time << " " << specialized_time << " "
+              << generic_time / specialized_time << std::endl;
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,189 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <hpxcl/opencl.hpp>
+
+using namespace hpx::opencl;
+
+// Computes C = A * B for a block of rows of A and C. The rows get split
+// evenly between the devices, every device gets the whole B.
+static const char dgemm_src_str[] =
+"                                                                          \n"
+"   __kernel void dgemm_rows(__global double *A, __global double *B,       \n"
+"                            __global double *C, __global int *dims)        \n"
+"   {                                                                      \n"
+"       int rows = dims[0];                                                \n"
+"       int n = dims[1];                                                   \n"
+"       int k = dims[2];                                                   \n"
+"       int ROW = get_global_id(1);                                        \n"
+"       int COL = get_global_id(0);                                        \n"
+"                                                                          \n"
+"       if(ROW < rows && COL < n){                                         \n"
+"           double sum = 0.0;                                              \n"
+"           for(int i = 0; i < k; i++)                                     \n"
+"               sum += A[ROW * k + i] * B[i * n + COL];                    \n"
+"           C[ROW * n + COL] = sum;                                        \n"
+"       }                                                                  \n"
+"   }                                                                      \n"
+"                                                                          \n";
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+typedef hpx::serialization::serialize_buffer<double> buffer_data_type;
+typedef hpx::serialization::serialize_buffer<int> buffer_parameter_type;
+
+static buffer_type dgemm_src( dgemm_src_str,
+                              sizeof(dgemm_src_str),
+                              buffer_type::init_mode::reference );
+
+// Runs the dgemm on all given devices and returns the time in ms
+static double run_dgemm( std::vector<device> devices, int m, int n, int k,
+                         std::vector<double> & A, std::vector<double> & B,
+                         std::vector<double> & C )
+{
+
+    std::size_t num_devices = devices.size();
+
+    // The rows every device computes
+    std::vector<int> rows(num_devices + 1);
+    for(std::size_t i = 0; i <= num_devices; i++)
+        rows[i] = static_cast<int>(m * i / num_devices);
+
+    buffer_data_type B_serialized(B.data(), B.size(),
+                                  buffer_data_type::init_mode::reference);
+
+    std::vector<kernel> kernels;
+    std::vector<buffer> C_buffers;
+    for(std::size_t i = 0; i < num_devices; i++)
+    {
+        int num_rows = rows[i + 1] - rows[i];
+
+        buffer_data_type A_serialized(A.data() + rows[i] * k, num_rows * k,
+                                      buffer_data_type::init_mode::reference);
+        buffer_parameter_type dims(3);
+        dims[0] = num_rows;
+        dims[1] = n;
+        dims[2] = k;
+
+        buffer ABuffer = devices[i].create_buffer(CL_MEM_READ_ONLY,
+                                        num_rows * k * sizeof(double));
+        buffer BBuffer = devices[i].create_buffer(CL_MEM_READ_ONLY,
+                                        k * n * sizeof(double));
+        buffer CBuffer = devices[i].create_buffer(CL_MEM_WRITE_ONLY,
+                                        num_rows * n * sizeof(double));
+        buffer dimsBuffer = devices[i].create_buffer(CL_MEM_READ_ONLY,
+                                        3 * sizeof(int));
+
+        std::vector<hpx::future<void> > write_futures;
+        write_futures.push_back(ABuffer.enqueue_write(0, A_serialized));
+        write_futures.push_back(BBuffer.enqueue_write(0, B_serialized));
+        write_futures.push_back(dimsBuffer.enqueue_write(0, dims));
+        hpx::wait_all( write_futures );
+
+        program prog = devices[i].create_program_with_source(dgemm_src);
+        prog.build();
+
+        kernel dgemm_kernel = prog.create_kernel("dgemm_rows");
+        dgemm_kernel.set_arg(0, ABuffer);
+        dgemm_kernel.set_arg(1, BBuffer);
+        dgemm_kernel.set_arg(2, CBuffer);
+        dgemm_kernel.set_arg(3, dimsBuffer);
+
+        kernels.push_back(dgemm_kernel);
+        C_buffers.push_back(CBuffer);
+    }
+
+    // Run the kernels and read back the rows of C
+    hpx::util::high_resolution_timer timer;
+    std::vector<hpx::future<buffer_data_type> > read_futures;
+    for(std::size_t i = 0; i < num_devices; i++)
+    {
+        int num_rows = rows[i + 1] - rows[i];
+
+        hpx::opencl::work_size<2> dim;
+        dim[0].offset = 0;
+        dim[0].size = n;
+        dim[1].offset = 0;
+        dim[1].size = num_rows;
+
+        hpx::future<void> kernel_future = kernels[i].enqueue(dim);
+
+        buffer_data_type C_serialized(C.data() + rows[i] * n, num_rows * n,
+                                      buffer_data_type::init_mode::reference);
+        read_futures.push_back(
+            C_buffers[i].enqueue_read(0, C_serialized, kernel_future));
+    }
+    hpx::wait_all( read_futures );
+
+    return timer.elapsed() * 1000.0;
+
+}
+
+int main(int argc, char* argv[])
+{
+
+    if (argc != 4) {
+        std::cout << "Usage: " << argv[0] << " #m #n #k";
+        exit(1);
+    }
+
+    int m = atoi(argv[1]);
+    int n = atoi(argv[2]);
+    int k = atoi(argv[3]);
+
+    // Get the local CPU devices, once as a whole and once split into
+    // NUMA domains
+    std::vector<device> devices =
+        create_local_devices( CL_DEVICE_TYPE_CPU, "OpenCL 1.1" ).get();
+    std::vector<device> sub_devices =
+        create_local_devices( CL_DEVICE_TYPE_CPU, "OpenCL 1.1",
+                              device_partition(
+                                  device_partition::by_numa_domain) ).get();
+
+    // Check if any devices are available
+    if(devices.size() < 1)
+    {
+        hpx::cerr << "No OpenCL CPU devices found!" << hpx::endl;
+        return 1;
+    }
+
+    std::vector<double> A(m * k), B(k * n), C(m * n);
+    for (int i = 0; i < m * k; i++) {
+        A[i] = (double)(i + 1);
+    }
+    for (int i = 0; i < k * n; i++) {
+        B[i] = (double)(-i - 1);
+    }
+
+    double unpartitioned_time = run_dgemm(devices, m, n, k, A, B, C);
+    std::vector<double> unpartitioned_result = C;
+
+    double partitioned_time = run_dgemm(sub_devices, m, n, k, A, B, C);
+
+    // Validate
+    for (int i = 0; i < m * n; i++) {
+        double diff = std::abs(unpartitioned_result[i] - C[i]);
+        if (diff > 1e-9 * std::abs(unpartitioned_result[i])) {
+            hpx::cerr << "Partitioned result differs at " << i << "!"
+                      << hpx::endl;
+            return 1;
+        }
+    }
+
+    // unpartitioned[ms] partitioned[ms] speedup sub-devices
+    std::cout << unpartitioned_time << " " << partitioned_time << " "
+              << unpartitioned_time / partitioned_time << " "
+              << sub_devices.size() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include <hpxcl/opencl.hpp>
+
+using namespace hpx::opencl;
+
+// A compute bound kernel, every work item iterates a small recurrence
+static const char job_src_str[] =
+"                                                                          \n"
+"   __kernel void job(__global float *data)                                \n"
+"   {                                                                      \n"
+"       size_t idx = get_global_id(0);                                     \n"
+"       float x = data[idx];                                               \n"
+"       for(int i = 0; i < 1024; i++)                                      \n"
+"           x = x * 0.999f + 0.001f;                                       \n"
+"       data[idx] = x;                                                     \n"
+"   }                                                                      \n"
+"                                                                          \n";
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+typedef hpx::serialization::serialize_buffer<float> buffer_data_type;
+
+static buffer_type job_src( job_src_str,
+                            sizeof(job_src_str),
+                            buffer_type::init_mode::reference );
+
+// Runs all jobs and returns the time in ms.
+// If placement is NULL, the jobs get distributed round-robin.
+static double run_jobs( std::vector<device> & devices,
+                        std::vector<kernel> & kernels,
+                        const std::vector<std::size_t> & job_sizes,
+                        device_placement * placement )
+{
+
+    std::vector<hpx::future<void> > job_futures;
+    job_futures.reserve(job_sizes.size());
+
+    hpx::util::high_resolution_timer timer;
+    for(std::size_t j = 0; j < job_sizes.size(); j++)
+    {
+        hpx::opencl::work_size<1> dim;
+        dim[0].offset = 0;
+        dim[0].size = job_sizes[j];
+
+        if(placement == NULL)
+        {
+            job_futures.push_back(
+                kernels[j % kernels.size()].enqueue(dim));
+            continue;
+        }
+
+        placement_hint hint;
+        hint.work = static_cast<double>(job_sizes[j]);
+        device dev = placement->pick_device(hint);
+
+        std::size_t i = 0;
+        while(devices[i].get_id() != dev.get_id())
+            i++;
+
+        job_futures.push_back( placement->release_on_completion(
+            dev, kernels[i].enqueue(dim), hint.work) );
+    }
+    hpx::wait_all( job_futures );
+
+    return timer.elapsed() * 1000.0;
+
+}
+
+int main(int argc, char* argv[])
+{
+
+    if (argc != 3) {
+        std::cout << "Usage: " << argv[0] << " #jobs #max_job_elements";
+        exit(1);
+    }
+
+    std::size_t num_jobs = std::atol(argv[1]);
+    std::size_t max_job_elements = std::atol(argv[2]);
+
+    // Get available OpenCL Devices.
+    std::vector<device> devices = create_all_devices(CL_DEVICE_TYPE_ALL,
+                                                     "OpenCL 1.1" ).get();
+
+    // Check if any devices are available
+    if(devices.size() < 1)
+    {
+        hpx::cerr << "No OpenCL devices found!" << hpx::endl;
+        return 1;
+    }
+
+    // Job sizes between 1/8 and all of max_job_elements
+    std::srand(42);
+    std::vector<std::size_t> job_sizes(num_jobs);
+    for(std::size_t j = 0; j < num_jobs; j++)
+    {
+        std::size_t size = max_job_elements >> (std::rand() % 4);
+        job_sizes[j] = size > 0 ? size : 1;
+    }
+
+    // Prepare one kernel per device
+    std::vector<kernel> kernels;
+    for(auto & dev : devices)
+    {
+        buffer_data_type data(max_job_elements);
+        for(std::size_t i = 0; i < max_job_elements; i++)
+            data[i] = 0.0f;
+
+        buffer dataBuffer = dev.create_buffer(CL_MEM_READ_WRITE,
+                                        max_job_elements * sizeof(float));
+        dataBuffer.enqueue_write(0, data).get();
+
+        program prog = dev.create_program_with_source(job_src);
+        prog.build();
+
+        kernel job_kernel = prog.create_kernel("job");
+        job_kernel.set_arg(0, dataBuffer);
+        kernels.push_back(job_kernel);
+    }
+
+    device_placement placement(devices);
+    placement.calibrate();
+
+    // Warm up
+    run_jobs(devices, kernels, job_sizes, NULL);
+
+    double round_robin_time = run_jobs(devices, kernels, job_sizes, NULL);
+    double placement_time = run_jobs(devices, kernels, job_sizes, &placement);
+
+    // round_robin[ms] placement[ms] speedup devices
+    std::cout << round_robin_time << " " << placement_time << " "
+              << round_robin_time / placement_time << " "
+              << devices.size() << std::endl;
+
+    return 0;
+}
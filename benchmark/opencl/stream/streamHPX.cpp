@@ -0,0 +1,180 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <hpxcl/opencl.hpp>
+
+using namespace hpx::opencl;
+
+// The STREAM triad. Runs on the CPU devices once as a whole and once split
+// into one sub-device per NUMA domain, with the data split evenly between
+// the devices.
+static const char stream_src_str[] =
+"                                                                          \n"
+"   __kernel void STREAM_Triad(__global double *a, __global double *b,     \n"
+"                              __global double *c, __global double *scale) \n"
+"   {                                                                      \n"
+"       size_t idx = get_global_id(0);                                     \n"
+"       a[idx] = b[idx] + (*scale) * c[idx];                               \n"
+"   }                                                                      \n"
+"                                                                          \n";
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+typedef hpx::serialization::serialize_buffer<double> buffer_data_type;
+
+static buffer_type stream_src( stream_src_str,
+                               sizeof(stream_src_str),
+                               buffer_type::init_mode::reference );
+
+static const double scale_value = 3.0;
+
+// Runs the triad on all given devices and returns the bandwidth in GB/s
+static double run_triad( std::vector<device> devices, std::size_t num_elements,
+                         std::size_t num_iterations )
+{
+
+    std::size_t num_devices = devices.size();
+
+    // The part of the vectors every device works on
+    std::vector<std::size_t> offsets(num_devices + 1);
+    for(std::size_t i = 0; i <= num_devices; i++)
+        offsets[i] = num_elements * i / num_devices;
+
+    std::vector<kernel> kernels;
+    std::vector<buffer> a_buffers;
+    for(std::size_t i = 0; i < num_devices; i++)
+    {
+        std::size_t size = offsets[i + 1] - offsets[i];
+
+        // Initialize the data on the device, this also places the pages
+        // next to the device on first touch
+        buffer_data_type b_data(size), c_data(size), scale_data(1);
+        for(std::size_t j = 0; j < size; j++){
+            b_data[j] = 1.0;
+            c_data[j] = 2.0;
+        }
+        scale_data[0] = scale_value;
+
+        buffer a = devices[i].create_buffer(CL_MEM_READ_WRITE,
+                                            size * sizeof(double));
+        buffer b = devices[i].create_buffer(CL_MEM_READ_ONLY,
+                                            size * sizeof(double));
+        buffer c = devices[i].create_buffer(CL_MEM_READ_ONLY,
+                                            size * sizeof(double));
+        buffer scale = devices[i].create_buffer(CL_MEM_READ_ONLY,
+                                                sizeof(double));
+
+        std::vector<hpx::future<void> > write_futures;
+        write_futures.push_back(b.enqueue_write(0, b_data));
+        write_futures.push_back(c.enqueue_write(0, c_data));
+        write_futures.push_back(scale.enqueue_write(0, scale_data));
+        hpx::wait_all( write_futures );
+
+        program prog = devices[i].create_program_with_source(stream_src);
+        prog.build();
+
+        kernel triad = prog.create_kernel("STREAM_Triad");
+        triad.set_arg(0, a);
+        triad.set_arg(1, b);
+        triad.set_arg(2, c);
+        triad.set_arg(3, scale);
+
+        kernels.push_back(triad);
+        a_buffers.push_back(a);
+    }
+
+    // Warm up
+    std::vector<hpx::future<void> > kernel_futures;
+    for(std::size_t i = 0; i < num_devices; i++)
+    {
+        hpx::opencl::work_size<1> dim;
+        dim[0].offset = 0;
+        dim[0].size = offsets[i + 1] - offsets[i];
+        kernel_futures.push_back(kernels[i].enqueue(dim));
+    }
+    hpx::wait_all( kernel_futures );
+
+    // Run
+    hpx::util::high_resolution_timer timer;
+    for(std::size_t it = 0; it < num_iterations; it++)
+    {
+        kernel_futures.clear();
+        for(std::size_t i = 0; i < num_devices; i++)
+        {
+            hpx::opencl::work_size<1> dim;
+            dim[0].offset = 0;
+            dim[0].size = offsets[i + 1] - offsets[i];
+            kernel_futures.push_back(kernels[i].enqueue(dim));
+        }
+        hpx::wait_all( kernel_futures );
+    }
+    double time = timer.elapsed();
+
+    // Validate
+    for(std::size_t i = 0; i < num_devices; i++)
+    {
+        std::size_t size = offsets[i + 1] - offsets[i];
+        buffer_data_type result =
+            a_buffers[i].enqueue_read(0, buffer_data_type(size)).get();
+        for(std::size_t j = 0; j < size; j++){
+            if(std::abs(result[j] - (1.0 + scale_value * 2.0)) > 1e-9){
+                hpx::cerr << "Triad result is wrong!" << hpx::endl;
+                std::exit(1);
+            }
+        }
+    }
+
+    // The triad moves three vectors per iteration
+    double bytes = 3.0 * sizeof(double) * num_elements * num_iterations;
+    return bytes / time / 1e9;
+
+}
+
+int main(int argc, char* argv[])
+{
+
+    if (argc != 2 && argc != 3) {
+        std::cout << "Usage: " << argv[0] << " #elements [#iterations]";
+        exit(1);
+    }
+
+    std::size_t num_elements = std::atol(argv[1]);
+    std::size_t num_iterations = 10;
+    if (argc == 3)
+        num_iterations = std::atol(argv[2]);
+
+    // Get the local CPU devices, once as a whole and once split into
+    // NUMA domains
+    std::vector<device> devices =
+        create_local_devices( CL_DEVICE_TYPE_CPU, "OpenCL 1.1" ).get();
+    std::vector<device> sub_devices =
+        create_local_devices( CL_DEVICE_TYPE_CPU, "OpenCL 1.1",
+                              device_partition(
+                                  device_partition::by_numa_domain) ).get();
+
+    // Check if any devices are available
+    if(devices.size() < 1)
+    {
+        hpx::cerr << "No OpenCL CPU devices found!" << hpx::endl;
+        return 1;
+    }
+
+    double unpartitioned = run_triad(devices, num_elements, num_iterations);
+    double partitioned = run_triad(sub_devices, num_elements, num_iterations);
+
+    // unpartitioned[GB/s] partitioned[GB/s] devices sub-devices
+    std::cout << unpartitioned << " " << partitioned << " "
+              << devices.size() << " " << sub_devices.size() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,433 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "benchmarks.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+    //###########################################################################
+    //Kernels
+    //###########################################################################
+
+    const char stream_src[] =
+    "#pragma OPENCL EXTENSION cl_khr_fp64 : enable                             \n"
+    "                                                                          \n"
+    "__kernel void stream_copy(__global const double *a, __global double *c)  \n"
+    "{                                                                         \n"
+    "    size_t i = get_global_id(0);                                          \n"
+    "    c[i] = a[i];                                                          \n"
+    "}                                                                         \n"
+    "                                                                          \n"
+    "__kernel void stream_scale(__global double *b, __global const double *c, \n"
+    "                           __global const double *scalar)                 \n"
+    "{                                                                         \n"
+    "    size_t i = get_global_id(0);                                          \n"
+    "    b[i] = scalar[0] * c[i];                                              \n"
+    "}                                                                         \n"
+    "                                                                          \n"
+    "__kernel void stream_add(__global const double *a,                       \n"
+    "                         __global const double *b, __global double *c)   \n"
+    "{                                                                         \n"
+    "    size_t i = get_global_id(0);                                          \n"
+    "    c[i] = a[i] + b[i];                                                   \n"
+    "}                                                                         \n"
+    "                                                                          \n"
+    "__kernel void stream_triad(__global double *a, __global const double *b, \n"
+    "                           __global const double *c,                      \n"
+    "                           __global const double *scalar)                 \n"
+    "{                                                                         \n"
+    "    size_t i = get_global_id(0);                                          \n"
+    "    a[i] = b[i] + scalar[0] * c[i];                                       \n"
+    "}                                                                         \n";
+
+    // beta is 0, so repeated launches give the same result
+    const char dgemm_src[] =
+    "#pragma OPENCL EXTENSION cl_khr_fp64 : enable                             \n"
+    "                                                                          \n"
+    "__kernel void dgemm(__global const double *A, __global const double *B, \n"
+    "                    __global double *C, __global const int *size)        \n"
+    "{                                                                         \n"
+    "    int n = size[0];                                                      \n"
+    "    int row = get_global_id(1);                                           \n"
+    "    int col = get_global_id(0);                                           \n"
+    "                                                                          \n"
+    "    double sum = 0.0;                                                     \n"
+    "    for(int i = 0; i < n; i++)                                            \n"
+    "        sum += A[row * n + i] * B[i * n + col];                           \n"
+    "    C[row * n + col] = sum;                                               \n"
+    "}                                                                         \n";
+
+    // CSR matrix, one work item per row
+    const char smvp_src[] =
+    "#pragma OPENCL EXTENSION cl_khr_fp64 : enable                             \n"
+    "                                                                          \n"
+    "__kernel void smvp(__global const double *data,                          \n"
+    "                   __global const int *indices,                          \n"
+    "                   __global const int *pointers,                         \n"
+    "                   __global const double *x, __global double *y)         \n"
+    "{                                                                         \n"
+    "    int row = get_global_id(0);                                           \n"
+    "                                                                          \n"
+    "    double sum = 0.0;                                                     \n"
+    "    for(int i = pointers[row]; i < pointers[row + 1]; i++)                \n"
+    "        sum += data[i] * x[indices[i]];                                   \n"
+    "    y[row] = sum;                                                         \n"
+    "}                                                                         \n";
+
+    // Three point stencil on the inner points
+    const char stencil_src[] =
+    "#pragma OPENCL EXTENSION cl_khr_fp64 : enable                             \n"
+    "                                                                          \n"
+    "__kernel void stencil(__global const double *in, __global double *out,   \n"
+    "                      __global const double *s)                          \n"
+    "{                                                                         \n"
+    "    size_t i = get_global_id(0) + 1;                                      \n"
+    "    out[i] = s[0] * in[i - 1] + s[1] * in[i] + s[2] * in[i + 1];          \n"
+    "}                                                                         \n";
+
+    // The nonzeros per row of the smvp matrix
+    const std::size_t smvp_row_length = 16;
+
+    //###########################################################################
+    //Helpers
+    //###########################################################################
+
+    template <typename T>
+    suite::kernel_arg make_arg(const std::vector<T>& values, bool read_only)
+    {
+        suite::kernel_arg arg;
+        arg.data.resize(values.size() * sizeof(T));
+        if(!values.empty())
+            std::memcpy(arg.data.data(), values.data(), arg.data.size());
+        arg.read_only = read_only;
+        return arg;
+    }
+
+    std::vector<double> to_doubles(const std::vector<char>& data)
+    {
+        std::vector<double> values(data.size() / sizeof(double));
+        if(!values.empty())
+            std::memcpy(values.data(), data.data(),
+                        values.size() * sizeof(double));
+        return values;
+    }
+
+    bool is_close(double result, double expected)
+    {
+        return std::abs(result - expected)
+            <= 1e-9 * std::max(1.0, std::abs(expected));
+    }
+
+    suite::benchmark_case
+    make_case(const std::string& name, std::size_t size,
+              const char* source, const std::string& kernel_name)
+    {
+        suite::benchmark_case bench;
+        bench.name = name;
+        bench.size = size;
+        bench.source = source;
+        bench.kernel_name = kernel_name;
+        bench.dims = 1;
+        bench.global_size[0] = size;
+        bench.global_size[1] = 1;
+        bench.result_arg = 0;
+        bench.flops = 0;
+        bench.bytes = 0;
+        return bench;
+    }
+
+    //###########################################################################
+    //Benchmarks
+    //###########################################################################
+
+    std::vector<suite::benchmark_case> make_stream_cases(std::size_t size)
+    {
+        double n = static_cast<double>(size);
+
+        std::shared_ptr<std::vector<double> > a(new std::vector<double>(size));
+        std::shared_ptr<std::vector<double> > b(new std::vector<double>(size));
+        std::shared_ptr<std::vector<double> > c(new std::vector<double>(size));
+        std::vector<double> scalar(1, 3.0);
+        std::vector<double> zeros(size, 0.0);
+
+        for(std::size_t i = 0; i < size; i++){
+            (*a)[i] = static_cast<double>(i % 13);
+            (*b)[i] = 2.0 + static_cast<double>(i % 7);
+            (*c)[i] = 0.5 * static_cast<double>(i % 5);
+        }
+
+        std::vector<suite::benchmark_case> cases;
+
+        // c = a
+        suite::benchmark_case copy =
+            make_case("stream_copy", size, stream_src, "stream_copy");
+        copy.args.push_back(make_arg(*a, true));
+        copy.args.push_back(make_arg(zeros, false));
+        copy.result_arg = 1;
+        copy.bytes = 2 * sizeof(double) * n;
+        copy.validate = [a](const std::vector<char>& data) {
+            std::vector<double> result = to_doubles(data);
+            for(std::size_t i = 0; i < result.size(); i++)
+                if(!is_close(result[i], (*a)[i]))
+                    return false;
+            return result.size() == a->size();
+        };
+        cases.push_back(copy);
+
+        // b = scalar * c
+        suite::benchmark_case scale =
+            make_case("stream_scale", size, stream_src, "stream_scale");
+        scale.args.push_back(make_arg(zeros, false));
+        scale.args.push_back(make_arg(*c, true));
+        scale.args.push_back(make_arg(scalar, true));
+        scale.result_arg = 0;
+        scale.flops = n;
+        scale.bytes = 2 * sizeof(double) * n;
+        scale.validate = [c](const std::vector<char>& data) {
+            std::vector<double> result = to_doubles(data);
+            for(std::size_t i = 0; i < result.size(); i++)
+                if(!is_close(result[i], 3.0 * (*c)[i]))
+                    return false;
+            return result.size() == c->size();
+        };
+        cases.push_back(scale);
+
+        // c = a + b
+        suite::benchmark_case add =
+            make_case("stream_add", size, stream_src, "stream_add");
+        add.args.push_back(make_arg(*a, true));
+        add.args.push_back(make_arg(*b, true));
+        add.args.push_back(make_arg(zeros, false));
+        add.result_arg = 2;
+        add.flops = n;
+        add.bytes = 3 * sizeof(double) * n;
+        add.validate = [a, b](const std::vector<char>& data) {
+            std::vector<double> result = to_doubles(data);
+            for(std::size_t i = 0; i < result.size(); i++)
+                if(!is_close(result[i], (*a)[i] + (*b)[i]))
+                    return false;
+            return result.size() == a->size();
+        };
+        cases.push_back(add);
+
+        // a = b + scalar * c
+        suite::benchmark_case triad =
+            make_case("stream_triad", size, stream_src, "stream_triad");
+        triad.args.push_back(make_arg(zeros, false));
+        triad.args.push_back(make_arg(*b, true));
+        triad.args.push_back(make_arg(*c, true));
+        triad.args.push_back(make_arg(scalar, true));
+        triad.result_arg = 0;
+        triad.flops = 2 * n;
+        triad.bytes = 3 * sizeof(double) * n;
+        triad.validate = [b, c](const std::vector<char>& data) {
+            std::vector<double> result = to_doubles(data);
+            for(std::size_t i = 0; i < result.size(); i++)
+                if(!is_close(result[i], (*b)[i] + 3.0 * (*c)[i]))
+                    return false;
+            return result.size() == b->size();
+        };
+        cases.push_back(triad);
+
+        return cases;
+    }
+
+    std::vector<suite::benchmark_case> make_dgemm_cases(std::size_t n)
+    {
+        std::shared_ptr<std::vector<double> > A(new std::vector<double>(n * n));
+        std::shared_ptr<std::vector<double> > B(new std::vector<double>(n * n));
+        std::vector<double> C(n * n, 0.0);
+        std::vector<int> size(1, static_cast<int>(n));
+
+        for(std::size_t i = 0; i < n * n; i++){
+            (*A)[i] = static_cast<double>(i % 11) / 11.0;
+            (*B)[i] = static_cast<double>(i % 17) / 17.0 - 0.5;
+        }
+
+        suite::benchmark_case bench = make_case("dgemm", n, dgemm_src, "dgemm");
+        bench.args.push_back(make_arg(*A, true));
+        bench.args.push_back(make_arg(*B, true));
+        bench.args.push_back(make_arg(C, false));
+        bench.args.push_back(make_arg(size, true));
+        bench.dims = 2;
+        bench.global_size[0] = n;
+        bench.global_size[1] = n;
+        bench.result_arg = 2;
+        bench.flops = 2.0 * n * n * n;
+        bench.bytes = 3.0 * sizeof(double) * n * n;
+
+        // checking every row costs as much as the benchmark, check a few
+        bench.validate = [A, B, n](const std::vector<char>& data) {
+            std::vector<double> result = to_doubles(data);
+            if(result.size() != n * n)
+                return false;
+
+            std::size_t row_step = std::max<std::size_t>(1, n / 16);
+            for(std::size_t row = 0; row < n; row += row_step){
+                for(std::size_t col = 0; col < n; col++){
+                    double sum = 0.0;
+                    for(std::size_t i = 0; i < n; i++)
+                        sum += (*A)[row * n + i] * (*B)[i * n + col];
+                    if(!is_close(result[row * n + col], sum))
+                        return false;
+                }
+            }
+            return true;
+        };
+
+        return std::vector<suite::benchmark_case>(1, bench);
+    }
+
+    std::vector<suite::benchmark_case> make_smvp_cases(std::size_t rows)
+    {
+        std::size_t row_length = std::min(smvp_row_length, rows);
+
+        std::shared_ptr<std::vector<double> > data(new std::vector<double>());
+        std::shared_ptr<std::vector<int> > indices(new std::vector<int>());
+        std::shared_ptr<std::vector<int> > pointers(new std::vector<int>());
+        std::shared_ptr<std::vector<double> > x(new std::vector<double>(rows));
+        std::vector<double> y(rows, 0.0);
+
+        // spread the nonzeros of every row over the columns
+        std::size_t stride = rows / row_length;
+        for(std::size_t row = 0; row < rows; row++){
+            pointers->push_back(static_cast<int>(data->size()));
+            for(std::size_t j = 0; j < row_length; j++){
+                std::size_t col = (row + j * stride) % rows;
+                data->push_back(1.0 + static_cast<double>((row + j) % 9));
+                indices->push_back(static_cast<int>(col));
+            }
+        }
+        pointers->push_back(static_cast<int>(data->size()));
+
+        for(std::size_t i = 0; i < rows; i++)
+            (*x)[i] = static_cast<double>(i % 23) - 11.0;
+
+        suite::benchmark_case bench = make_case("smvp", rows, smvp_src, "smvp");
+        bench.args.push_back(make_arg(*data, true));
+        bench.args.push_back(make_arg(*indices, true));
+        bench.args.push_back(make_arg(*pointers, true));
+        bench.args.push_back(make_arg(*x, true));
+        bench.args.push_back(make_arg(y, false));
+        bench.result_arg = 4;
+        bench.flops = 2.0 * data->size();
+        bench.bytes = (sizeof(double) + sizeof(int)) * data->size()
+                    + sizeof(int) * pointers->size()
+                    + 2.0 * sizeof(double) * rows;
+        bench.validate = [data, indices, pointers, x](
+                                const std::vector<char>& result_data) {
+            std::vector<double> result = to_doubles(result_data);
+            if(result.size() != x->size())
+                return false;
+
+            for(std::size_t row = 0; row < result.size(); row++){
+                double sum = 0.0;
+                for(int i = (*pointers)[row]; i < (*pointers)[row + 1]; i++)
+                    sum += (*data)[i] * (*x)[(*indices)[i]];
+                if(!is_close(result[row], sum))
+                    return false;
+            }
+            return true;
+        };
+
+        return std::vector<suite::benchmark_case>(1, bench);
+    }
+
+    std::vector<suite::benchmark_case> make_stencil_cases(std::size_t size)
+    {
+        if(size < 3)
+            throw std::invalid_argument("stencil needs at least 3 elements");
+
+        std::shared_ptr<std::vector<double> > in(new std::vector<double>(size));
+        std::vector<double> out(size, 0.0);
+        std::vector<double> s(3);
+        s[0] = 0.5;
+        s[1] = 1.0;
+        s[2] = 0.5;
+
+        for(std::size_t i = 0; i < size; i++)
+            (*in)[i] = 0.5 * static_cast<double>(i % 19);
+
+        suite::benchmark_case bench =
+            make_case("stencil", size, stencil_src, "stencil");
+        bench.args.push_back(make_arg(*in, true));
+        bench.args.push_back(make_arg(out, false));
+        bench.args.push_back(make_arg(s, true));
+        bench.global_size[0] = size - 2;
+        bench.result_arg = 1;
+        bench.flops = 5.0 * (size - 2);
+        bench.bytes = 2.0 * sizeof(double) * size;
+        bench.validate = [in, s](const std::vector<char>& data) {
+            std::vector<double> result = to_doubles(data);
+            if(result.size() != in->size())
+                return false;
+
+            for(std::size_t i = 1; i + 1 < result.size(); i++){
+                double expected = s[0] * (*in)[i - 1] + s[1] * (*in)[i]
+                                + s[2] * (*in)[i + 1];
+                if(!is_close(result[i], expected))
+                    return false;
+            }
+            return result.front() == 0.0 && result.back() == 0.0;
+        };
+
+        return std::vector<suite::benchmark_case>(1, bench);
+    }
+}
+
+std::vector<std::string>
+suite::get_families()
+{
+    std::vector<std::string> families;
+    families.push_back("stream");
+    families.push_back("dgemm");
+    families.push_back("smvp");
+    families.push_back("stencil");
+    return families;
+}
+
+std::vector<std::size_t>
+suite::get_default_sizes(const std::string& family)
+{
+    std::vector<std::size_t> sizes;
+    if(family == "stream" || family == "stencil"){
+        sizes.push_back(1 << 16);
+        sizes.push_back(1 << 20);
+        sizes.push_back(1 << 24);
+    } else if(family == "dgemm"){
+        sizes.push_back(128);
+        sizes.push_back(512);
+        sizes.push_back(1024);
+    } else if(family == "smvp"){
+        sizes.push_back(1 << 14);
+        sizes.push_back(1 << 17);
+        sizes.push_back(1 << 20);
+    }
+    return sizes;
+}
+
+std::vector<suite::benchmark_case>
+suite::make_cases(const std::string& family, std::size_t size)
+{
+    if(size == 0)
+        throw std::invalid_argument("problem size must not be 0");
+
+    if(family == "stream")
+        return make_stream_cases(size);
+    if(family == "dgemm")
+        return make_dgemm_cases(size);
+    if(family == "smvp")
+        return make_smvp_cases(size);
+    if(family == "stencil")
+        return make_stencil_cases(size);
+
+    throw std::invalid_argument("unknown benchmark '" + family + "'");
+}
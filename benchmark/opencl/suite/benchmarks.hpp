@@ -0,0 +1,66 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BENCHMARK_OPENCL_SUITE_BENCHMARKS_HPP_
+#define BENCHMARK_OPENCL_SUITE_BENCHMARKS_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace suite {
+
+    // A kernel argument. All arguments are buffers, scalars get passed as
+    // buffers of one element.
+    struct kernel_arg
+    {
+        std::vector<char> data;
+        bool read_only;
+    };
+
+    // One kernel launch with its data. Native OpenCL and HPXCL run the same
+    // case, so both see identical sources, sizes and inputs.
+    struct benchmark_case
+    {
+        std::string name;
+        std::size_t size;
+
+        std::string source;
+        std::string kernel_name;
+        std::vector<kernel_arg> args;
+
+        std::size_t dims;
+        std::size_t global_size[2];
+
+        // The argument that holds the result
+        std::size_t result_arg;
+
+        // The least work of one launch: floating point operations, and
+        // bytes moved from and to device memory if every input gets read
+        // and every output written once
+        double flops;
+        double bytes;
+
+        // Checks the contents of the result argument
+        std::function<bool(const std::vector<char>&)> validate;
+    };
+
+    // The benchmark families: stream, dgemm, smvp and stencil
+    std::vector<std::string> get_families();
+
+    // The default problem sizes of a family
+    std::vector<std::size_t> get_default_sizes(const std::string& family);
+
+    // The cases of a family. stream has one case per STREAM kernel.
+    //
+    // size is the vector length for stream and stencil, the matrix
+    // dimension for dgemm and the number of rows for smvp.
+    std::vector<benchmark_case> make_cases(const std::string& family,
+                                           std::size_t size);
+
+}
+
+#endif
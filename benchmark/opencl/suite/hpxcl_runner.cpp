@@ -0,0 +1,96 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "runners.hpp"
+
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <vector>
+
+using namespace hpx::opencl;
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+namespace {
+
+    hpx::future<void>
+    enqueue(const kernel& kern, const suite::benchmark_case& bench)
+    {
+        if(bench.dims == 1)
+        {
+            work_size<1> dim;
+            dim[0].offset = 0;
+            dim[0].size = bench.global_size[0];
+            return kern.enqueue(dim);
+        }
+
+        work_size<2> dim;
+        for(std::size_t i = 0; i < 2; i++)
+        {
+            dim[i].offset = 0;
+            dim[i].size = bench.global_size[i];
+        }
+        return kern.enqueue(dim);
+    }
+}
+
+suite::hpxcl_runner::hpxcl_runner(device device_)
+  : device(device_)
+{}
+
+suite::run_result
+suite::hpxcl_runner::run(const benchmark_case& bench, std::size_t warmup,
+                         std::size_t iterations)
+{
+    // build the kernel, the source needs its terminating zero
+    buffer_type source(bench.source.c_str(), bench.source.size() + 1,
+                       buffer_type::init_mode::copy);
+    program prog = device.create_program_with_source(source);
+    prog.build();
+
+    kernel kern = prog.create_kernel(bench.kernel_name);
+
+    // upload the arguments
+    std::vector<buffer> buffers;
+    std::vector<hpx::future<void> > futures;
+    for(std::size_t i = 0; i < bench.args.size(); i++)
+    {
+        const kernel_arg& arg = bench.args[i];
+
+        cl_mem_flags flags = arg.read_only ? CL_MEM_READ_ONLY
+                                           : CL_MEM_READ_WRITE;
+        buffer buf = device.create_buffer(flags, arg.data.size());
+        buffers.push_back(buf);
+
+        buffer_type data(arg.data.data(), arg.data.size(),
+                         buffer_type::init_mode::reference);
+        futures.push_back(buf.enqueue_write(0, data));
+        futures.push_back(kern.set_arg_async(static_cast<cl_uint>(i), buf));
+    }
+    hpx::wait_all(futures);
+    for(auto & future : futures)
+        future.get();
+
+    // run
+    run_result result;
+    for(std::size_t it = 0; it < warmup + iterations; it++)
+    {
+        hpx::util::high_resolution_timer timer;
+
+        enqueue(kern, bench).get();
+
+        double time = timer.elapsed();
+        if(it >= warmup)
+            result.times.push_back(time);
+    }
+
+    // validate
+    buffer_type data = buffers[bench.result_arg].enqueue_read(
+                            0, bench.args[bench.result_arg].data.size()).get();
+    result.valid = bench.validate(std::vector<char>(data.data(),
+                                                    data.data() + data.size()));
+
+    return result;
+}
@@ -0,0 +1,245 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "runners.hpp"
+
+#include <hpx/include/threads.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // OpenCL calls only run properly on large stack size
+    hpx::threads::executors::default_executor get_medium_stack_executor()
+    {
+        return hpx::threads::executors::default_executor(
+                                      hpx::threads::thread_priority_normal,
+                                      hpx::threads::thread_stacksize_medium);
+    }
+
+    void check(cl_int err, const char* function)
+    {
+        if(err != CL_SUCCESS)
+            throw std::runtime_error(std::string(function) + " failed: "
+                                     + std::to_string(err));
+    }
+
+    std::string get_platform_name(cl_platform_id platform)
+    {
+        std::size_t size = 0;
+        check(clGetPlatformInfo(platform, CL_PLATFORM_NAME, 0, NULL, &size),
+              "clGetPlatformInfo()");
+        std::vector<char> name(size + 1, '\0');
+        check(clGetPlatformInfo(platform, CL_PLATFORM_NAME, size, name.data(),
+                                NULL),
+              "clGetPlatformInfo()");
+        return std::string(name.data());
+    }
+
+    std::string get_device_name(cl_device_id device)
+    {
+        std::size_t size = 0;
+        check(clGetDeviceInfo(device, CL_DEVICE_NAME, 0, NULL, &size),
+              "clGetDeviceInfo()");
+        std::vector<char> name(size + 1, '\0');
+        check(clGetDeviceInfo(device, CL_DEVICE_NAME, size, name.data(), NULL),
+              "clGetDeviceInfo()");
+        return std::string(name.data());
+    }
+
+    // Releases the OpenCL objects of one run
+    struct run_objects
+    {
+        run_objects() : program(NULL), kernel(NULL) {}
+
+        ~run_objects()
+        {
+            for(cl_mem buffer : buffers)
+                clReleaseMemObject(buffer);
+            if(kernel != NULL)
+                clReleaseKernel(kernel);
+            if(program != NULL)
+                clReleaseProgram(program);
+        }
+
+        cl_program program;
+        cl_kernel kernel;
+        std::vector<cl_mem> buffers;
+    };
+}
+
+suite::native_runner::native_runner(const std::string& platform_name,
+                                    const std::string& device_name)
+  : device_id(NULL), context(NULL), queue(NULL)
+{
+    hpx::threads::async_execute(get_medium_stack_executor(),
+        [this, &platform_name, &device_name]()
+        {
+            init(platform_name, device_name);
+        }).get();
+}
+
+suite::native_runner::~native_runner()
+{
+    hpx::threads::async_execute(get_medium_stack_executor(),
+        [this]()
+        {
+            cleanup();
+        }).wait();
+}
+
+suite::run_result
+suite::native_runner::run(const benchmark_case& bench, std::size_t warmup,
+                          std::size_t iterations)
+{
+    return hpx::threads::async_execute(get_medium_stack_executor(),
+        [this, &bench, warmup, iterations]()
+        {
+            return run_native(bench, warmup, iterations);
+        }).get();
+}
+
+void
+suite::native_runner::init(const std::string& platform_name,
+                           const std::string& device_name)
+{
+    cl_uint num_platforms = 0;
+    check(clGetPlatformIDs(0, NULL, &num_platforms), "clGetPlatformIDs()");
+    std::vector<cl_platform_id> platforms(num_platforms);
+    if(num_platforms > 0)
+        check(clGetPlatformIDs(num_platforms, platforms.data(), NULL),
+              "clGetPlatformIDs()");
+
+    // find the device HPXCL runs on
+    for(cl_platform_id platform : platforms)
+    {
+        if(get_platform_name(platform) != platform_name)
+            continue;
+
+        cl_uint num_devices = 0;
+        if(clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, 0, NULL, &num_devices)
+                != CL_SUCCESS)
+            continue;
+        std::vector<cl_device_id> devices(num_devices);
+        check(clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, num_devices,
+                             devices.data(), NULL),
+              "clGetDeviceIDs()");
+
+        for(cl_device_id device : devices)
+        {
+            if(get_device_name(device) == device_name)
+            {
+                device_id = device;
+                break;
+            }
+        }
+
+        if(device_id != NULL)
+            break;
+    }
+
+    if(device_id == NULL)
+        throw std::runtime_error("Native OpenCL device '" + device_name
+                                 + "' not found!");
+
+    cl_int err;
+    context = clCreateContext(NULL, 1, &device_id, NULL, NULL, &err);
+    check(err, "clCreateContext()");
+
+    queue = clCreateCommandQueue(context, device_id, 0, &err);
+    if(err != CL_SUCCESS)
+        clReleaseContext(context);
+    check(err, "clCreateCommandQueue()");
+}
+
+void
+suite::native_runner::cleanup()
+{
+    clReleaseCommandQueue(queue);
+    clReleaseContext(context);
+}
+
+suite::run_result
+suite::native_runner::run_native(const benchmark_case& bench,
+                                 std::size_t warmup, std::size_t iterations)
+{
+    cl_int err;
+    run_objects objects;
+
+    // build the kernel
+    const char* source = bench.source.c_str();
+    std::size_t source_size = bench.source.size();
+    objects.program = clCreateProgramWithSource(context, 1, &source,
+                                                &source_size, &err);
+    check(err, "clCreateProgramWithSource()");
+
+    err = clBuildProgram(objects.program, 1, &device_id, "", NULL, NULL);
+    if(err != CL_SUCCESS)
+    {
+        std::size_t log_size = 0;
+        clGetProgramBuildInfo(objects.program, device_id, CL_PROGRAM_BUILD_LOG,
+                              0, NULL, &log_size);
+        std::vector<char> log(log_size + 1, '\0');
+        clGetProgramBuildInfo(objects.program, device_id, CL_PROGRAM_BUILD_LOG,
+                              log_size, log.data(), NULL);
+        throw std::runtime_error("clBuildProgram() failed:\n"
+                                 + std::string(log.data()));
+    }
+
+    objects.kernel = clCreateKernel(objects.program, bench.kernel_name.c_str(),
+                                    &err);
+    check(err, "clCreateKernel()");
+
+    // upload the arguments
+    for(std::size_t i = 0; i < bench.args.size(); i++)
+    {
+        const kernel_arg& arg = bench.args[i];
+
+        cl_mem_flags flags = arg.read_only ? CL_MEM_READ_ONLY
+                                           : CL_MEM_READ_WRITE;
+        cl_mem buffer = clCreateBuffer(context, flags, arg.data.size(), NULL,
+                                       &err);
+        check(err, "clCreateBuffer()");
+        objects.buffers.push_back(buffer);
+
+        check(clEnqueueWriteBuffer(queue, buffer, CL_TRUE, 0, arg.data.size(),
+                                   arg.data.data(), 0, NULL, NULL),
+              "clEnqueueWriteBuffer()");
+
+        check(clSetKernelArg(objects.kernel, static_cast<cl_uint>(i),
+                             sizeof(cl_mem), &buffer),
+              "clSetKernelArg()");
+    }
+
+    // run
+    run_result result;
+    for(std::size_t it = 0; it < warmup + iterations; it++)
+    {
+        hpx::util::high_resolution_timer timer;
+
+        check(clEnqueueNDRangeKernel(queue, objects.kernel,
+                                     static_cast<cl_uint>(bench.dims), NULL,
+                                     bench.global_size, NULL, 0, NULL, NULL),
+              "clEnqueueNDRangeKernel()");
+        check(clFinish(queue), "clFinish()");
+
+        double time = timer.elapsed();
+        if(it >= warmup)
+            result.times.push_back(time);
+    }
+
+    // validate
+    std::vector<char> data(bench.args[bench.result_arg].data.size());
+    check(clEnqueueReadBuffer(queue, objects.buffers[bench.result_arg],
+                              CL_TRUE, 0, data.size(), data.data(),
+                              0, NULL, NULL),
+          "clEnqueueReadBuffer()");
+    result.valid = bench.validate(data);
+
+    return result;
+}
@@ -0,0 +1,86 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "roofline.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+suite::device_peaks
+suite::get_device_peaks(hpx::opencl::device device, native_runner& native,
+                        double peak_gflops, std::size_t bandwidth_size,
+                        std::size_t warmup, std::size_t iterations)
+{
+    device_peaks peaks;
+    peaks.flops_from_device_info = peak_gflops <= 0;
+
+    if(peaks.flops_from_device_info)
+    {
+        hpx::future<cl_uint> compute_units =
+            device.get_device_info<CL_DEVICE_MAX_COMPUTE_UNITS>();
+        hpx::future<cl_uint> clock_mhz =
+            device.get_device_info<CL_DEVICE_MAX_CLOCK_FREQUENCY>();
+        hpx::future<cl_uint> vector_width =
+            device.get_device_info<CL_DEVICE_NATIVE_VECTOR_WIDTH_DOUBLE>();
+
+        // One vector lane per compute unit. Devices without fp64 report a
+        // width of 0, count them as scalar. Devices with fused multiply
+        // add reach twice this rate, the roof leaves that out as OpenCL
+        // does not report it.
+        peaks.flops_per_s = static_cast<double>(compute_units.get())
+                          * static_cast<double>(clock_mhz.get()) * 1.0e6
+                          * static_cast<double>(std::max<cl_uint>(1,
+                                                    vector_width.get()));
+    }
+    else
+    {
+        peaks.flops_per_s = peak_gflops * 1.0e9;
+    }
+
+    // The fastest triad launch gives the bandwidth
+    std::vector<benchmark_case> cases = make_cases("stream", bandwidth_size);
+    auto triad = std::find_if(cases.begin(), cases.end(),
+        [](const benchmark_case& bench){
+            return bench.name == "stream_triad";
+        });
+    if(triad == cases.end())
+        throw std::logic_error("stream has no triad case");
+
+    run_result result = native.run(*triad, warmup, iterations);
+    if(!result.valid || result.times.empty())
+        throw std::runtime_error("measuring the bandwidth failed");
+
+    double time = *std::min_element(result.times.begin(), result.times.end());
+    peaks.bytes_per_s = time > 0 ? triad->bytes / time : 0;
+
+    return peaks;
+}
+
+suite::roofline_point
+suite::get_roofline_point(const benchmark_case& bench, double time,
+                          const device_peaks& peaks)
+{
+    roofline_point point;
+    point.flops_per_s = time > 0 ? bench.flops / time : 0;
+    point.bytes_per_s = time > 0 ? bench.bytes / time : 0;
+
+    // The time the case needs at least on each roof
+    double compute_time = peaks.flops_per_s > 0
+                        ? bench.flops / peaks.flops_per_s : 0;
+    double memory_time = peaks.bytes_per_s > 0
+                       ? bench.bytes / peaks.bytes_per_s : 0;
+
+    point.bound = compute_time > memory_time ? "compute" : "memory";
+    point.fraction = time > 0 ? std::max(compute_time, memory_time) / time
+                              : 0;
+
+    // Beating the roof means the peak is underestimated
+    point.above_roof = point.fraction > 1;
+    if(point.above_roof)
+        point.fraction = 1;
+
+    return point;
+}
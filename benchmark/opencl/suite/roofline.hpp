@@ -0,0 +1,70 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BENCHMARK_OPENCL_SUITE_ROOFLINE_HPP_
+#define BENCHMARK_OPENCL_SUITE_ROOFLINE_HPP_
+
+#include "benchmarks.hpp"
+#include "runners.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace suite {
+
+    // The roofs of a device
+    struct device_peaks
+    {
+        // Given by the user, or from the device info: compute units *
+        // clock * double vector width
+        double flops_per_s;
+
+        // Whether flops_per_s came from the device info
+        bool flops_from_device_info;
+
+        // Measured with the STREAM triad
+        double bytes_per_s;
+    };
+
+    // Where one run sits below the roofs
+    struct roofline_point
+    {
+        double flops_per_s;
+        double bytes_per_s;
+
+        // The fraction of the roof that bounds the case, 1 is the roof.
+        // Clamped to 1 if the run was faster than the roof allows.
+        double fraction;
+
+        // Whether the run was faster than the roof, i.e. the roof is too low
+        bool above_roof;
+
+        // "compute" or "memory"
+        std::string bound;
+    };
+
+    // Measures the bandwidth of the device with a triad of bandwidth_size
+    // elements on the native runner. The peak floating point rate is
+    // peak_gflops, or if that is 0, queried from the device info.
+    //
+    // OpenCL does not report the processing elements per compute unit, so
+    // the queried rate counts one double vector lane per compute unit. That
+    // fits CPUs, but GPUs execute 32 to 128 lanes per compute unit and need
+    // their peak from the data sheet.
+    device_peaks get_device_peaks(hpx::opencl::device device,
+                                  native_runner& native,
+                                  double peak_gflops,
+                                  std::size_t bandwidth_size,
+                                  std::size_t warmup,
+                                  std::size_t iterations);
+
+    // Places a case that took time seconds under the roofs
+    roofline_point get_roofline_point(const benchmark_case& bench,
+                                      double time,
+                                      const device_peaks& peaks);
+
+}
+
+#endif
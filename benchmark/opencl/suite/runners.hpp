@@ -0,0 +1,72 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BENCHMARK_OPENCL_SUITE_RUNNERS_HPP_
+#define BENCHMARK_OPENCL_SUITE_RUNNERS_HPP_
+
+#include <hpxcl/opencl.hpp>
+
+#include "benchmarks.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace suite {
+
+    struct run_result
+    {
+        // Wall time of every timed launch in seconds, from the enqueue
+        // until the kernel completed
+        std::vector<double> times;
+
+        bool valid;
+    };
+
+    // Runs the cases with the plain OpenCL API, on its own context for the
+    // device with the given platform and device name. The OpenCL calls run
+    // on medium stack HPX threads, like the ones of the HPXCL servers.
+    class native_runner
+    {
+    public:
+        native_runner(const std::string& platform_name,
+                      const std::string& device_name);
+        ~native_runner();
+
+        run_result run(const benchmark_case& bench, std::size_t warmup,
+                       std::size_t iterations);
+
+    private:
+        native_runner(const native_runner&);
+        native_runner& operator=(const native_runner&);
+
+        // The implementations, need to run on a medium stack
+        void init(const std::string& platform_name,
+                  const std::string& device_name);
+        void cleanup();
+        run_result run_native(const benchmark_case& bench, std::size_t warmup,
+                              std::size_t iterations);
+
+        cl_device_id device_id;
+        cl_context context;
+        cl_command_queue queue;
+    };
+
+    // Runs the cases through HPXCL
+    class hpxcl_runner
+    {
+    public:
+        explicit hpxcl_runner(hpx::opencl::device device);
+
+        run_result run(const benchmark_case& bench, std::size_t warmup,
+                       std::size_t iterations);
+
+    private:
+        hpx::opencl::device device;
+    };
+
+}
+
+#endif
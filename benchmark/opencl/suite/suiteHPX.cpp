@@ -0,0 +1,334 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hpxcl/opencl.hpp>
+
+#include "benchmarks.hpp"
+#include "roofline.hpp"
+#include "runners.hpp"
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+// Runs stream, dgemm, smvp and stencil once with plain OpenCL and once
+// through HPXCL, on the same device with identical kernels and data, and
+// reports the overhead of HPXCL relative to the native time. Every run is
+// also placed under the roofline of the device, from its peak floating
+// point rate and its STREAM triad bandwidth. The peak rate derived from
+// the device info counts one lane per compute unit, which is far too low
+// for GPUs, so pass their data sheet peak with --peak-gflops.
+
+struct suite_result
+{
+    std::string name;
+    std::size_t size;
+    double flops;
+    double bytes;
+    suite::run_result native;
+    suite::run_result hpxcl;
+    suite::roofline_point native_point;
+    suite::roofline_point hpxcl_point;
+};
+
+static double get_median(std::vector<double> times)
+{
+    if(times.empty())
+        return 0;
+
+    std::sort(times.begin(), times.end());
+    std::size_t size = times.size();
+    if(size % 2 == 0)
+        return (times[size / 2 - 1] + times[size / 2]) / 2;
+    return times[size / 2];
+}
+
+static double get_overhead(const suite_result& result)
+{
+    double native = get_median(result.native.times);
+    double hpxcl = get_median(result.hpxcl.times);
+    if(native == 0)
+        return 0;
+    return (hpxcl - native) / native * 100.0;
+}
+
+static void print_table(std::ostream& os,
+                        const std::vector<suite_result>& results)
+{
+    os << std::left << std::setw(14) << "benchmark"
+       << std::right << std::setw(10) << "size"
+       << std::setw(14) << "native[ms]"
+       << std::setw(14) << "hpxcl[ms]"
+       << std::setw(13) << "overhead[%]"
+       << std::setw(10) << "GFLOP/s"
+       << std::setw(10) << "GB/s"
+       << std::setw(10) << "roof[%]"
+       << std::setw(9) << "bound"
+       << std::setw(7) << "valid" << std::endl;
+
+    for(const auto& result : results)
+    {
+        os << std::left << std::setw(14) << result.name
+           << std::right << std::setw(10) << result.size
+           << std::fixed << std::setprecision(4)
+           << std::setw(14) << get_median(result.native.times) * 1000.0
+           << std::setw(14) << get_median(result.hpxcl.times) * 1000.0
+           << std::setprecision(1)
+           << std::setw(13) << get_overhead(result)
+           << std::setprecision(2)
+           << std::setw(10) << result.hpxcl_point.flops_per_s / 1.0e9
+           << std::setw(10) << result.hpxcl_point.bytes_per_s / 1.0e9
+           << std::setprecision(1)
+           << std::setw(10) << result.hpxcl_point.fraction * 100.0
+           << std::setw(9) << result.hpxcl_point.bound
+           << std::setw(7)
+           << ((result.native.valid && result.hpxcl.valid) ? "yes" : "NO")
+           << std::endl;
+    }
+}
+
+static void print_run_json(std::ostream& os, const suite::run_result& run,
+                           const suite::roofline_point& point)
+{
+    os << "{\"median\": " << get_median(run.times)
+       << ", \"valid\": " << (run.valid ? "true" : "false")
+       << ", \"flops_per_s\": " << point.flops_per_s
+       << ", \"bytes_per_s\": " << point.bytes_per_s
+       << ", \"roofline_fraction\": " << point.fraction
+       << ", \"above_roof\": " << (point.above_roof ? "true" : "false")
+       << ", \"bound\": \"" << point.bound << "\""
+       << ", \"times\": [";
+    for(std::size_t i = 0; i < run.times.size(); i++)
+    {
+        if(i != 0)
+            os << ", ";
+        os << run.times[i];
+    }
+    os << "]}";
+}
+
+static void print_json(std::ostream& os, const std::string& platform_name,
+                       const std::string& device_name,
+                       const suite::device_peaks& peaks,
+                       const std::vector<suite_result>& results)
+{
+    os << std::setprecision(9);
+    os << "{" << std::endl;
+    os << "  \"platform\": \"" << platform_name << "\"," << std::endl;
+    os << "  \"device\": \"" << device_name << "\"," << std::endl;
+    os << "  \"unit\": \"s\"," << std::endl;
+    os << "  \"peaks\": {\"flops_per_s\": " << peaks.flops_per_s
+       << ", \"flops_source\": \""
+       << (peaks.flops_from_device_info ? "device_info" : "user") << "\""
+       << ", \"bytes_per_s\": " << peaks.bytes_per_s << "}," << std::endl;
+    os << "  \"results\": [" << std::endl;
+
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        const suite_result& result = results[i];
+        os << "    {" << std::endl;
+        os << "      \"benchmark\": \"" << result.name << "\"," << std::endl;
+        os << "      \"size\": " << result.size << "," << std::endl;
+        os << "      \"flops\": " << result.flops << "," << std::endl;
+        os << "      \"bytes\": " << result.bytes << "," << std::endl;
+        os << "      \"native\": ";
+        print_run_json(os, result.native, result.native_point);
+        os << "," << std::endl;
+        os << "      \"hpxcl\": ";
+        print_run_json(os, result.hpxcl, result.hpxcl_point);
+        os << "," << std::endl;
+        os << "      \"overhead_percent\": " << get_overhead(result)
+           << std::endl;
+        os << ((i + 1 < results.size()) ? "    }," : "    }") << std::endl;
+    }
+
+    os << "  ]" << std::endl;
+    os << "}" << std::endl;
+}
+
+int hpx_main(variables_map & vm)
+{
+    bool all_valid = true;
+    {
+        std::size_t iterations = vm["iterations"].as<std::size_t>();
+        std::size_t warmup = vm["warmup"].as<std::size_t>();
+
+        std::vector<std::string> families = suite::get_families();
+        if(vm.count("benchmarks"))
+            families = vm["benchmarks"].as<std::vector<std::string> >();
+
+        std::string type_name = vm["device-type"].as<std::string>();
+        cl_device_type type = CL_DEVICE_TYPE_CPU;
+        if(type_name == "gpu")
+            type = CL_DEVICE_TYPE_GPU;
+        else if(type_name == "all")
+            type = CL_DEVICE_TYPE_ALL;
+        else if(type_name != "cpu")
+        {
+            hpx::cerr << "Unknown device type '" << type_name << "'!"
+                      << hpx::endl;
+            return hpx::finalize();
+        }
+
+        // Get the device
+        std::vector<hpx::opencl::device> devices =
+            hpx::opencl::create_local_devices(type, "OpenCL 1.1").get();
+
+        std::size_t device_id = vm["deviceid"].as<std::size_t>();
+        if(devices.size() <= device_id)
+        {
+            hpx::cerr << "No matching OpenCL device found!" << hpx::endl;
+            return hpx::finalize();
+        }
+
+        hpx::opencl::device cldevice = devices[device_id];
+        std::string platform_name =
+            cldevice.get_platform_info<CL_PLATFORM_NAME>().get();
+        std::string device_name =
+            cldevice.get_device_info<CL_DEVICE_NAME>().get();
+
+        std::cerr << "Platform: " << platform_name << std::endl;
+        std::cerr << "Device:   " << device_name << std::endl;
+
+        suite::native_runner native(platform_name, device_name);
+        suite::hpxcl_runner hpxcl(cldevice);
+
+        // The roofs
+        suite::device_peaks peaks = suite::get_device_peaks(
+            cldevice, native, vm["peak-gflops"].as<double>(),
+            vm["bandwidth-size"].as<std::size_t>(), warmup, iterations);
+
+        std::cerr << "Peak:     " << peaks.flops_per_s / 1.0e9
+                  << " GFLOP/s, " << peaks.bytes_per_s / 1.0e9 << " GB/s"
+                  << std::endl;
+        if(peaks.flops_from_device_info)
+            std::cerr << "          (GFLOP/s from the device info, one lane "
+                      << "per compute unit, see --peak-gflops)" << std::endl;
+
+        // Run
+        std::vector<suite_result> results;
+        for(const auto& family : families)
+        {
+            std::vector<std::size_t> sizes =
+                suite::get_default_sizes(family);
+            if(vm.count("sizes"))
+                sizes = vm["sizes"].as<std::vector<std::size_t> >();
+
+            for(std::size_t size : sizes)
+            {
+                for(const auto& bench : suite::make_cases(family, size))
+                {
+                    std::cerr << "Running " << bench.name << " " << size
+                              << " ..." << std::endl;
+
+                    suite_result result;
+                    result.name = bench.name;
+                    result.size = size;
+                    result.flops = bench.flops;
+                    result.bytes = bench.bytes;
+                    result.native = native.run(bench, warmup, iterations);
+                    result.hpxcl = hpxcl.run(bench, warmup, iterations);
+                    result.native_point = suite::get_roofline_point(
+                        bench, get_median(result.native.times), peaks);
+                    result.hpxcl_point = suite::get_roofline_point(
+                        bench, get_median(result.hpxcl.times), peaks);
+
+                    if(result.native_point.above_roof ||
+                       result.hpxcl_point.above_roof)
+                    {
+                        std::cerr << "Warning: " << bench.name << " " << size
+                                  << " ran faster than the "
+                                  << result.hpxcl_point.bound
+                                  << " roof allows, its fraction is "
+                                  << "clamped to 100%. "
+                                  << (result.hpxcl_point.bound == "compute"
+                                      ? "Set the peak with --peak-gflops."
+                                      : "Raise --bandwidth-size.")
+                                  << std::endl;
+                    }
+
+                    if(!result.native.valid || !result.hpxcl.valid)
+                        all_valid = false;
+
+                    results.push_back(result);
+                }
+            }
+        }
+
+        print_table(std::cout, results);
+
+        if(vm.count("json"))
+        {
+            std::string filename = vm["json"].as<std::string>();
+            std::ofstream file(filename.c_str(), std::ios::trunc);
+            if(!file)
+            {
+                hpx::cerr << "Unable to write '" << filename << "'!"
+                          << hpx::endl;
+                all_valid = false;
+            }
+            else
+            {
+                print_json(file, platform_name, device_name, peaks,
+                           results);
+            }
+        }
+    }
+
+    hpx::finalize();
+    return all_valid ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+    options_description cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+    cmdline.add_options()
+        ( "benchmarks"
+        , value<std::vector<std::string> >()->multitoken()
+        , "the benchmarks to run: stream, dgemm, smvp, stencil "
+          "(default: all)" )
+        ( "sizes"
+        , value<std::vector<std::size_t> >()->multitoken()
+        , "the problem sizes, instead of the defaults of every benchmark. "
+          "Vector length for stream and stencil, matrix dimension for dgemm, "
+          "rows for smvp" )
+        ( "iterations"
+        , value<std::size_t>()->default_value(10)
+        , "the timed launches per benchmark and size" )
+        ( "warmup"
+        , value<std::size_t>()->default_value(1)
+        , "the launches before the timed ones" )
+        ( "device-type"
+        , value<std::string>()->default_value("cpu")
+        , "the OpenCL device type: cpu, gpu or all" )
+        ( "deviceid"
+        , value<std::size_t>()->default_value(0)
+        , "the index of the device among the devices of the type" )
+        ( "peak-gflops"
+        , value<double>()->default_value(0)
+        , "the peak double precision GFLOP/s of the device for the roofline "
+          "(default: compute units * clock * double vector width, which "
+          "underestimates GPUs)" )
+        ( "bandwidth-size"
+        , value<std::size_t>()->default_value(1 << 24)
+        , "the vector length of the STREAM triad that measures the peak "
+          "bandwidth for the roofline" )
+        ( "json"
+        , value<std::string>()
+        , "writes the results, with all timings, to a JSON file" )
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -136,12 +136,16 @@ mandelbrotworker::worker_main(
         hpx::opencl::work_size<2> dim;
         dim[0].offset = 0;
         dim[1].offset = 0;
+        // the kernel computes one pixel per 8x8 work group
         dim[0].local_size = 8;
         dim[1].local_size = 8;
 
+        // the precalculation works on single points, its local size gets
+        // tuned once per workload size
         hpx::opencl::work_size<2> precalc_dim;
         precalc_dim[0].offset = 0;
         precalc_dim[1].offset = 0;
+        std::set<std::pair<size_t, size_t> > tuned_precalc_sizes;
 
         while(request_new_work(&next_workload))
         {
@@ -205,6 +209,17 @@ mandelbrotworker::worker_main(
             // run precalculation
             precalc_dim[0].size = next_workload->num_pixels_x + 2;
             precalc_dim[1].size = next_workload->num_pixels_y + 2;
+            if(tuned_precalc_sizes.insert(
+                   std::make_pair(precalc_dim[0].size,
+                                  precalc_dim[1].size)).second)
+            {
+                // the precalculation only depends on the input, so the
+                // tuning runs can repeat it
+                precalc_kernel.autotune(precalc_dim,
+                    std::vector<std::array<std::size_t, 2> >(), ev1).get();
+            }
+            precalc_dim[0].local_size = hpx::opencl::local_size_auto;
+            precalc_dim[1].local_size = hpx::opencl::local_size_auto;
             auto ev2 = precalc_kernel.enqueue(precalc_dim, ev1);
 
              // run calculation
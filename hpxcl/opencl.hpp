@@ -9,9 +9,15 @@
 
     #include "opencl/device.hpp"
     #include "opencl/create_devices.hpp"
+    #include "opencl/core_budget.hpp"
     #include "opencl/buffer.hpp"
     #include "opencl/program.hpp"
     #include "opencl/kernel.hpp"
+    #include "opencl/command_graph.hpp"
+    #include "opencl/device_placement.hpp"
+    #include "opencl/transfer_model.hpp"
+    #include "opencl/profiling.hpp"
+    #include "opencl/launch_stages.hpp"
 
 #endif
 
@@ -25,15 +25,28 @@ buffer::size() const
 
 }
 
-void buffer::ensure_device_id()
+hpx::shared_future<hpx::naming::id_type>
+buffer::query_parent_device( hpx::shared_future<hpx::naming::id_type> const& gid )
+{
+    typedef hpx::opencl::server::buffer::get_parent_device_id_action
+        action_type;
+
+    return gid.then( hpx::launch::sync,
+        [](hpx::shared_future<hpx::naming::id_type> const& f)
+        {
+            return hpx::async<action_type>(f.get());
+        });
+}
+
+void buffer::ensure_device_id() const
 {
     if (!device_gid)
     {
-        typedef
-            hpx::opencl::server::buffer::get_parent_device_id_action
-            action_type;
-        HPX_ASSERT(this->get_id());
-        device_gid = async<action_type>(this->get_id()).get();
+        // The query got started by the constructor
+        HPX_ASSERT(device_gid_future.valid());
+        device_gid = device_gid_future.get();
+        locality = tools::get_locality_of(device_gid);
+        is_local = (locality == hpx::find_here());
     }
 }
 
@@ -54,6 +67,9 @@ buffer::enqueue_send_impl(
     // create events
     event<void> src_event( device_gid );
     event<void> dst_event( dst.device_gid );
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::event_created(
+            src_event.get_event_id().get_gid() );
 
     // send command to server class
     typedef hpx::opencl::server::buffer::enqueue_send_action func;
@@ -72,6 +88,34 @@ buffer::enqueue_send_impl(
                         std::move(dst_event.get_future()) );
 }
 
+void
+buffer::enqueue_send_nowait_impl(
+    const hpx::opencl::buffer &dst,
+    std::size_t && src_offset,
+    std::size_t && dst_offset,
+    std::size_t && size,
+    hpx::opencl::util::resolved_events && dependencies )
+{
+    ensure_device_id();
+
+    HPX_ASSERT(this->get_id());
+    HPX_ASSERT(dependencies.are_from_devices(device_gid, dst.device_gid));
+
+    // count the command on the source device
+    hpx::opencl::util::nowait_tracker::submit(device_gid.get_gid());
+
+    // send command to server class
+    typedef hpx::opencl::server::buffer::enqueue_send_nowait_action func;
+    hpx::apply<func>( this->get_id(),
+                      dst.get_id(),
+                      src_offset,
+                      dst_offset,
+                      size,
+                      std::move(dependencies.event_ids),
+                      std::move(dependencies.device_ids),
+                      hpx::get_locality_id() );
+}
+
 buffer::send_result
 buffer::enqueue_send_rect_impl(
     const hpx::opencl::buffer &dst,
@@ -87,6 +131,9 @@ buffer::enqueue_send_rect_impl(
     // create events
     event<void> src_event( device_gid );
     event<void> dst_event( dst.device_gid );
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::event_created(
+            src_event.get_event_id().get_gid() );
 
     // send command to server class
     typedef hpx::opencl::server::buffer::enqueue_send_rect_action func;
@@ -119,6 +166,9 @@ buffer::enqueue_read_impl(
 
     // create local event
     event<buffer_type> ev( device_gid );
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::event_created(
+            ev.get_event_id().get_gid() );
 
     // send command to server class
     typedef hpx::opencl::server::buffer::enqueue_read_action func;
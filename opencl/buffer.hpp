@@ -20,7 +20,10 @@
 // Crazy function overloading
 #include "util/enqueue_overloads.hpp"
 #include "util/rect_props.hpp"
+#include "util/nowait_tracker.hpp"
+#include "util/tracer.hpp"
 
+#include "tools.hpp"
 #include "server/buffer.hpp"
 
 namespace hpx {
@@ -56,20 +59,22 @@ namespace opencl {
             buffer() {}
 
             // Constructor
+            // Buffers get created on the locality of their device, so the
+            // locality is known without waiting for the creation.
             buffer(hpx::shared_future<hpx::naming::id_type> const& gid,
                    hpx::naming::id_type device_gid_)
-              : base_type(gid), device_gid(std::move(device_gid_))
+              : base_type(gid), device_gid(std::move(device_gid_)),
+                locality(tools::get_locality_of(device_gid))
             {
-                is_local =
-                    (hpx::get_colocation_id(hpx::launch::sync, get_id()) == hpx::find_here());
+                is_local = (locality == hpx::find_here());
             }
 
+            // The device and locality are unknown here. They get queried
+            // right away, without waiting for the creation, and are
+            // needed the first time by ensure_device_id().
             buffer(hpx::future<hpx::naming::id_type> && gid)
-              : base_type(std::move(gid)), device_gid()
-            {
-                is_local =
-                    (hpx::get_colocation_id(hpx::launch::sync, get_id()) == hpx::find_here());
-            }
+              : buffer(gid.share())
+            {}
 
             // initialization
 
@@ -100,6 +105,22 @@ namespace opencl {
                            const hpx::serialization::serialize_buffer<T> data,
                            Deps &&... dependencies );
 
+            /**
+             *  @brief Writes data to the buffer, without creating an event
+             *
+             *  Use device::barrier_async() or device::finish_async() to
+             *  synchronize with the write. The data is kept alive until
+             *  then. Errors get reported by the next device::finish_async().
+             *
+             *  @param offset   The start position of the area to write to.
+             *  @param data     The data to be written.
+             */
+            template<typename T, typename ...Deps>
+            void
+            enqueue_write_nowait( std::size_t offset,
+                                  const hpx::serialization::serialize_buffer<T> data,
+                                  Deps &&... dependencies );
+
             /**
              *  @brief Writes data to the buffer in a rectangular region
              *
@@ -191,6 +212,28 @@ namespace opencl {
                                       std::size_t         size,
                                       Deps &&... dependencies );
 
+            /*
+             *  @name Copies data to another buffer, without creating events.
+             *
+             *  The buffers do NOT need to be from the same device,
+             *  neither do they have to be on the same node.
+             *
+             *  The copy is counted on the device of this buffer. To
+             *  synchronize with it, call finish_async() on this buffer's
+             *  device first, then on the destination device.
+             *
+             *  @param dst          The source buffer.
+             *  @param src_offset   The offset on the source buffer.
+             *  @param dst_offset   The offset on the destination buffer.
+             *  @param size         The size of the area to copy.
+             */
+            template<typename ...Deps>
+            void enqueue_send_nowait( const hpx::opencl::buffer& dst,
+                                      std::size_t         src_offset,
+                                      std::size_t         dst_offset,
+                                      std::size_t         size,
+                                      Deps &&... dependencies );
+
             /*
              *  @name Copies data to another buffer.
              *
@@ -225,16 +268,36 @@ namespace opencl {
                                std::size_t && size,
                                hpx::opencl::util::resolved_events && deps );
 
+            void
+            enqueue_send_nowait_impl( const hpx::opencl::buffer& dst,
+                                      std::size_t && src_offset,
+                                      std::size_t && dst_offset,
+                                      std::size_t && size,
+                                      hpx::opencl::util::resolved_events && deps );
+
             send_result
             enqueue_send_rect_impl( const hpx::opencl::buffer& dst,
                                     rect_props && rect_properties,
                                     hpx::opencl::util::resolved_events && deps );
 
-            void ensure_device_id();
+            void ensure_device_id() const;
+
+            explicit buffer(hpx::shared_future<hpx::naming::id_type> const& gid)
+              : base_type(gid), device_gid(), locality(), is_local(false),
+                device_gid_future(query_parent_device(gid))
+            {}
+
+            static hpx::shared_future<hpx::naming::id_type>
+            query_parent_device(
+                hpx::shared_future<hpx::naming::id_type> const& gid );
 
         private:
             mutable hpx::naming::id_type device_gid;
-            bool is_local;
+            mutable hpx::naming::id_type locality;
+            mutable bool is_local;
+
+            // the parent device, for buffers that got constructed without it
+            hpx::shared_future<hpx::naming::id_type> device_gid_future;
 
         private:
             // serialization support
@@ -245,16 +308,18 @@ namespace opencl {
             {
                 ar >> hpx::serialization::base_object<base_type>(*this);
                 ar >> device_gid;
-                is_local =
-                    (hpx::get_colocation_id(hpx::launch::sync, get_id()) == hpx::find_here());
+                ar >> locality;
+                is_local = (locality == hpx::find_here());
             }
 
             template <typename Archive>
             void save(Archive & ar, unsigned) const
             {
+                ensure_device_id();
                 HPX_ASSERT(device_gid);
                 ar << hpx::serialization::base_object<base_type>(*this);
                 ar << device_gid;
+                ar << locality;
             }
 
             HPX_SERIALIZATION_SPLIT_MEMBER()
@@ -273,6 +338,8 @@ hpx::opencl::buffer::enqueue_read( std::size_t offset,
                                    hpx::serialization::serialize_buffer<T> data,
                                    Deps &&... dependencies )
 {
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_read",
+                                            "client" );
     ensure_device_id();
 
     typedef hpx::serialization::serialize_buffer<T> buffer_type;
@@ -285,6 +352,9 @@ hpx::opencl::buffer::enqueue_read( std::size_t offset,
     // create local event
     using hpx::opencl::lcos::event;
     event<buffer_type> ev( device_gid );
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::event_created(
+            ev.get_event_id().get_gid() );
 
     // send command to server class
     if(!is_local) {
@@ -327,6 +397,8 @@ hpx::opencl::buffer::enqueue_read_rect(
                                    hpx::serialization::serialize_buffer<T> data,
                                    Deps &&... dependencies )
 {
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_read_rect",
+                                            "client" );
     ensure_device_id();
 
     typedef hpx::serialization::serialize_buffer<T> buffer_type;
@@ -339,6 +411,9 @@ hpx::opencl::buffer::enqueue_read_rect(
     // create local event
     using hpx::opencl::lcos::event;
     event<buffer_type> ev( device_gid );
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::event_created(
+            ev.get_event_id().get_gid() );
 
     // send command to server class
     if(!is_local) {
@@ -380,6 +455,8 @@ hpx::opencl::buffer::enqueue_write( std::size_t offset,
                const hpx::serialization::serialize_buffer<T> data,
                Deps &&... dependencies )
 {
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_write",
+                                            "client" );
     ensure_device_id();
 
     // combine dependency futures in one std::vector
@@ -390,6 +467,9 @@ hpx::opencl::buffer::enqueue_write( std::size_t offset,
     // create local event
     using hpx::opencl::lcos::event;
     event<void> ev( device_gid );
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::event_created(
+            ev.get_event_id().get_gid() );
 
     // send command to server class
     typedef hpx::opencl::server::buffer::enqueue_write_action<T> func;
@@ -404,12 +484,41 @@ hpx::opencl::buffer::enqueue_write( std::size_t offset,
     return ev.get_future();
 }
 
+template<typename T, typename ...Deps>
+void
+hpx::opencl::buffer::enqueue_write_nowait( std::size_t offset,
+               const hpx::serialization::serialize_buffer<T> data,
+               Deps &&... dependencies )
+{
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_write_nowait",
+                                            "client" );
+    ensure_device_id();
+
+    // combine dependency futures in one std::vector
+    using hpx::opencl::util::enqueue_overloads::resolver;
+    auto deps = resolver(device_gid.get_gid(),std::forward<Deps>(dependencies)...);
+    HPX_ASSERT(deps.are_from_device(device_gid));
+
+    // count the command, device::finish_async() waits for it
+    hpx::opencl::util::nowait_tracker::submit(device_gid.get_gid());
+
+    // send command to server class
+    typedef hpx::opencl::server::buffer::enqueue_write_nowait_action<T> func;
+    hpx::apply<func>( this->get_id(),
+                      offset,
+                      data,
+                      std::move(deps.event_ids),
+                      hpx::get_locality_id() );
+}
+
 template<typename T, typename ...Deps>
 hpx::future<void>
 hpx::opencl::buffer::enqueue_write_rect( rect_props rect_properties,
                     const hpx::serialization::serialize_buffer<T> data,
                     Deps &&... dependencies )
 {
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_write_rect",
+                                            "client" );
     ensure_device_id();
 
     // combine dependency futures in one std::vector
@@ -420,6 +529,9 @@ hpx::opencl::buffer::enqueue_write_rect( rect_props rect_properties,
     // create local event
     using hpx::opencl::lcos::event;
     event<void> ev( device_gid );
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::event_created(
+            ev.get_event_id().get_gid() );
 
     // send command to server class
     typedef hpx::opencl::server::buffer::enqueue_write_rect_action<T> func;
@@ -439,6 +551,8 @@ hpx::opencl::buffer::enqueue_read( std::size_t offset,
                                    std::size_t size,
                                    Deps &&... dependencies )
 {
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_read",
+                                            "client" );
     ensure_device_id();
 
     // combine dependency futures in one std::vector
@@ -459,9 +573,16 @@ hpx::opencl::buffer::enqueue_send( const hpx::opencl::buffer& dst,
                                    std::size_t size,
                                    Deps &&... dependencies )
 {
-    // combine dependency futures in one std::vector
-    using hpx::opencl::util::enqueue_overloads::resolver;
-    auto deps = resolver(device_gid.get_gid(),std::forward<Deps>(dependencies)...);
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_send",
+                                            "client" );
+    ensure_device_id();
+    dst.ensure_device_id();
+
+    // combine dependency futures in one std::vector. events of the
+    // destination device get waited for on the destination device.
+    using hpx::opencl::util::enqueue_overloads::send_resolver;
+    auto deps = send_resolver(device_gid.get_gid(), dst.device_gid.get_gid(),
+                              std::forward<Deps>(dependencies)...);
 
     return enqueue_send_impl( dst,
                               std::move(src_offset),
@@ -470,15 +591,48 @@ hpx::opencl::buffer::enqueue_send( const hpx::opencl::buffer& dst,
                               std::move(deps) );
 }
 
+template<typename ...Deps>
+void
+hpx::opencl::buffer::enqueue_send_nowait( const hpx::opencl::buffer& dst,
+                                          std::size_t src_offset,
+                                          std::size_t dst_offset,
+                                          std::size_t size,
+                                          Deps &&... dependencies )
+{
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_send_nowait",
+                                            "client" );
+    ensure_device_id();
+    dst.ensure_device_id();
+
+    // combine dependency futures in one std::vector. events of the
+    // destination device get waited for on the destination device.
+    using hpx::opencl::util::enqueue_overloads::send_resolver;
+    auto deps = send_resolver(device_gid.get_gid(), dst.device_gid.get_gid(),
+                              std::forward<Deps>(dependencies)...);
+
+    enqueue_send_nowait_impl( dst,
+                              std::move(src_offset),
+                              std::move(dst_offset),
+                              std::move(size),
+                              std::move(deps) );
+}
+
 template<typename ...Deps>
 hpx::opencl::buffer::send_result
 hpx::opencl::buffer::enqueue_send_rect( const hpx::opencl::buffer& dst,
                                         rect_props rect_properties,
                                         Deps &&... dependencies )
 {
-    // combine dependency futures in one std::vector
-    using hpx::opencl::util::enqueue_overloads::resolver;
-    auto deps = resolver(device_gid.get_gid(),std::forward<Deps>(dependencies)...);
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_send_rect",
+                                            "client" );
+    ensure_device_id();
+    dst.ensure_device_id();
+
+    // combine dependency futures in one std::vector. events of the
+    // destination device get waited for on the destination device.
+    using hpx::opencl::util::enqueue_overloads::send_resolver;
+    auto deps = send_resolver(device_gid.get_gid(), dst.device_gid.get_gid(),
+                              std::forward<Deps>(dependencies)...);
 
     return enqueue_send_rect_impl( dst,
                                    std::move(rect_properties),
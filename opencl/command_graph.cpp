@@ -0,0 +1,112 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Header File
+#include "command_graph.hpp"
+
+// Internal Dependencies
+#include "server/command_graph.hpp"
+#include "server/device.hpp"
+#include "buffer.hpp"
+
+using hpx::opencl::command_graph;
+
+std::size_t
+command_graph::add_node( util::graph_node && node )
+{
+    if(!nodes){
+        HPX_THROW_EXCEPTION(hpx::invalid_status, "command_graph::add_node()",
+                            "Command graph is already finalized!");
+    }
+
+    std::size_t index = nodes->size();
+    for(std::size_t dependency : node.dependencies){
+        if(dependency >= index){
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "command_graph::add_node()",
+                                "Nodes can only depend on earlier nodes!");
+        }
+    }
+
+    nodes->push_back(std::move(node));
+    return index;
+}
+
+std::size_t
+command_graph::add_read( const hpx::opencl::buffer& src,
+                         std::size_t offset,
+                         std::size_t size,
+                         std::vector<std::size_t> dependencies )
+{
+    util::graph_node node;
+    node.type = util::graph_node::read_node;
+    node.target = src.get_id();
+    node.offset = offset;
+    node.size = size;
+    node.dependencies = std::move(dependencies);
+
+    return add_node(std::move(node));
+}
+
+std::size_t
+command_graph::add_copy( const hpx::opencl::buffer& src,
+                         const hpx::opencl::buffer& dst,
+                         std::size_t src_offset,
+                         std::size_t dst_offset,
+                         std::size_t size,
+                         std::vector<std::size_t> dependencies )
+{
+    util::graph_node node;
+    node.type = util::graph_node::copy_node;
+    node.target = src.get_id();
+    node.copy_dst = dst.get_id();
+    node.offset = src_offset;
+    node.dst_offset = dst_offset;
+    node.size = size;
+    node.dependencies = std::move(dependencies);
+
+    return add_node(std::move(node));
+}
+
+hpx::future<void>
+command_graph::finalize()
+{
+    if(!nodes){
+        HPX_THROW_EXCEPTION(hpx::invalid_status, "command_graph::finalize()",
+                            "Command graph is already finalized!");
+    }
+
+    HPX_ASSERT(device_gid);
+
+    typedef hpx::opencl::server::device::create_command_graph_action func;
+
+    hpx::shared_future<hpx::id_type> graph_server =
+        hpx::async<func>(device_gid, std::move(*nodes));
+    nodes.reset();
+
+    static_cast<base_type&>(*this) = base_type(graph_server);
+
+    return graph_server.then(
+        [](hpx::shared_future<hpx::id_type> const& id){ id.get(); });
+}
+
+hpx::future<command_graph::replay_result>
+command_graph::replay() const
+{
+    return replay(hpx::opencl::graph_arguments());
+}
+
+hpx::future<command_graph::replay_result>
+command_graph::replay_impl( hpx::opencl::graph_arguments && args,
+                            hpx::opencl::util::resolved_events && deps ) const
+{
+    HPX_ASSERT(this->get_id());
+
+    typedef hpx::opencl::server::command_graph::replay_action func;
+
+    return hpx::async<func>( this->get_id(),
+                             std::move(args),
+                             std::move(deps.event_ids) );
+}
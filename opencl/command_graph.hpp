@@ -0,0 +1,297 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_COMMAND_GRAPH_HPP_
+#define HPX_OPENCL_COMMAND_GRAPH_HPP_
+
+// Default includes
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+// Export definitions
+#include "export_definitions.hpp"
+
+// Forward Declarations
+#include "fwd_declarations.hpp"
+
+// Crazy function overloading
+#include "util/enqueue_overloads.hpp"
+
+// Recorded commands and replay arguments
+#include "util/graph_description.hpp"
+
+#include "buffer.hpp"
+#include "kernel.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace hpx {
+namespace opencl {
+
+    //////////////////////////////////////
+    /// @brief A recorded chain of enqueue calls that can be replayed.
+    ///
+    /// Iterative codes often enqueue the same commands in every iteration.
+    /// A command graph records them once and submits the whole chain with a
+    /// single action per replay, instead of one action per command.
+    ///
+    /// Every command graph belongs to one \ref device. All recorded buffers
+    /// and kernels need to belong to the same device.
+    ///
+    /// Example:
+    /// \code{.cpp}
+    ///     hpx::opencl::command_graph graph = device.create_command_graph();
+    ///
+    ///     std::size_t w = graph.add_write(buf_in, 0, input);
+    ///     std::size_t k = graph.add_kernel(kernel, size, {w});
+    ///     graph.add_read(buf_out, 0, output_size, {k});
+    ///     graph.finalize();
+    ///
+    ///     for(std::size_t i = 0; i < num_iterations; i++){
+    ///         auto results = graph.replay().get();
+    ///     }
+    /// \endcode
+    ///
+    class HPX_OPENCL_EXPORT command_graph
+      : public hpx::components::client_base<command_graph, server::command_graph>
+    {
+
+        typedef hpx::components::client_base<command_graph,
+                                             server::command_graph> base_type;
+
+        typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+        public:
+            // the result of a replay: the data of all read nodes, in order
+            // of recording
+            typedef std::vector<buffer_type> replay_result;
+
+        public:
+            // Empty constructor, necessary for hpx purposes
+            command_graph(){}
+
+            // Constructor
+            command_graph(hpx::naming::id_type device_gid_)
+              : base_type(), device_gid(std::move(device_gid_)),
+                nodes(std::make_shared<std::vector<util::graph_node> >())
+            {}
+
+            // ///////////////////////////////////////////////
+            // Recording functionality
+            //
+            // All recording functions return the index of the new node,
+            // which can be used as dependency of later nodes.
+            // Nodes without dependencies depend on the dependencies passed
+            // to replay().
+            //
+
+            /**
+             *  @brief Records a write to a buffer.
+             *
+             *  @param dst          The buffer to write to.
+             *  @param offset       The start position of the area to write to.
+             *  @param data         The data to be written. Can be replaced per
+             *                      replay with graph_arguments::set_write_data.
+             *  @param dependencies The nodes this write depends on.
+             *  @return             The index of the node.
+             */
+            template<typename T>
+            std::size_t
+            add_write( const hpx::opencl::buffer& dst,
+                       std::size_t offset,
+                       hpx::serialization::serialize_buffer<T> data,
+                       std::vector<std::size_t> dependencies =
+                           std::vector<std::size_t>() );
+
+            /**
+             *  @brief Records a read from a buffer.
+             *
+             *  @param src          The buffer to read from.
+             *  @param offset       The start position of the area to read.
+             *  @param size         The size of the area to read.
+             *  @param dependencies The nodes this read depends on.
+             *  @return             The index of the node.
+             */
+            std::size_t
+            add_read( const hpx::opencl::buffer& src,
+                      std::size_t offset,
+                      std::size_t size,
+                      std::vector<std::size_t> dependencies =
+                          std::vector<std::size_t>() );
+
+            /**
+             *  @brief Records a copy between two buffers of the graph's
+             *         device.
+             *
+             *  @param src          The source buffer.
+             *  @param dst          The destination buffer.
+             *  @param src_offset   The offset on the source buffer.
+             *  @param dst_offset   The offset on the destination buffer.
+             *  @param size         The size of the area to copy.
+             *  @param dependencies The nodes this copy depends on.
+             *  @return             The index of the node.
+             */
+            std::size_t
+            add_copy( const hpx::opencl::buffer& src,
+                      const hpx::opencl::buffer& dst,
+                      std::size_t src_offset,
+                      std::size_t dst_offset,
+                      std::size_t size,
+                      std::vector<std::size_t> dependencies =
+                          std::vector<std::size_t>() );
+
+            /**
+             *  @brief Records a kernel execution.
+             *
+             *  The kernel runs with the buffer arguments set at replay
+             *  time. Scalar arguments can be set per replay with
+             *  graph_arguments::set_scalar. They belong to this node only,
+             *  so several nodes of the same kernel can use different
+             *  values, and they stay set for the following replays.
+             *
+             *  @param kernel       The kernel.
+             *  @param size         The work dimensions.
+             *  @param dependencies The nodes this kernel depends on.
+             *  @return             The index of the node.
+             */
+            template<std::size_t DIM>
+            std::size_t
+            add_kernel( const hpx::opencl::kernel& kernel,
+                        hpx::opencl::work_size<DIM> size,
+                        std::vector<std::size_t> dependencies =
+                            std::vector<std::size_t>() );
+
+            /**
+             *  @brief Sends the recorded commands to the device.
+             *
+             *  Needs to be called once, after recording and before the first
+             *  replay. No nodes can be added afterwards.
+             *
+             *  @return A future that will trigger once the graph is ready.
+             */
+            hpx::future<void> finalize();
+
+            // ///////////////////////////////////////////////
+            // Exposed Component functionality
+            //
+
+            /**
+             *  @brief Submits all recorded commands.
+             *
+             *  Replays of the same graph do not overlap on the device.
+             *
+             *  The returned future is not an OpenCL event and can therefore
+             *  not be used as dependency of other enqueue calls.
+             *
+             *  @param args         Per-replay scalar kernel arguments and
+             *                      write data.
+             *  @return             A future that triggers when all commands
+             *                      have completed. Contains the data of all
+             *                      read nodes, in order of recording.
+             */
+            template<typename ...Deps>
+            hpx::future<replay_result>
+            replay( hpx::opencl::graph_arguments args,
+                    Deps &&... dependencies ) const;
+
+            hpx::future<replay_result>
+            replay() const;
+
+        private:
+            hpx::future<replay_result>
+            replay_impl( hpx::opencl::graph_arguments && args,
+                         hpx::opencl::util::resolved_events && deps ) const;
+
+            std::size_t
+            add_node( util::graph_node && node );
+
+        private:
+            hpx::naming::id_type device_gid;
+
+            // the recorded nodes, only valid until finalize()
+            std::shared_ptr<std::vector<util::graph_node> > nodes;
+
+        private:
+            // serialization support
+            friend class hpx::serialization::access;
+
+            template <typename Archive>
+            void serialize(Archive & ar, unsigned)
+            {
+                HPX_ASSERT(device_gid);
+                ar & hpx::serialization::base_object<base_type>(*this);
+                ar & device_gid;
+            }
+
+    };
+
+}}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATIONS
+//
+template<typename T>
+std::size_t
+hpx::opencl::command_graph::add_write(
+                       const hpx::opencl::buffer& dst,
+                       std::size_t offset,
+                       hpx::serialization::serialize_buffer<T> data,
+                       std::vector<std::size_t> dependencies )
+{
+    // reuse the conversion of the replay arguments
+    hpx::opencl::graph_arguments converter;
+    converter.set_write_data(0, data);
+
+    util::graph_node node;
+    node.type = util::graph_node::write_node;
+    node.target = dst.get_id();
+    node.offset = offset;
+    node.size = data.size() * sizeof(T);
+    node.data = std::move(converter.writes[0].data);
+    node.dependencies = std::move(dependencies);
+
+    return add_node(std::move(node));
+}
+
+template<std::size_t DIM>
+std::size_t
+hpx::opencl::command_graph::add_kernel(
+                       const hpx::opencl::kernel& kernel,
+                       hpx::opencl::work_size<DIM> size,
+                       std::vector<std::size_t> dependencies )
+{
+    util::graph_node node;
+    node.type = util::graph_node::kernel_node;
+    node.target = kernel.get_id();
+    node.dependencies = std::move(dependencies);
+
+    // extract information from work_size struct
+    node.work_size.resize(3*DIM);
+    for(std::size_t i = 0; i < DIM; i++){
+        node.work_size[i + 0*DIM] = size[i].offset;
+        node.work_size[i + 1*DIM] = size[i].size;
+        node.work_size[i + 2*DIM] = size[i].local_size;
+    }
+
+    return add_node(std::move(node));
+}
+
+template<typename ...Deps>
+hpx::future<hpx::opencl::command_graph::replay_result>
+hpx::opencl::command_graph::replay( hpx::opencl::graph_arguments args,
+                                    Deps &&... dependencies ) const
+{
+    // combine dependency futures in one std::vector
+    using hpx::opencl::util::enqueue_overloads::resolver;
+    auto deps = resolver(device_gid.get_gid(),std::forward<Deps>(dependencies)...);
+    HPX_ASSERT(deps.are_from_device(device_gid));
+
+    return replay_impl( std::move(args), std::move(deps) );
+}
+
+#endif
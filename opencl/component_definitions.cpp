@@ -5,15 +5,26 @@
 
 #include <hpx/hpx.hpp>
 #include <hpx/config.hpp>
+#include <hpx/runtime/components/component_startup_shutdown.hpp>
 
 #include "server/create_devices.hpp"
 #include "server/device.hpp"
 #include "server/buffer.hpp"
 #include "server/program.hpp"
 #include "server/kernel.hpp"
+#include "server/command_graph.hpp"
+#include "server/util/module_startup.hpp"
+#include "profiling.hpp"
+#include "util/tracer.hpp"
+#include "launch_stages.hpp"
 
 HPX_REGISTER_COMPONENT_MODULE();
 
+// Installs the performance counters of the devices and sets up the tracer
+HPX_REGISTER_STARTUP_SHUTDOWN_MODULE(
+    hpx::opencl::server::util::get_module_startup,
+    hpx::opencl::server::util::get_module_shutdown);
+
 
 // DEVICE
 typedef hpx::opencl::server::device device_type;
@@ -25,8 +36,16 @@ HPX_REGISTER_ACTION(device_type::get_platform_info_action);
 HPX_REGISTER_ACTION(device_type::create_buffer_action);
 HPX_REGISTER_ACTION(device_type::create_program_with_source_action);
 HPX_REGISTER_ACTION(device_type::create_program_with_binary_action);
+HPX_REGISTER_ACTION(device_type::create_command_graph_action);
 HPX_REGISTER_ACTION(device_type::release_event_action);
 HPX_REGISTER_ACTION(device_type::activate_deferred_event_action);
+HPX_REGISTER_ACTION(device_type::create_user_event_action);
+HPX_REGISTER_ACTION(device_type::set_user_event_status_action);
+HPX_REGISTER_ACTION(device_type::import_event_action);
+HPX_REGISTER_ACTION(device_type::wait_for_event_action);
+HPX_REGISTER_ACTION(device_type::barrier_action);
+HPX_REGISTER_ACTION(device_type::finish_action);
+HPX_REGISTER_ACTION(device_type::get_kernel_profiles_action);
 
 
 // BUFFER
@@ -38,6 +57,7 @@ HPX_REGISTER_ACTION(buffer_type::size_action);
 HPX_REGISTER_ACTION(buffer_type::enqueue_read_action);
 HPX_REGISTER_ACTION(buffer_type::enqueue_send_action);
 HPX_REGISTER_ACTION(buffer_type::enqueue_send_rect_action);
+HPX_REGISTER_ACTION(buffer_type::enqueue_send_nowait_action);
 HPX_REGISTER_ACTION(buffer_type::get_parent_device_id_action);
 
 
@@ -50,6 +70,7 @@ HPX_REGISTER_ACTION(program_type::get_parent_device_id_action);
 HPX_REGISTER_ACTION(program_type::build_action);
 HPX_REGISTER_ACTION(program_type::get_binary_action);
 HPX_REGISTER_ACTION(program_type::create_kernel_action);
+HPX_REGISTER_ACTION(program_type::specialize_action);
 
 
 // KERNEL
@@ -60,11 +81,36 @@ HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(kernel_component_type, hpx_opencl_kernel)
 HPX_REGISTER_ACTION(kernel_type::get_parent_device_id_action);
 HPX_REGISTER_ACTION(kernel_type::set_arg_action);
 HPX_REGISTER_ACTION(kernel_type::enqueue_action);
+HPX_REGISTER_ACTION(kernel_type::enqueue_nowait_action);
+HPX_REGISTER_ACTION(kernel_type::enqueue_batch_action);
+HPX_REGISTER_ACTION(kernel_type::autotune_action);
+
+
+// COMMAND GRAPH
+typedef hpx::opencl::server::command_graph command_graph_type;
+typedef hpx::components::managed_component<command_graph_type>
+    command_graph_component_type;
+HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(command_graph_component_type,
+                                       hpx_opencl_command_graph);
+
+HPX_REGISTER_ACTION(command_graph_type::replay_action);
 
 
 // GLOBAL ACTIONS
 HPX_REGISTER_ACTION(hpx::opencl::server::create_devices_action,
                     hpx_opencl_server_create_devices_action);
+HPX_REGISTER_ACTION(hpx::opencl::server::release_devices_action,
+                    hpx_opencl_server_release_devices_action);
+HPX_REGISTER_ACTION(hpx::opencl::detail::store_timestamps_action,
+                    hpx_opencl_detail_store_timestamps_action);
+HPX_REGISTER_ACTION(hpx::opencl::detail::complete_profiled_event_action,
+                    hpx_opencl_detail_complete_profiled_event_action);
+HPX_REGISTER_ACTION(hpx::opencl::util::detail::flush_trace_action,
+                    hpx_opencl_util_detail_flush_trace_action);
+HPX_REGISTER_ACTION(hpx::opencl::detail::find_launch_stages_action,
+                    hpx_opencl_detail_find_launch_stages_action);
+HPX_REGISTER_ACTION(hpx::opencl::detail::get_host_name_action,
+                    hpx_opencl_detail_get_host_name_action);
 
 
 
@@ -0,0 +1,43 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Header File
+#include "core_budget.hpp"
+
+// HPX dependencies
+#include <hpx/hpx.hpp>
+
+#include <thread>
+
+std::vector<std::string>
+hpx::opencl::core_budget_configuration( std::size_t opencl_cores,
+                                        std::size_t total_cores )
+{
+
+    std::vector<std::string> cfg;
+
+    // No budget, HPX and OpenCL use everything
+    if(opencl_cores == 0)
+        return cfg;
+
+    if(total_cores == 0)
+        total_cores = std::thread::hardware_concurrency();
+
+    if(opencl_cores >= total_cores)
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "hpx::opencl::core_budget_configuration()",
+                            "No processing units left for HPX!");
+
+    // HPX workers on the processing units behind the reserved ones
+    cfg.push_back("hpx.os_threads=" + std::to_string(total_cores
+                                                     - opencl_cores));
+    cfg.push_back("hpx.pu_offset=" + std::to_string(opencl_cores));
+
+    // Read by the OpenCL component
+    cfg.push_back("hpx.opencl.cpu_cores=" + std::to_string(opencl_cores));
+
+    return cfg;
+
+}
@@ -0,0 +1,58 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_CORE_BUDGET_HPP_
+#define HPX_OPENCL_CORE_BUDGET_HPP_
+
+#include <hpx/config.hpp>
+
+#include "export_definitions.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{
+
+    /**
+     * @brief Creates the configuration that splits the processing units
+     *        between HPX and CPU OpenCL runtimes.
+     *
+     * The first opencl_cores processing units are reserved for the OpenCL
+     * runtime, the HPX workers get pinned to the remaining ones.
+     * This avoids the oversubscription that occurs if both use all cores.
+     *
+     * The result has to be passed to hpx::init(), as the HPX workers can't
+     * be moved after startup:
+     * \code{.cpp}
+     * return hpx::init(argc, argv,
+     *                  hpx::opencl::core_budget_configuration(4));
+     * \endcode
+     * The same split can be given on the command line:
+     * <BR>
+     * <tt>--hpx:threads=N-k --hpx:pu-offset=k
+     *     --hpx:ini=hpx.opencl.cpu_cores=k</tt>
+     *
+     * On the OpenCL side, the budget sets the thread count of POCL.
+     * With <tt>hpx.opencl.cpu_cores_subdevice=1</tt>, OpenCL 1.2 runtimes
+     * also restrict every CPU device to a sub-device with opencl_cores
+     * compute units.
+     *
+     * @param opencl_cores  The processing units reserved for OpenCL.
+     *                      0 disables the budget.
+     * @param total_cores   The processing units of this machine.
+     *                      0 uses all available processing units.
+     * @return The configuration entries for hpx::init()
+     */
+    HPX_OPENCL_EXPORT
+    std::vector<std::string>
+    core_budget_configuration( std::size_t opencl_cores,
+                               std::size_t total_cores = 0 );
+
+}}
+
+#endif
@@ -9,15 +9,19 @@
 // Internal Dependencies
 #include "device.hpp"
 #include "server/create_devices.hpp"
+#include "tools.hpp"
 
 // HPX dependencies
 #include <hpx/lcos/when_all.hpp>
 
+#include <map>
+
 static 
 hpx::lcos::future<std::vector<hpx::opencl::device>>
 create_devices_on_nodes( std::vector<hpx::naming::id_type> && localities,
                          cl_device_type device_type,
-                         std::string required_cl_version )
+                         std::string required_cl_version,
+                         hpx::opencl::device_partition partition )
 {
    
     // query all devices
@@ -30,7 +34,8 @@ create_devices_on_nodes( std::vector<hpx::naming::id_type> && localities,
         hpx::lcos::future<std::vector<hpx::opencl::device>>
         locality_device_future = hpx::opencl::create_devices(locality,
                                                              device_type,
-                                                             required_cl_version);
+                                                             required_cl_version,
+                                                             partition);
 
         // add locality device future to list of futures
         locality_device_futures.push_back(std::move(locality_device_future));
@@ -96,8 +101,21 @@ hpx::opencl::create_devices( hpx::naming::id_type node_id,
                              std::string required_cl_version)
 {
 
+    return create_devices( node_id, device_type, required_cl_version,
+                           device_partition() );
+
+}
+
+hpx::lcos::future<std::vector<hpx::opencl::device>>
+hpx::opencl::create_devices( hpx::naming::id_type node_id,
+                             cl_device_type device_type,
+                             std::string required_cl_version,
+                             device_partition partition )
+{
+
     typedef hpx::opencl::server::create_devices_action action;
-    return async<action>(node_id, device_type, required_cl_version);
+    return async<action>(node_id, device_type, required_cl_version,
+                         partition);
 
 }
 
@@ -106,11 +124,23 @@ hpx::opencl::create_local_devices( cl_device_type device_type,
                                    std::string required_cl_version)
 {
 
+    return create_local_devices( device_type, required_cl_version,
+                                 device_partition() );
+
+}
+
+hpx::lcos::future<std::vector<hpx::opencl::device>>
+hpx::opencl::create_local_devices( cl_device_type device_type,
+                                   std::string required_cl_version,
+                                   device_partition partition )
+{
+
     // get local locality id
     hpx::naming::id_type locality = hpx::find_here();
 
     // find devices on localities
-    return create_devices( locality, device_type, required_cl_version );
+    return create_devices( locality, device_type, required_cl_version,
+                           partition );
 
 }
 
@@ -119,6 +149,17 @@ hpx::opencl::create_remote_devices( cl_device_type device_type,
                                     std::string required_cl_version)
 {
 
+    return create_remote_devices( device_type, required_cl_version,
+                                  device_partition() );
+
+}
+
+hpx::lcos::future<std::vector<hpx::opencl::device>>
+hpx::opencl::create_remote_devices( cl_device_type device_type,
+                                    std::string required_cl_version,
+                                    device_partition partition )
+{
+
     // get remote HPX localities
     std::vector<hpx::naming::id_type> localities = 
                                         hpx::find_remote_localities();
@@ -126,7 +167,8 @@ hpx::opencl::create_remote_devices( cl_device_type device_type,
     // find devices on localities
     return create_devices_on_nodes( std::move(localities),
                                     device_type,
-                                    required_cl_version );
+                                    required_cl_version,
+                                    partition );
 
 }
 
@@ -135,6 +177,17 @@ hpx::opencl::create_all_devices( cl_device_type device_type,
                                  std::string required_cl_version)
 {
 
+    return create_all_devices( device_type, required_cl_version,
+                               device_partition() );
+
+}
+
+hpx::lcos::future<std::vector<hpx::opencl::device>>
+hpx::opencl::create_all_devices( cl_device_type device_type,
+                                 std::string required_cl_version,
+                                 device_partition partition )
+{
+
     // get all HPX localities
     std::vector<hpx::naming::id_type> localities = 
                                         hpx::find_all_localities();
@@ -142,8 +195,40 @@ hpx::opencl::create_all_devices( cl_device_type device_type,
     // find devices on localities
     return create_devices_on_nodes( std::move(localities),
                                     device_type,
-                                    required_cl_version );
+                                    required_cl_version,
+                                    partition );
 
 }
 
+hpx::lcos::future<void>
+hpx::opencl::release_devices( const std::vector<device> & devices )
+{
 
+    // group the devices by locality
+    std::map<hpx::naming::id_type, std::vector<hpx::naming::id_type> >
+        device_ids;
+    for(const auto & dev : devices)
+    {
+        hpx::naming::id_type locality =
+            hpx::opencl::tools::get_locality_of(dev.get_id());
+        device_ids[locality].push_back(dev.get_id());
+    }
+
+    // release on every locality
+    std::vector<hpx::lcos::future<void> > release_futures;
+    for(auto & locality_device_ids : device_ids)
+    {
+        typedef hpx::opencl::server::release_devices_action action;
+        release_futures.push_back(
+            async<action>( locality_device_ids.first,
+                           std::move(locality_device_ids.second) ));
+    }
+
+    return hpx::when_all(release_futures).then( hpx::launch::sync,
+        [](hpx::lcos::future<std::vector<hpx::lcos::future<void> > > && f)
+        {
+            for(auto & release_future : f.get())
+                release_future.get();
+        });
+
+}
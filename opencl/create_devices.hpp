@@ -19,6 +19,45 @@
 ////////////////////////////////////////////////////////////////
 namespace hpx { namespace opencl{
 
+    /**
+     * @brief Describes how the create_devices functions partition the
+     *        devices they find.
+     *
+     * Partitioning uses clCreateSubDevices and requires OpenCL 1.2.
+     * Every sub-device becomes a device of its own, with its own context
+     * and command queue. Devices that can't be partitioned the requested
+     * way are returned as a whole.
+     *
+     * Partitioning a CPU device by NUMA domain keeps the work-groups of
+     * one sub-device and the memory they touch on the same socket.
+     */
+    struct device_partition
+    {
+        enum partition_type {
+            // Use the whole device
+            none = 0,
+            // One sub-device per NUMA domain
+            by_numa_domain = 1,
+            // Sub-devices with compute_units compute units each
+            equally = 2
+        };
+
+        device_partition( int type_ = none, cl_uint compute_units_ = 0 )
+          : type(type_), compute_units(compute_units_)
+        {}
+
+        int type;
+
+        // The compute units per sub-device, only used by 'equally'
+        cl_uint compute_units;
+
+        template <typename Archive>
+        void serialize(Archive & ar, unsigned)
+        {
+            ar & type & compute_units;
+        }
+    };
+
     /**
      * @brief Fetches a list of accelerator devices present on target node.
      *
@@ -43,6 +82,18 @@ namespace hpx { namespace opencl{
     create_devices( hpx::naming::id_type node_id, cl_device_type device_type,
                     std::string required_cl_version );
 
+    /**
+     * @brief Same as create_devices(), but partitions the devices.
+     *
+     * @param partition           How to partition the devices, see
+     *                            \ref device_partition
+     */
+    HPX_OPENCL_EXPORT
+    hpx::lcos::future<std::vector<device>>
+    create_devices( hpx::naming::id_type node_id, cl_device_type device_type,
+                    std::string required_cl_version,
+                    device_partition partition );
+
     /**
      * @brief Fetches a list of all accelerator devices present in the current
      *        hpx environment.
@@ -67,6 +118,18 @@ namespace hpx { namespace opencl{
     create_all_devices( cl_device_type device_type,
                         std::string required_cl_version );
 
+    /**
+     * @brief Same as create_all_devices(), but partitions the devices.
+     *
+     * @param partition           How to partition the devices, see
+     *                            \ref device_partition
+     */
+    HPX_OPENCL_EXPORT
+    hpx::lcos::future<std::vector<device>>
+    create_all_devices( cl_device_type device_type,
+                        std::string required_cl_version,
+                        device_partition partition );
+
     /**
      * @brief Fetches a list of local accelerator devices present in the current
      *        hpx environment.
@@ -91,6 +154,18 @@ namespace hpx { namespace opencl{
     create_local_devices( cl_device_type device_type,
                           std::string required_cl_version );
 
+    /**
+     * @brief Same as create_local_devices(), but partitions the devices.
+     *
+     * @param partition           How to partition the devices, see
+     *                            \ref device_partition
+     */
+    HPX_OPENCL_EXPORT
+    hpx::lcos::future<std::vector<device>>
+    create_local_devices( cl_device_type device_type,
+                          std::string required_cl_version,
+                          device_partition partition );
+
     /**
      * @brief Fetches a list of remote accelerator devices present in the current
      *        hpx environment.
@@ -115,6 +190,34 @@ namespace hpx { namespace opencl{
     create_remote_devices( cl_device_type device_type,
                            std::string required_cl_version );
 
+    /**
+     * @brief Same as create_remote_devices(), but partitions the devices.
+     *
+     * @param partition           How to partition the devices, see
+     *                            \ref device_partition
+     */
+    HPX_OPENCL_EXPORT
+    hpx::lcos::future<std::vector<device>>
+    create_remote_devices( cl_device_type device_type,
+                           std::string required_cl_version,
+                           device_partition partition );
+
+    /**
+     * @brief Releases devices returned by the create_devices functions.
+     *
+     * All create_devices calls on a locality share the device components,
+     * one set per OpenCL device and partition. Every call counts as one
+     * reference, and the components stay alive until all references got
+     * released, or until shutdown. Afterwards, they live as long as
+     * clients of them exist.
+     *
+     * @param devices             The devices, as returned by one
+     *                            create_devices call
+     * @return A future that triggers once the devices got released
+     */
+    HPX_OPENCL_EXPORT
+    hpx::lcos::future<void>
+    release_devices( const std::vector<device> & devices );
 
 }}
 
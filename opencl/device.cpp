@@ -12,7 +12,11 @@
 // Dependencies
 #include "buffer.hpp"
 #include "program.hpp"
+#include "command_graph.hpp"
 #include "util/generic_buffer.hpp"
+#include "util/nowait_tracker.hpp"
+
+#include <memory>
 
 using hpx::opencl::device;
 
@@ -91,3 +95,101 @@ device::create_program_with_binary(
 
 }
 
+hpx::opencl::command_graph
+device::create_command_graph() const
+{
+
+    HPX_ASSERT(this->get_id());
+
+    return command_graph(this->get_id());
+
+}
+
+hpx::future<void>
+device::barrier_async() const
+{
+
+    HPX_ASSERT(this->get_id());
+
+    typedef hpx::opencl::server::device::barrier_action func;
+
+    return hpx::async<func>( this->get_id(), hpx::get_locality_id(),
+        hpx::opencl::util::nowait_tracker::submitted(this->get_id().get_gid()) );
+
+}
+
+hpx::future<void>
+device::finish_async() const
+{
+
+    HPX_ASSERT(this->get_id());
+
+    typedef hpx::opencl::server::device::finish_action func;
+
+    return hpx::async<func>( this->get_id(), hpx::get_locality_id(),
+        hpx::opencl::util::nowait_tracker::submitted(this->get_id().get_gid()) );
+
+}
+
+hpx::future<std::vector<hpx::opencl::kernel_profile> >
+device::get_kernel_profiles() const
+{
+
+    HPX_ASSERT(this->get_id());
+
+    typedef hpx::opencl::server::device::get_kernel_profiles_action func;
+
+    return hpx::async<func>( this->get_id() );
+
+}
+
+hpx::future<void>
+device::enqueue_host_task_impl(
+            hpx::util::unique_function_nonser<void()> && f,
+            std::vector<hpx::future<void> > && dependencies ) const
+{
+
+    HPX_ASSERT(this->get_id());
+
+    hpx::naming::id_type device_id = this->get_id();
+
+    // create local event, backed by a user event on the device
+    using hpx::opencl::lcos::event;
+    event<void> ev( device_id );
+    hpx::naming::id_type event_id = ev.get_event_id();
+
+    typedef hpx::opencl::server::device::create_user_event_action create_func;
+    hpx::apply<create_func>( device_id, event_id );
+
+    // run the function once the dependencies completed, then complete the
+    // user event
+    typedef hpx::util::unique_function_nonser<void()> function_type;
+    std::shared_ptr<function_type> task =
+        std::make_shared<function_type>(std::move(f));
+
+    hpx::when_all(dependencies).then( hpx::launch::async,
+        [task, device_id, event_id](
+            hpx::future<std::vector<hpx::future<void> > > && deps_future )
+        {
+            bool failed = false;
+            try {
+                // rethrow errors of the dependencies
+                std::vector<hpx::future<void> > deps = deps_future.get();
+                for(auto & dep : deps){
+                    dep.get();
+                }
+
+                (*task)();
+            } catch (...) {
+                failed = true;
+            }
+
+            typedef hpx::opencl::server::device::set_user_event_status_action
+                status_func;
+            hpx::apply<status_func>( device_id, event_id, failed );
+        });
+
+    // return future connected to event
+    return ev.get_future();
+
+}
@@ -23,6 +23,12 @@
 // Dependencies
 #include "detail/info_type.hpp"
 #include "util/generic_buffer.hpp"
+#include "util/enqueue_overloads.hpp"
+#include "profiling.hpp"
+
+#include <hpx/util/unique_function.hpp>
+
+#include <vector>
 
 namespace hpx {
 namespace opencl {
@@ -103,6 +109,84 @@ namespace opencl {
             create_program_with_binary(
                 const hpx::serialization::serialize_buffer<char> binary) const;
 
+            /**
+             *  @brief Creates an empty command graph
+             *
+             *  Commands get recorded on the client and sent to the device
+             *  with \ref command_graph::finalize().
+             *
+             *  @return         A command graph associated with the calling
+             *                  device.
+             *  @see            command_graph
+             */
+            hpx::opencl::command_graph
+            create_command_graph() const;
+
+            /**
+             *  @brief Separates the commands enqueued so far from the ones
+             *         enqueued afterwards.
+             *
+             *  Commands enqueued after the returned future triggered start
+             *  only after all earlier commands completed, including the
+             *  ones enqueued with enqueue_nowait() from this locality.
+             *
+             *  @return         A future that triggers once the barrier is
+             *                  in place.
+             */
+            hpx::future<void>
+            barrier_async() const;
+
+            /**
+             *  @brief Waits for all commands enqueued so far.
+             *
+             *  Includes the commands enqueued with enqueue_nowait() from
+             *  this locality, and reports their errors.
+             *
+             *  @return         A future that triggers once all commands
+             *                  completed.
+             */
+            hpx::future<void>
+            finish_async() const;
+
+            /**
+             *  @brief Returns the statistics of the kernels launched on
+             *         this device.
+             *
+             *  Has one entry per kernel name, over the kernels of all
+             *  programs of the device. The times need a device with
+             *  profiling enabled, see hpx.opencl.profiling.
+             *
+             *  @return         The statistics of all kernel names
+             */
+            hpx::future<std::vector<hpx::opencl::kernel_profile> >
+            get_kernel_profiles() const;
+
+            /**
+             *  @brief Runs a function on the host, as part of the device's
+             *         command stream.
+             *
+             *  The function runs on an HPX thread once all dependencies
+             *  completed. No thread blocks while waiting for them.
+             *
+             *  The returned future is an event of this device, so it can be
+             *  a dependency of later enqueue calls. Those get enqueued right
+             *  away and start as soon as the function returned. If the
+             *  function throws, the dependent commands fail.
+             *
+             *  @param f        The function to run. Gets called without
+             *                  arguments.
+             *  @return         A future that triggers once the function
+             *                  returned.
+             */
+            template<typename F, typename ...Deps>
+            hpx::future<void>
+            enqueue_host_task( F && f, Deps &&... dependencies ) const;
+
+            hpx::future<void>
+            enqueue_host_task_impl(
+                        hpx::util::unique_function_nonser<void()> && f,
+                        std::vector<hpx::future<void> > && dependencies ) const;
+
             /**
              *  @brief Queries device infos.
              *
@@ -177,6 +261,23 @@ namespace opencl {
 }}
 
 
+////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATIONS
+//
+template<typename F, typename ...Deps>
+hpx::future<void>
+hpx::opencl::device::enqueue_host_task( F && f,
+                                        Deps &&... dependencies ) const
+{
+    // convert the dependencies to futures the host can wait for
+    using hpx::opencl::util::enqueue_overloads::dependency_futures;
+    auto deps = dependency_futures(dependencies...);
+
+    return enqueue_host_task_impl(
+                hpx::util::unique_function_nonser<void()>(std::forward<F>(f)),
+                std::move(deps) );
+}
+
 #endif// HPX_OPENCL_DEVICE_HPP_
 
 
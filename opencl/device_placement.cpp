@@ -0,0 +1,266 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "device_placement.hpp"
+
+// Internal Dependencies
+#include "buffer.hpp"
+#include "program.hpp"
+#include "kernel.hpp"
+#include "tools.hpp"
+
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <string>
+
+using hpx::opencl::device_placement;
+
+
+// The kernel of the calibration run
+static const char calibration_src_str[] =
+"                                                                          \n"
+"   __kernel void calibrate(__global float * data)                         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       float x = data[tid];                                               \n"
+"       for(int i = 0; i < 256; i++)                                       \n"
+"           x = x * 0.999f + 0.001f;                                       \n"
+"       data[tid] = x;                                                     \n"
+"   }                                                                      \n"
+"                                                                          \n";
+
+// The work items of the calibration run
+static const std::size_t calibration_size = 1 << 18;
+
+
+device_placement::device_placement( std::vector<device> devices )
+  : remote_penalty(1.5)
+{
+
+    // query the device infos
+    std::vector<hpx::future<cl_uint> > compute_units;
+    std::vector<hpx::future<cl_uint> > clock_frequencies;
+    std::vector<hpx::future<cl_ulong> > global_memories;
+    std::vector<hpx::future<std::string> > extensions;
+    for(const auto & dev : devices)
+    {
+        compute_units.push_back(
+            dev.get_device_info<CL_DEVICE_MAX_COMPUTE_UNITS>());
+        clock_frequencies.push_back(
+            dev.get_device_info<CL_DEVICE_MAX_CLOCK_FREQUENCY>());
+        global_memories.push_back(
+            dev.get_device_info<CL_DEVICE_GLOBAL_MEM_SIZE>());
+        extensions.push_back(
+            dev.get_device_info<CL_DEVICE_EXTENSIONS>());
+    }
+
+    entries.reserve(devices.size());
+    for(std::size_t i = 0; i < devices.size(); i++)
+    {
+        device_entry entry;
+        entry.dev = devices[i];
+        entry.locality =
+            hpx::opencl::tools::get_locality_of(devices[i].get_id());
+
+        // estimate the throughput, at least 1 to keep the costs finite
+        entry.score = static_cast<double>(compute_units[i].get())
+                    * static_cast<double>(clock_frequencies[i].get());
+        if(entry.score < 1.0)
+            entry.score = 1.0;
+
+        std::string device_extensions = extensions[i].get();
+        entry.has_fp64 =
+            device_extensions.find("cl_khr_fp64") != std::string::npos ||
+            device_extensions.find("cl_amd_fp64") != std::string::npos;
+
+        entry.global_memory = global_memories[i].get();
+        entry.load = std::make_shared<device_load>();
+
+        entries.push_back(std::move(entry));
+    }
+
+}
+
+void
+device_placement::calibrate()
+{
+
+    typedef hpx::serialization::serialize_buffer<char> buffer_type;
+    buffer_type calibration_src( calibration_src_str,
+                                 sizeof(calibration_src_str),
+                                 buffer_type::init_mode::reference );
+
+    // build on all devices in parallel
+    std::vector<hpx::opencl::program> programs;
+    std::vector<hpx::future<void> > build_futures;
+    for(auto & entry : entries)
+    {
+        programs.push_back(
+            entry.dev.create_program_with_source(calibration_src));
+        build_futures.push_back(programs.back().build_async());
+    }
+    hpx::wait_all(build_futures);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = calibration_size;
+
+    // measure one device after the other, so they don't interfere
+    for(std::size_t i = 0; i < entries.size(); i++)
+    {
+        hpx::opencl::buffer data = entries[i].dev.create_buffer(
+            CL_MEM_READ_WRITE, calibration_size * sizeof(float));
+        hpx::opencl::kernel kernel = programs[i].create_kernel("calibrate");
+        kernel.set_arg(0, data);
+
+        hpx::serialization::serialize_buffer<float> zeros(calibration_size);
+        std::fill(zeros.data(), zeros.data() + calibration_size, 0.0f);
+        data.enqueue_write(0, zeros).get();
+
+        // warm up
+        kernel.enqueue(size).get();
+
+        hpx::util::high_resolution_timer timer;
+        kernel.enqueue(size).get();
+        double elapsed = timer.elapsed();
+
+        if(elapsed > 0.0)
+            entries[i].score = calibration_size / elapsed;
+    }
+
+}
+
+hpx::opencl::device
+device_placement::pick_device( const placement_hint & hint )
+{
+
+    hpx::naming::id_type preferred_locality = hint.locality;
+    if(!preferred_locality)
+        preferred_locality = hpx::find_here();
+
+    std::lock_guard<hpx::lcos::local::spinlock> pick_guard(pick_lock);
+
+    const device_entry * best = NULL;
+    double best_cost = std::numeric_limits<double>::max();
+    for(const auto & entry : entries)
+    {
+        // skip unsuitable devices
+        if(hint.needs_fp64 && !entry.has_fp64)
+            continue;
+        if(entry.global_memory < hint.min_global_memory)
+            continue;
+
+        double outstanding_work;
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> guard(entry.load->lock);
+            outstanding_work = entry.load->outstanding_work;
+        }
+
+        // the estimated time until the job would be done
+        double cost = (outstanding_work + hint.work) / entry.score;
+        if(entry.locality != preferred_locality)
+            cost *= remote_penalty;
+
+        if(cost < best_cost)
+        {
+            best_cost = cost;
+            best = &entry;
+        }
+    }
+
+    if(best == NULL)
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "hpx::opencl::device_placement::pick_device()",
+                            "No suitable device found!");
+
+    // charge the work
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(best->load->lock);
+        best->load->outstanding_work += hint.work;
+    }
+
+    return best->dev;
+
+}
+
+void
+device_placement::release( const device & dev, double work )
+{
+
+    const device_entry & entry = find_entry(dev);
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(entry.load->lock);
+    entry.load->outstanding_work -= work;
+
+}
+
+hpx::future<void>
+device_placement::release_on_completion( const device & dev,
+                                         hpx::future<void> && f,
+                                         double work )
+{
+
+    std::shared_ptr<device_load> load = find_entry(dev).load;
+
+    return f.then( hpx::launch::sync,
+        [load, work](hpx::future<void> && f)
+        {
+            {
+                std::lock_guard<hpx::lcos::local::spinlock> guard(load->lock);
+                load->outstanding_work -= work;
+            }
+
+            // propagate errors
+            f.get();
+        });
+
+}
+
+double
+device_placement::get_outstanding_work( const device & dev ) const
+{
+
+    const device_entry & entry = find_entry(dev);
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(entry.load->lock);
+    return entry.load->outstanding_work;
+
+}
+
+double
+device_placement::get_score( const device & dev ) const
+{
+
+    return find_entry(dev).score;
+
+}
+
+void
+device_placement::set_remote_penalty( double penalty )
+{
+
+    remote_penalty = penalty;
+
+}
+
+const device_placement::device_entry &
+device_placement::find_entry( const device & dev ) const
+{
+
+    for(const auto & entry : entries)
+    {
+        if(entry.dev.get_id() == dev.get_id())
+            return entry;
+    }
+
+    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "hpx::opencl::device_placement",
+                        "Device is not part of this placement!");
+
+}
@@ -0,0 +1,171 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_DEVICE_PLACEMENT_HPP_
+#define HPX_OPENCL_DEVICE_PLACEMENT_HPP_
+
+// Default includes
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+// Export definitions
+#include "export_definitions.hpp"
+
+// OpenCL
+#include "cl_headers.hpp"
+
+#include "device.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace hpx {
+namespace opencl {
+
+    //////////////////////////////////////
+    /// @brief The requirements of a job, for \ref device_placement.
+    ///
+    struct placement_hint
+    {
+        placement_hint()
+          : needs_fp64(false), min_global_memory(0), work(1.0)
+        {}
+
+        /// Only consider devices with double precision support
+        bool needs_fp64;
+
+        /// Only consider devices with at least this much global memory
+        cl_ulong min_global_memory;
+
+        /// The amount of work of the job, relative to other jobs
+        double work;
+
+        /// The preferred locality. Defaults to the calling locality.
+        hpx::naming::id_type locality;
+    };
+
+    //////////////////////////////////////
+    /// @brief Places independent jobs on a set of devices.
+    ///
+    /// Every device gets a score, an estimate of its throughput. It is
+    /// computed from the compute units and the clock frequency and can be
+    /// replaced by a measurement with calibrate().
+    ///
+    /// pick_device() charges the work of the job to the device it returns.
+    /// The work stays outstanding until it is released, usually with
+    /// release_on_completion(). Every pick chooses the suitable device that
+    /// would finish its outstanding work plus the new job first. Devices on
+    /// other localities count as slower by the remote penalty.
+    ///
+    /// Example:
+    /// \code{.cpp}
+    ///     hpx::opencl::device_placement placement(
+    ///         hpx::opencl::create_all_devices(CL_DEVICE_TYPE_ALL,
+    ///                                         "OpenCL 1.1").get() );
+    ///
+    ///     for(auto & job : jobs){
+    ///         hpx::opencl::device device = placement.pick_device();
+    ///         futures.push_back( placement.release_on_completion(
+    ///                                device, run_job(device, job) ) );
+    ///     }
+    /// \endcode
+    ///
+    class HPX_OPENCL_EXPORT device_placement
+    {
+        public:
+            /**
+             *  @brief Scores the given devices.
+             *
+             *  Queries the device infos, blocks until they arrived.
+             */
+            device_placement( std::vector<device> devices );
+
+            /**
+             *  @brief Measures the throughput of all devices.
+             *
+             *  Runs a short compute kernel on every device, one device after
+             *  the other, and uses the results as scores.
+             *  Blocks until all measurements completed.
+             */
+            void calibrate();
+
+            /**
+             *  @brief Returns the best suited device for a job.
+             *
+             *  Charges hint.work to the returned device.
+             *
+             *  @param hint     The requirements of the job
+             *  @return         The least loaded suitable device
+             */
+            device pick_device( const placement_hint & hint = placement_hint() );
+
+            /**
+             *  @brief Releases work that pick_device() charged to a device.
+             */
+            void release( const device & dev, double work = 1.0 );
+
+            /**
+             *  @brief Releases work that pick_device() charged to a device,
+             *         once the given future triggers.
+             *
+             *  @return         A future that triggers together with the
+             *                  given future, after the work got released.
+             */
+            hpx::future<void>
+            release_on_completion( const device & dev, hpx::future<void> && f,
+                                   double work = 1.0 );
+
+            /**
+             *  @brief Returns the work currently charged to a device.
+             */
+            double get_outstanding_work( const device & dev ) const;
+
+            /**
+             *  @brief Returns the score of a device.
+             */
+            double get_score( const device & dev ) const;
+
+            /**
+             *  @brief Sets how much slower devices on other localities count.
+             *         The default is 1.5.
+             */
+            void set_remote_penalty( double penalty );
+
+        private:
+            // The outstanding work of one device. Shared with the
+            // continuations of release_on_completion().
+            struct device_load
+            {
+                device_load() : outstanding_work(0.0) {}
+
+                hpx::lcos::local::spinlock lock;
+                double outstanding_work;
+            };
+
+            struct device_entry
+            {
+                device dev;
+                hpx::naming::id_type locality;
+                double score;
+                bool has_fp64;
+                cl_ulong global_memory;
+                std::shared_ptr<device_load> load;
+            };
+
+            const device_entry & find_entry( const device & dev ) const;
+
+        private:
+            std::vector<device_entry> entries;
+            double remote_penalty;
+
+            // Serializes picks, so that concurrent picks see each other's
+            // charged work
+            hpx::lcos::local::spinlock pick_lock;
+    };
+
+}}
+
+#endif// HPX_OPENCL_DEVICE_PLACEMENT_HPP_
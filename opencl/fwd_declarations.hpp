@@ -22,6 +22,7 @@ namespace opencl {
     class buffer;
     class program;
     class kernel;
+    class command_graph;
 
     // The OpenCL server namespace
     namespace server {
@@ -30,6 +31,7 @@ namespace opencl {
         class HPX_OPENCL_EXPORT buffer;
         class HPX_OPENCL_EXPORT program;
         class HPX_OPENCL_EXPORT kernel;
+        class HPX_OPENCL_EXPORT command_graph;
 
     }
 
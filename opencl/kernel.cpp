@@ -9,6 +9,8 @@
 // Internal Dependencies
 #include "server/kernel.hpp"
 #include "buffer.hpp"
+#include "util/nowait_tracker.hpp"
+#include "launch_stages.hpp"
 
 using hpx::opencl::kernel;
 
@@ -33,6 +35,8 @@ kernel::set_arg(cl_uint arg_index, const hpx::opencl::buffer &arg) const
 hpx::lcos::future<void>
 kernel::set_arg_async(cl_uint arg_index, const hpx::opencl::buffer &arg) const
 {
+    hpx::opencl::util::tracer::scope trace( "kernel::set_arg",
+                                            "client" );
 
     HPX_ASSERT(this->get_id());
 
@@ -50,6 +54,16 @@ kernel::enqueue_impl( std::vector<std::size_t> && size_vec,
     // create local event
     using hpx::opencl::lcos::event;
     event<void> ev( device_gid );
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::event_created(
+            ev.get_event_id().get_gid() );
+
+    hpx::naming::gid_type event_gid;
+    if(hpx::opencl::detail::launch_stages_enabled()){
+        event_gid = ev.get_event_id().get_gid();
+        hpx::opencl::detail::record_launch_stage( event_gid,
+                                &hpx::opencl::launch_stages::resolved );
+    }
 
     // send command to server class
     typedef hpx::opencl::server::kernel::enqueue_action func;
@@ -58,7 +72,81 @@ kernel::enqueue_impl( std::vector<std::size_t> && size_vec,
                       size_vec,
                       std::move(deps.event_ids) );
 
+    if(event_gid)
+        hpx::opencl::detail::record_launch_stage( event_gid,
+                                &hpx::opencl::launch_stages::sent );
+
     // return future connected to event
     return ev.get_future();
 
 }
+
+void
+kernel::enqueue_nowait_impl( std::vector<std::size_t> && size_vec,
+                             hpx::opencl::util::resolved_events && deps ) const
+{
+
+    // count the command, device::finish_async() waits for it
+    hpx::opencl::util::nowait_tracker::submit(device_gid.get_gid());
+
+    // send command to server class
+    typedef hpx::opencl::server::kernel::enqueue_nowait_action func;
+    hpx::apply<func>( this->get_id(),
+                      std::move(size_vec),
+                      std::move(deps.event_ids),
+                      hpx::get_locality_id() );
+
+}
+
+hpx::future<std::vector<std::size_t> >
+kernel::autotune_impl( std::vector<std::size_t> && size_vec,
+                       std::vector<std::size_t> && candidates,
+                       hpx::opencl::util::resolved_events && deps ) const
+{
+
+    // send command to server class
+    typedef hpx::opencl::server::kernel::autotune_action func;
+    return hpx::async<func>( this->get_id(),
+                             std::move(size_vec),
+                             std::move(candidates),
+                             std::move(deps.event_ids) );
+
+}
+
+
+void
+kernel::enable_batching( cl_uint table_arg_index,
+                         std::chrono::microseconds window,
+                         std::size_t max_launches )
+{
+
+    ensure_device_id();
+
+    // send the launches gathered so far
+    disable_batching();
+
+    batcher = std::make_shared<hpx::opencl::util::launch_batcher>(
+                    this->get_id(), device_gid, table_arg_index,
+                    window, max_launches );
+
+}
+
+void
+kernel::disable_batching()
+{
+
+    if(batcher){
+        batcher->flush();
+        batcher.reset();
+    }
+
+}
+
+void
+kernel::flush_batch() const
+{
+
+    if(batcher)
+        batcher->flush();
+
+}
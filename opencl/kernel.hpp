@@ -23,10 +23,68 @@
 // Crazy function overloading
 #include "util/enqueue_overloads.hpp"
 
+// Launch batching
+#include "util/launch_batcher.hpp"
+#include "util/tracer.hpp"
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
 
 namespace hpx {
 namespace opencl {
 
+    ////////////////////////
+    /// @brief Use as work_size local_size to select the local work size
+    ///        found by kernel::autotune().
+    ///
+    /// If the kernel was never tuned for the given global work size, the
+    /// OpenCL driver decides, as with a local_size of 0.
+    ///
+    static const std::size_t local_size_auto = static_cast<std::size_t>(-1);
+
+    ////////////////////////
+    /// @brief OpenCL source of the index table lookup for batched launches.
+    ///
+    /// Kernels that get launched with batching enabled (see
+    /// kernel::enable_batching()) run once for several launches. They take
+    /// the index table as two arguments and use hpxcl_batch_global_id()
+    /// instead of get_global_id(0).
+    ///
+    /// Example:
+    /// \code{.cpp}
+    ///     std::string src = hpx::opencl::batch_index_source;
+    ///     src += "__kernel void f(__global uint* data,          \n"
+    ///            "                __global const ulong* table,  \n"
+    ///            "                uint num_launches)            \n"
+    ///            "{                                             \n"
+    ///            "    ulong i = hpxcl_batch_global_id(table,    \n"
+    ///            "                                num_launches);\n"
+    ///            "    data[i] += 1;                             \n"
+    ///            "}                                             \n";
+    /// \endcode
+    ///
+    static const char batch_index_source[] =
+    "                                                                        \n"
+    "   ulong hpxcl_batch_global_id( __global const ulong* hpxcl_table,      \n"
+    "                                uint hpxcl_num_launches )               \n"
+    "   {                                                                    \n"
+    "       ulong id = get_global_id(0);                                     \n"
+    "       uint lo = 0;                                                     \n"
+    "       uint hi = hpxcl_num_launches;                                    \n"
+    "       while(hi - lo > 1){                                              \n"
+    "           uint mid = lo + (hi - lo) / 2;                               \n"
+    "           if(hpxcl_table[2 * mid] <= id)                               \n"
+    "               lo = mid;                                                \n"
+    "           else                                                         \n"
+    "               hi = mid;                                                \n"
+    "       }                                                                \n"
+    "       return hpxcl_table[2 * lo + 1] + (id - hpxcl_table[2 * lo]);     \n"
+    "   }                                                                    \n"
+    "                                                                        \n";
+
     ////////////////////////
     /// @brief Kernel execution dimensions.
     ///
@@ -45,6 +103,7 @@ namespace opencl {
     ///     // Set local work size.
     ///     // This can be left out.
     ///     // OpenCL will then automatically determine the best local work size.
+    ///     // Set it to local_size_auto to use the result of kernel::autotune().
     ///     dim[0].local_size = 64;
     ///
     ///     // Enqueue a kernel using the work_size object
@@ -147,6 +206,105 @@ namespace opencl {
             enqueue_impl( std::vector<std::size_t> && size_vec,
                           hpx::opencl::util::resolved_events && deps ) const;
 
+            /**
+             *  @brief Starts execution of a kernel, without creating an
+             *         event.
+             *
+             *  This skips the event bookkeeping of enqueue(), which
+             *  dominates the cost of short kernels. Use
+             *  device::barrier_async() or device::finish_async() to
+             *  synchronize with the kernel. Errors get reported by the next
+             *  device::finish_async().
+             *
+             *  @param size     The work dimensions on which the kernel should
+             *                  get executed on.
+             */
+            template<std::size_t DIM, typename ...Deps>
+            void
+            enqueue_nowait( hpx::opencl::work_size<DIM> size,
+                            Deps &&... dependencies ) const;
+
+            void
+            enqueue_nowait_impl( std::vector<std::size_t> && size_vec,
+                                 hpx::opencl::util::resolved_events && deps ) const;
+
+            /**
+             *  @brief Finds the fastest local work size for the given work
+             *         dimensions.
+             *
+             *  Every candidate is timed on the device using profiling
+             *  events. The kernel gets executed several times per candidate,
+             *  so its arguments need to tolerate repeated execution.
+             *
+             *  The winner is stored in a tuning database keyed by kernel,
+             *  device and global work size. Later calls to enqueue() with
+             *  a local_size of \ref local_size_auto use it.
+             *
+             *  @param size         The work dimensions. Local sizes are
+             *                      ignored.
+             *  @param candidates   The local work sizes to try. If empty,
+             *                      powers of two that are multiples of
+             *                      CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE
+             *                      and fit CL_KERNEL_WORK_GROUP_SIZE are tried.
+             *  @return             A future to the work dimensions, with the
+             *                      local sizes set to the winner. They are
+             *                      0 if the driver default was the fastest.
+             */
+            template<std::size_t DIM, typename ...Deps>
+            hpx::lcos::future<hpx::opencl::work_size<DIM> >
+            autotune( hpx::opencl::work_size<DIM> size,
+                      std::vector<std::array<std::size_t, DIM> > candidates,
+                      Deps &&... dependencies ) const;
+
+            /**
+             *  @brief Enables launch batching for this kernel handle.
+             *
+             *  Launches of short kernels are dominated by their overhead.
+             *  With batching enabled, one-dimensional launches whose
+             *  dependencies are satisfied get gathered for a short window
+             *  and run as one launch over the concatenation of their
+             *  ranges. Every launch still gets its own future.
+             *
+             *  The kernel needs to be written for this: it gets an index
+             *  table as arguments table_arg_index (a buffer) and
+             *  table_arg_index + 1 (the number of launches), and maps its
+             *  work items with hpxcl_batch_global_id() from
+             *  \ref batch_index_source. Launches need to use the same
+             *  local size to share a batch.
+             *
+             *  Batching applies to this handle and its copies made
+             *  afterwards, it does not get serialized.
+             *
+             *  @param table_arg_index  The argument index of the index table.
+             *  @param window           How long a batch waits for more
+             *                          launches.
+             *  @param max_launches     The batch gets sent once it holds
+             *                          this many launches.
+             */
+            void
+            enable_batching( cl_uint table_arg_index,
+                             std::chrono::microseconds window =
+                                 std::chrono::microseconds(50),
+                             std::size_t max_launches = 64 );
+
+            /**
+             *  @brief Disables launch batching. Pending launches get sent.
+             */
+            void
+            disable_batching();
+
+            /**
+             *  @brief Sends the pending batch without waiting for its
+             *         window to expire.
+             */
+            void
+            flush_batch() const;
+
+            hpx::lcos::future<std::vector<std::size_t> >
+            autotune_impl( std::vector<std::size_t> && size_vec,
+                           std::vector<std::size_t> && candidates,
+                           hpx::opencl::util::resolved_events && deps ) const;
+
 
         protected:
             void ensure_device_id() const;
@@ -154,6 +312,9 @@ namespace opencl {
         private:
             mutable hpx::naming::id_type device_gid;
 
+            // gathers launches, if batching is enabled
+            std::shared_ptr<util::launch_batcher> batcher;
+
         private:
             // serialization support
             friend class hpx::serialization::access;
@@ -179,13 +340,30 @@ hpx::future<void>
 hpx::opencl::kernel::enqueue( hpx::opencl::work_size<DIM> size,
                              Deps &&... dependencies ) const
 {
+    hpx::opencl::util::tracer::scope trace( "kernel::enqueue",
+                                            "client" );
     ensure_device_id();
 
+    // only launches with satisfied dependencies can join a batch
+    using hpx::opencl::util::enqueue_overloads::dependencies_ready;
+    bool deps_ready = batcher && dependencies_ready(dependencies...);
+
     // combine dependency futures in one std::vector
     using hpx::opencl::util::enqueue_overloads::resolver;
     auto deps = resolver(device_gid.get_gid(),std::forward<Deps>(dependencies)...);
     HPX_ASSERT(deps.are_from_device(device_gid));
 
+    // hand the launch to the batcher, if batching is enabled
+    if(batcher){
+        if(DIM != 1)
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "kernel::enqueue()",
+                                "Launch batching only supports "
+                                "one-dimensional work sizes!");
+
+        return batcher->add( size[0].offset, size[0].size, size[0].local_size,
+                             std::move(deps), deps_ready );
+    }
+
     // extract information from work_size struct
     std::vector<std::size_t> size_vec(3*DIM);
     for(std::size_t i = 0; i < DIM; i++){
@@ -199,4 +377,77 @@ hpx::opencl::kernel::enqueue( hpx::opencl::work_size<DIM> size,
 
 }
 
+template<std::size_t DIM, typename ...Deps>
+void
+hpx::opencl::kernel::enqueue_nowait( hpx::opencl::work_size<DIM> size,
+                                     Deps &&... dependencies ) const
+{
+    hpx::opencl::util::tracer::scope trace( "kernel::enqueue_nowait",
+                                            "client" );
+    ensure_device_id();
+
+    // combine dependency futures in one std::vector
+    using hpx::opencl::util::enqueue_overloads::resolver;
+    auto deps = resolver(device_gid.get_gid(),std::forward<Deps>(dependencies)...);
+    HPX_ASSERT(deps.are_from_device(device_gid));
+
+    // extract information from work_size struct
+    std::vector<std::size_t> size_vec(3*DIM);
+    for(std::size_t i = 0; i < DIM; i++){
+        size_vec[i + 0*DIM] = size[i].offset;
+        size_vec[i + 1*DIM] = size[i].size;
+        size_vec[i + 2*DIM] = size[i].local_size;
+    }
+
+    // forward to enqueue_nowait_impl
+    enqueue_nowait_impl( std::move(size_vec), std::move(deps) );
+
+}
+
+template<std::size_t DIM, typename ...Deps>
+hpx::future<hpx::opencl::work_size<DIM> >
+hpx::opencl::kernel::autotune( hpx::opencl::work_size<DIM> size,
+                               std::vector<std::array<std::size_t, DIM> > candidates,
+                               Deps &&... dependencies ) const
+{
+    ensure_device_id();
+
+    // combine dependency futures in one std::vector
+    using hpx::opencl::util::enqueue_overloads::resolver;
+    auto deps = resolver(device_gid.get_gid(),std::forward<Deps>(dependencies)...);
+    HPX_ASSERT(deps.are_from_device(device_gid));
+
+    // extract information from work_size struct
+    std::vector<std::size_t> size_vec(3*DIM);
+    for(std::size_t i = 0; i < DIM; i++){
+        size_vec[i + 0*DIM] = size[i].offset;
+        size_vec[i + 1*DIM] = size[i].size;
+        size_vec[i + 2*DIM] = size[i].local_size;
+    }
+
+    // flatten the candidates
+    std::vector<std::size_t> candidates_vec;
+    candidates_vec.reserve(DIM * candidates.size());
+    for(const auto & candidate : candidates){
+        candidates_vec.insert(candidates_vec.end(), candidate.begin(),
+                                                    candidate.end());
+    }
+
+    // forward to autotune_impl, then put the result into the work_size
+    return autotune_impl( std::move(size_vec), std::move(candidates_vec),
+                          std::move(deps) ).then(
+        [size](hpx::future<std::vector<std::size_t> > && result)
+        {
+            std::vector<std::size_t> local_size = result.get();
+
+            hpx::opencl::work_size<DIM> tuned_size = size;
+            for(std::size_t i = 0; i < DIM; i++){
+                tuned_size[i].local_size =
+                    local_size.empty() ? 0 : local_size[i];
+            }
+            return tuned_size;
+        });
+
+}
+
 #endif
@@ -0,0 +1,108 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "launch_stages.hpp"
+
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+
+// The launch stages of the events of this locality
+namespace {
+    struct stage_registry
+    {
+        stage_registry() : enabled(false), size(0) {}
+
+        std::atomic<bool> enabled;
+
+        hpx::lcos::local::spinlock lock;
+        std::map<hpx::naming::gid_type,
+                 hpx::opencl::launch_stages> entries;
+
+        // Lets the event destructors skip the lock if nothing got recorded
+        std::atomic<std::size_t> size;
+    };
+
+    stage_registry& get_stage_registry()
+    {
+        static stage_registry registry;
+        return registry;
+    }
+}
+
+void
+hpx::opencl::detail::init_launch_stages()
+{
+    get_stage_registry().enabled.store(
+        hpx::get_config_entry("hpx.opencl.launch_stages", "0") == "1",
+        std::memory_order_relaxed);
+}
+
+bool
+hpx::opencl::detail::launch_stages_enabled()
+{
+    return get_stage_registry().enabled.load(std::memory_order_relaxed);
+}
+
+void
+hpx::opencl::detail::record_launch_stage(
+    const hpx::naming::gid_type & event_gid,
+    std::uint64_t hpx::opencl::launch_stages::* stage )
+{
+    stage_registry& registry = get_stage_registry();
+
+    if(!registry.enabled.load(std::memory_order_relaxed))
+        return;
+
+    std::uint64_t now = hpx::util::high_resolution_clock::now();
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(registry.lock);
+    registry.entries[event_gid].*stage = now;
+    registry.size.store(registry.entries.size(), std::memory_order_relaxed);
+}
+
+hpx::opencl::launch_stages
+hpx::opencl::detail::find_launch_stages( hpx::naming::gid_type event_gid )
+{
+    stage_registry& registry = get_stage_registry();
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(registry.lock);
+    auto it = registry.entries.find(event_gid);
+    if(it == registry.entries.end())
+        return hpx::opencl::launch_stages();
+
+    return it->second;
+}
+
+void
+hpx::opencl::detail::release_launch_stages(
+    const hpx::naming::gid_type & event_gid )
+{
+    stage_registry& registry = get_stage_registry();
+
+    if(registry.size.load(std::memory_order_relaxed) == 0)
+        return;
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(registry.lock);
+    registry.entries.erase(event_gid);
+    registry.size.store(registry.entries.size(), std::memory_order_relaxed);
+}
+
+hpx::opencl::launch_stages
+hpx::opencl::detail::merge_launch_stages(
+    hpx::opencl::launch_stages client,
+    const hpx::opencl::launch_stages & server )
+{
+    client.action_started = server.action_started;
+    client.enqueue_returned = server.enqueue_returned;
+    client.completed = server.completed;
+    client.lco_set = server.lco_set;
+
+    return client;
+}
@@ -0,0 +1,161 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_LAUNCH_STAGES_HPP_
+#define HPX_OPENCL_LAUNCH_STAGES_HPP_
+
+// Default includes
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+// Export definitions
+#include "export_definitions.hpp"
+
+#include "lcos/event.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace hpx {
+namespace opencl {
+
+    //////////////////////////////////////
+    /// @brief The host timestamps of the stages of one kernel::enqueue(),
+    ///        in nanoseconds.
+    ///
+    /// Recorded with hpx.opencl.launch_stages=1. The client stages use the
+    /// clock of the client locality, the server stages the clock of the
+    /// device locality. Only on a local device both are comparable.
+    ///
+    /// The call to kernel::enqueue() and the moment its future becomes
+    /// ready are up to the caller to timestamp, with
+    /// hpx::util::high_resolution_clock::now().
+    ///
+    /// Stages that did not get recorded are 0.
+    ///
+    struct launch_stages
+    {
+        launch_stages()
+          : resolved(0), sent(0), action_started(0), enqueue_returned(0),
+            completed(0), lco_set(0)
+        {}
+
+        /// Client: the dependencies are resolved, the event got created
+        std::uint64_t resolved;
+
+        /// Client: the enqueue action is handed to the parcel layer
+        std::uint64_t sent;
+
+        /// Server: the enqueue action started running
+        std::uint64_t action_started;
+
+        /// Server: clEnqueueNDRangeKernel returned
+        std::uint64_t enqueue_returned;
+
+        /// Server: the server noticed the completion of the kernel. This
+        ///         only happens once the future got waited for.
+        std::uint64_t completed;
+
+        /// Server: the client event is about to get triggered
+        std::uint64_t lco_set;
+
+        template <typename Archive>
+        void serialize(Archive & ar, unsigned)
+        {
+            ar & resolved & sent & action_started & enqueue_returned
+               & completed & lco_set;
+        }
+    };
+
+    namespace detail
+    {
+        // Reads hpx.opencl.launch_stages. Runs as part of the startup
+        // function of the component module.
+        HPX_OPENCL_EXPORT void init_launch_stages();
+
+        // Whether launch stages get recorded. Does not change after
+        // startup.
+        HPX_OPENCL_EXPORT bool launch_stages_enabled();
+
+        // Stores one stage of an event of this locality, if enabled
+        HPX_OPENCL_EXPORT void
+        record_launch_stage( const hpx::naming::gid_type & event_gid,
+                             std::uint64_t launch_stages::* stage );
+
+        // Looks up the stages this locality recorded for an event
+        HPX_OPENCL_EXPORT hpx::opencl::launch_stages
+        find_launch_stages( hpx::naming::gid_type event_gid );
+
+        // Drops the stages of an event, called when the event gets
+        // destroyed
+        HPX_OPENCL_EXPORT void
+        release_launch_stages( const hpx::naming::gid_type & event_gid );
+
+        HPX_DEFINE_PLAIN_ACTION(find_launch_stages, find_launch_stages_action);
+
+        // Merges the server stages into the client stages
+        HPX_OPENCL_EXPORT hpx::opencl::launch_stages
+        merge_launch_stages( hpx::opencl::launch_stages client,
+                             const hpx::opencl::launch_stages & server );
+    }
+
+    /**
+     *  @brief Returns the stages of a completed kernel::enqueue().
+     *
+     *  Works on the futures returned by kernel::enqueue(), once they are
+     *  ready. Fetches the server stages from the locality of the device.
+     *
+     *  Needs hpx.opencl.launch_stages=1 on all involved localities.
+     *
+     *  @param fut      A ready future of kernel::enqueue()
+     *  @return         A future to the stages of the launch
+     *  @throws         hpx::bad_parameter if the future is no completed
+     *                  OpenCL command
+     */
+    template<typename Future>
+    hpx::future<launch_stages>
+    get_launch_stages( const Future & fut )
+    {
+        typedef typename std::remove_reference<Future>::type::result_type
+            result_type;
+        typedef typename hpx::opencl::lcos::event<result_type>::shared_state_type
+            event_type;
+
+        auto shared_state = hpx::traits::detail::get_shared_state(fut);
+
+        auto ev = boost::dynamic_pointer_cast<event_type>(shared_state);
+        if(!ev || !fut.is_ready())
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "hpx::opencl::get_launch_stages()",
+                                "The future is no completed OpenCL command!");
+
+        hpx::naming::gid_type event_gid = ev->get_event_id().get_gid();
+        launch_stages client = detail::find_launch_stages(event_gid);
+
+        // a local device recorded into the same registry
+        std::uint32_t device_locality =
+            hpx::naming::get_locality_id_from_gid(ev->get_device_gid());
+        if(device_locality == hpx::get_locality_id())
+            return hpx::make_ready_future(client);
+
+        typedef detail::find_launch_stages_action func;
+        return hpx::async<func>(
+                    hpx::naming::get_id_from_locality_id(device_locality),
+                    event_gid
+                ).then(
+                    [client](hpx::future<launch_stages> && server)
+                    {
+                        return detail::merge_launch_stages(client,
+                                                           server.get());
+                    });
+    }
+
+}}
+
+HPX_REGISTER_ACTION_DECLARATION(hpx::opencl::detail::find_launch_stages_action,
+                                hpx_opencl_detail_find_launch_stages_action)
+
+#endif// HPX_OPENCL_LAUNCH_STAGES_HPP_
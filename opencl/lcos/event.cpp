@@ -6,13 +6,20 @@
 #include "event.hpp"
 
 #include "../server/device.hpp"
+#include "../profiling.hpp"
+#include "../launch_stages.hpp"
 
 void
 hpx::opencl::lcos::detail::unregister_event( hpx::naming::id_type device_id,
-                                             hpx::naming::gid_type event_gid )
+                                             hpx::naming::gid_type event_gid,
+                                             bool completed )
 {
     HPX_ASSERT(device_id && event_gid);
 
+    // drop the timestamps of the event, if it got profiled
+    hpx::opencl::detail::release_timestamps( event_gid, !completed );
+    hpx::opencl::detail::release_launch_stages( event_gid );
+
     typedef hpx::opencl::server::device::release_event_action func;
     hpx::apply<func>( device_id, event_gid );
 }
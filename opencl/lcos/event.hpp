@@ -30,8 +30,11 @@ namespace hpx { namespace opencl { namespace lcos
 namespace hpx { namespace opencl { namespace lcos { namespace detail
 {
     ///////////////////////////////////////////////////////////////////////////
+    // The device might still deliver timestamps to an event that did not
+    // complete before it got destroyed
     HPX_OPENCL_EXPORT void unregister_event( hpx::naming::id_type device_id,
-                           hpx::naming::gid_type event_gid );
+                           hpx::naming::gid_type event_gid,
+                           bool completed );
 
     ///////////////////////////////////////////////////////////////////////////
     // Zero-copy-Data Function
@@ -101,7 +104,8 @@ namespace hpx { namespace opencl { namespace lcos { namespace detail
         ~event_data()
         {
             HPX_ASSERT(device_id && event_id);
-            unregister_event( device_id, event_id.get_gid() );
+            unregister_event( device_id, event_id.get_gid(),
+                              this->is_ready() );
         }
 
         void init(hpx::naming::id_type && device_id_)
@@ -158,7 +162,10 @@ namespace hpx { namespace opencl { namespace lcos { namespace detail
         ~event_data()
         {
             HPX_ASSERT(device_id && event_id);
-            unregister_event( device_id, event_id.get_gid() );
+
+            // only armed events get completed by the device
+            unregister_event( device_id, event_id.get_gid(),
+                              !is_armed || this->is_ready() );
         }
 
         void init(hpx::naming::id_type && device_id_)
@@ -0,0 +1,122 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "profiling.hpp"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+
+
+// The timestamps of the events of this locality
+namespace {
+    struct timestamp_registry
+    {
+        timestamp_registry() : size(0) {}
+
+        hpx::lcos::local::spinlock lock;
+        std::map<hpx::naming::gid_type,
+                 hpx::opencl::command_timestamps> entries;
+
+        // Events that got destroyed before their timestamps arrived
+        std::set<hpx::naming::gid_type> released;
+
+        // Lets the event destructors skip the lock if nothing got profiled
+        std::atomic<std::size_t> size;
+    };
+
+    // Only profiling devices deliver timestamps. Uses the configuration
+    // of this locality, the devices use the one of theirs.
+    bool profiling_enabled()
+    {
+        static bool enabled =
+            (hpx::get_config_entry("hpx.opencl.profiling", "0") == "1");
+        return enabled;
+    }
+
+    timestamp_registry& get_timestamp_registry()
+    {
+        static timestamp_registry registry;
+        return registry;
+    }
+}
+
+void
+hpx::opencl::detail::store_timestamps(
+    hpx::naming::gid_type event_gid,
+    hpx::opencl::command_timestamps timestamps )
+{
+    timestamp_registry& registry = get_timestamp_registry();
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(registry.lock);
+
+    // nobody can ask for the timestamps of a destroyed event
+    if(registry.released.erase(event_gid) == 0)
+        registry.entries[event_gid] = timestamps;
+
+    registry.size.store(registry.entries.size() + registry.released.size(),
+                        std::memory_order_relaxed);
+}
+
+void
+hpx::opencl::detail::complete_profiled_event(
+    hpx::naming::id_type event_id,
+    hpx::opencl::command_timestamps timestamps )
+{
+    // the timestamps have to be there once the future is ready
+    store_timestamps(event_id.get_gid(), timestamps);
+    hpx::trigger_lco_event(event_id, false);
+}
+
+bool
+hpx::opencl::detail::find_timestamps(
+    const hpx::naming::gid_type & event_gid,
+    hpx::opencl::command_timestamps & timestamps )
+{
+    timestamp_registry& registry = get_timestamp_registry();
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(registry.lock);
+    auto it = registry.entries.find(event_gid);
+    if(it == registry.entries.end())
+        return false;
+
+    timestamps = it->second;
+    return true;
+}
+
+void
+hpx::opencl::detail::release_timestamps(
+    const hpx::naming::gid_type & event_gid, bool pending )
+{
+    timestamp_registry& registry = get_timestamp_registry();
+
+    // the timestamps of a pending event might still be on their way
+    pending = pending && profiling_enabled();
+
+    if(!pending && registry.size.load(std::memory_order_relaxed) == 0)
+        return;
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(registry.lock);
+    if(registry.entries.erase(event_gid) == 0 && pending)
+        registry.released.insert(event_gid);
+
+    registry.size.store(registry.entries.size() + registry.released.size(),
+                        std::memory_order_relaxed);
+}
+
+hpx::opencl::command_timestamps
+hpx::opencl::detail::get_timestamps( const hpx::naming::gid_type & event_gid )
+{
+    hpx::opencl::command_timestamps timestamps;
+    if(!find_timestamps(event_gid, timestamps))
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "hpx::opencl::get_timestamps()",
+                            "No timestamps available. "
+                            "Is hpx.opencl.profiling enabled?");
+
+    return timestamps;
+}
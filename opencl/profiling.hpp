@@ -0,0 +1,177 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_PROFILING_HPP_
+#define HPX_OPENCL_PROFILING_HPP_
+
+// Default includes
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+// Export definitions
+#include "export_definitions.hpp"
+
+// OpenCL
+#include "cl_headers.hpp"
+
+#include "lcos/event.hpp"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace hpx {
+namespace opencl {
+
+    //////////////////////////////////////
+    /// @brief The device timestamps of a command, in nanoseconds.
+    ///
+    /// The values are the CL_PROFILING_COMMAND_* infos of the command.
+    /// They use the clock of the device, only differences between them are
+    /// meaningful.
+    ///
+    struct command_timestamps
+    {
+        command_timestamps()
+          : queued(0), submitted(0), started(0), ended(0)
+        {}
+
+        /// The command got enqueued by the server
+        cl_ulong queued;
+
+        /// The command got submitted to the device
+        cl_ulong submitted;
+
+        /// The command started executing
+        cl_ulong started;
+
+        /// The command finished executing
+        cl_ulong ended;
+
+        template <typename Archive>
+        void serialize(Archive & ar, unsigned)
+        {
+            ar & queued & submitted & started & ended;
+        }
+    };
+
+    //////////////////////////////////////
+    /// @brief Statistics of all launches of the kernels with one name on
+    ///        a device.
+    ///
+    /// The times are in nanoseconds and only cover the profiled launches.
+    ///
+    struct kernel_profile
+    {
+        kernel_profile()
+          : launches(0), profiled_launches(0), total_time(0), min_time(0),
+            max_time(0), total_queue_delay(0)
+        {}
+
+        /// The name of the kernel function
+        std::string name;
+
+        /// All launches, profiled or not
+        std::uint64_t launches;
+
+        /// The launches that completed on a command queue with profiling
+        std::uint64_t profiled_launches;
+
+        /// The execution times, from start to end
+        std::uint64_t total_time;
+        std::uint64_t min_time;
+        std::uint64_t max_time;
+
+        /// The time the launches waited, from queued to start
+        std::uint64_t total_queue_delay;
+
+        template <typename Archive>
+        void serialize(Archive & ar, unsigned)
+        {
+            ar & name & launches & profiled_launches & total_time & min_time
+               & max_time & total_queue_delay;
+        }
+    };
+
+    namespace detail
+    {
+        // Stores the timestamps of an event of this locality.
+        // The device server calls it before completing the event.
+        HPX_OPENCL_EXPORT void
+        store_timestamps( hpx::naming::gid_type event_gid,
+                          hpx::opencl::command_timestamps timestamps );
+
+        // Stores the timestamps of an event of this locality and triggers
+        // it. Saves the device server the round trip of storing the
+        // timestamps before triggering.
+        HPX_OPENCL_EXPORT void
+        complete_profiled_event( hpx::naming::id_type event_id,
+                                 hpx::opencl::command_timestamps timestamps );
+
+        // Looks up the timestamps of an event of this locality
+        HPX_OPENCL_EXPORT bool
+        find_timestamps( const hpx::naming::gid_type & event_gid,
+                         hpx::opencl::command_timestamps & timestamps );
+
+        // Drops the timestamps of an event, called when the event gets
+        // destroyed. If the event did not complete, timestamps that
+        // arrive later get dropped as well.
+        HPX_OPENCL_EXPORT void
+        release_timestamps( const hpx::naming::gid_type & event_gid,
+                            bool pending );
+
+        HPX_OPENCL_EXPORT hpx::opencl::command_timestamps
+        get_timestamps( const hpx::naming::gid_type & event_gid );
+
+        HPX_DEFINE_PLAIN_ACTION(store_timestamps, store_timestamps_action);
+        HPX_DEFINE_PLAIN_ACTION(complete_profiled_event,
+                                complete_profiled_event_action);
+    }
+
+    /**
+     *  @brief Returns the device timestamps of a completed command.
+     *
+     *  Works on the futures returned by the enqueue functions of kernels
+     *  and buffers, once they are ready. The timestamps arrive together
+     *  with the completion, this call does not communicate.
+     *
+     *  Needs a device with profiling enabled, see the configuration entry
+     *  hpx.opencl.profiling.
+     *
+     *  @param fut      A ready future of an enqueue function
+     *  @return         The timestamps of the command
+     *  @throws         hpx::bad_parameter if the future is no completed
+     *                  command of a profiling device
+     */
+    template<typename Future>
+    command_timestamps
+    get_timestamps( const Future & fut )
+    {
+        typedef typename std::remove_reference<Future>::type::result_type
+            result_type;
+        typedef typename hpx::opencl::lcos::event<result_type>::shared_state_type
+            event_type;
+
+        auto shared_state = hpx::traits::detail::get_shared_state(fut);
+
+        auto ev = boost::dynamic_pointer_cast<event_type>(shared_state);
+        if(!ev || !fut.is_ready())
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "hpx::opencl::get_timestamps()",
+                                "The future is no completed OpenCL command!");
+
+        return detail::get_timestamps(ev->get_event_id().get_gid());
+    }
+
+}}
+
+HPX_REGISTER_ACTION_DECLARATION(hpx::opencl::detail::store_timestamps_action,
+                                hpx_opencl_detail_store_timestamps_action)
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::opencl::detail::complete_profiled_event_action,
+    hpx_opencl_detail_complete_profiled_event_action)
+
+#endif// HPX_OPENCL_PROFILING_HPP_
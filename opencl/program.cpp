@@ -8,6 +8,7 @@
 
 // Internal Dependencies
 #include "server/program.hpp"
+#include "util/tracer.hpp"
 
 #include "kernel.hpp"
 
@@ -46,6 +47,9 @@ program::build_async() const
 hpx::lcos::future<void>
 program::build_async(std::string build_options) const
 {
+    hpx::opencl::util::tracer::scope trace( "program::build",
+                                            "client" );
+
     HPX_ASSERT(this->get_id());
 
     typedef hpx::opencl::server::program::build_action func;
@@ -79,4 +83,54 @@ program::create_kernel(std::string kernel_name) const
 
 }
 
+hpx::future<hpx::naming::id_type>
+program::specialize_impl( const hpx::opencl::specialization& defines,
+                          std::string build_options ) const
+{
+    HPX_ASSERT(this->get_id());
+
+    typedef hpx::opencl::server::program::specialize_action func;
+
+    // the definitions are ordered, so equal sets result in equal options
+    std::string options = hpx::opencl::util::to_build_options(defines);
+    if(!build_options.empty())
+    {
+        if(!options.empty())
+            options += " ";
+        options += build_options;
+    }
+
+    return hpx::async<func>(this->get_id(), std::move(options));
+}
+
+hpx::opencl::program
+program::specialize( const hpx::opencl::specialization& defines,
+                     std::string build_options ) const
+{
+    hpx::shared_future<hpx::id_type> variant =
+        specialize_impl(defines, std::move(build_options));
+
+    ensure_device_id();
+    return program(variant, device_gid);
+}
+
+hpx::opencl::kernel
+program::specialize( std::string kernel_name,
+                     const hpx::opencl::specialization& defines,
+                     std::string build_options ) const
+{
+    hpx::future<hpx::id_type> variant =
+        specialize_impl(defines, std::move(build_options));
+
+    // create the kernel as soon as the variant is built
+    hpx::future<hpx::id_type> kernel_server = variant.then(
+        [kernel_name](hpx::future<hpx::id_type> && variant_id)
+        {
+            typedef hpx::opencl::server::program::create_kernel_action func;
+            return hpx::async<func>(variant_id.get(), kernel_name);
+        });
+
+    ensure_device_id();
+    return kernel(std::move(kernel_server), device_gid);
+}
 
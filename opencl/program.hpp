@@ -17,6 +17,9 @@
 // Forward Declarations
 #include "fwd_declarations.hpp"
 
+// Preprocessor definitions for program::specialize()
+#include "util/specialization.hpp"
+
 namespace hpx {
 namespace opencl {
 
@@ -111,9 +114,51 @@ namespace opencl {
             hpx::opencl::kernel
             create_kernel(std::string kernel_name) const;
 
+            /**
+             *  @brief Creates a variant of this program with preprocessor
+             *         definitions baked in, non-blocking.
+             *
+             *  The variant gets built from the same source with additional
+             *  '-D' options. Built variants are cached per source,
+             *  definitions and device, so specializing the same program
+             *  twice compiles only once.
+             *
+             *  Only works on programs created from source.
+             *
+             *  @param defines        The definitions, e.g.
+             *                        <tt>{{"K", 1024}, {"TILE", 16}}</tt>
+             *  @param build_options  Additional build options
+             *  @return               The built program variant.
+             */
+            hpx::opencl::program
+            specialize( const hpx::opencl::specialization& defines,
+                        std::string build_options = "" ) const;
+
+            /**
+             *  @brief Creates a kernel from a variant of this program with
+             *         preprocessor definitions baked in, non-blocking.
+             *
+             *  Equivalent to specialize(defines).create_kernel(kernel_name).
+             *
+             *  @param kernel_name    The name of the kernel to be created
+             *  @param defines        The definitions, e.g.
+             *                        <tt>{{"K", 1024}, {"TILE", 16}}</tt>
+             *  @param build_options  Additional build options
+             *  @return               A kernel object.
+             */
+            hpx::opencl::kernel
+            specialize( std::string kernel_name,
+                        const hpx::opencl::specialization& defines,
+                        std::string build_options = "" ) const;
+
         protected:
             void ensure_device_id() const;
 
+        private:
+            hpx::future<hpx::naming::id_type>
+            specialize_impl( const hpx::opencl::specialization& defines,
+                             std::string build_options ) const;
+
         private:
             mutable hpx::naming::id_type device_gid;
 
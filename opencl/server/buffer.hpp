@@ -11,6 +11,8 @@
 #include <hpx/hpx.hpp>
 #include <hpx/config.hpp>
 
+#include <cstdint>
+
 #include "../cl_headers.hpp"
 
 #include "../fwd_declarations.hpp"
@@ -61,6 +63,14 @@ namespace hpx { namespace opencl { namespace server {
                             hpx::serialization::serialize_buffer<T> data,
                             std::vector<hpx::naming::id_type> && dependencies );
 
+        // Writes to the buffer, without client event
+        template <typename T>
+        void enqueue_write_nowait(
+                            std::size_t offset,
+                            hpx::serialization::serialize_buffer<T> data,
+                            std::vector<hpx::naming::id_type> && dependencies,
+                            std::uint32_t source_locality );
+
         // Writes to the buffer
         template <typename T>
         void enqueue_write_rect(
@@ -119,6 +129,18 @@ namespace hpx { namespace opencl { namespace server {
                            std::vector<hpx::naming::gid_type> &&
                                 dependency_devices );
 
+        // Copies data from this buffer to a remote buffer, without client
+        // events
+        void enqueue_send_nowait(
+                           hpx::naming::id_type dst,
+                           std::size_t src_offset,
+                           std::size_t dst_offset,
+                           std::size_t size,
+                           std::vector<hpx::naming::id_type> && dependencies,
+                           std::vector<hpx::naming::gid_type> &&
+                                dependency_devices,
+                           std::uint32_t source_locality );
+
         // Copies data from this buffer to a remote buffer
         void enqueue_send_rect(
                            hpx::naming::id_type dst,
@@ -172,6 +194,7 @@ namespace hpx { namespace opencl { namespace server {
     HPX_DEFINE_COMPONENT_ACTION(buffer, enqueue_read);
     HPX_DEFINE_COMPONENT_ACTION(buffer, enqueue_send);
     HPX_DEFINE_COMPONENT_ACTION(buffer, enqueue_send_rect);
+    HPX_DEFINE_COMPONENT_ACTION(buffer, enqueue_send_nowait);
 
     // Actions with template arguments (see enqueue_write<>() above) require
     // special type definitions. The simplest way to define such an action type
@@ -186,6 +209,16 @@ namespace hpx { namespace opencl { namespace server {
             &buffer::template enqueue_write<T>, enqueue_write_action<T> >
     {};
     template <typename T>
+    struct enqueue_write_nowait_action
+      : hpx::actions::make_action<void (buffer::*)(
+                        std::size_t,
+                        hpx::serialization::serialize_buffer<T>,
+                        std::vector<hpx::naming::id_type> &&,
+                        std::uint32_t),
+            &buffer::template enqueue_write_nowait<T>,
+            enqueue_write_nowait_action<T> >
+    {};
+    template <typename T>
     struct enqueue_write_rect_action
       : hpx::actions::make_action<void (buffer::*)(
                         hpx::naming::id_type &&,
@@ -245,6 +278,9 @@ namespace hpx { namespace opencl { namespace server {
         cl_mem device_mem;
         hpx::naming::id_type parent_device_id;
 
+        // the size of device_mem, for the device statistics
+        std::size_t allocated_size;
+
     };
 
 }}}
@@ -257,7 +293,9 @@ HPX_OPENCL_REGISTER_ACTION_DECLARATION(buffer, size);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(buffer, enqueue_read);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(buffer, enqueue_send);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(buffer, enqueue_send_rect);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(buffer, enqueue_send_nowait);
 HPX_OPENCL_TEMPLATE_ACTION_USES_MEDIUM_STACK(buffer, enqueue_write);
+HPX_OPENCL_TEMPLATE_ACTION_USES_MEDIUM_STACK(buffer, enqueue_write_nowait);
 HPX_OPENCL_TEMPLATE_ACTION_USES_MEDIUM_STACK(buffer, enqueue_write_rect);
 HPX_OPENCL_TEMPLATE_ACTION_USES_MEDIUM_STACK(buffer,
                                             enqueue_read_to_userbuffer_local);
@@ -279,6 +317,7 @@ HPX_OPENCL_TEMPLATE_ACTION_USES_MEDIUM_STACK(buffer,
 
 // other hpxcl dependencies
 #include "util/event_dependencies.hpp"
+#include "../util/tracer.hpp"
 #include "device.hpp"
 
 
@@ -291,6 +330,9 @@ hpx::opencl::server::buffer::enqueue_write(
                        std::vector<hpx::naming::id_type> && dependencies ){
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_write",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( event_gid.get_gid() );
 
     cl_int err;
     cl_event return_event;
@@ -308,6 +350,12 @@ hpx::opencl::server::buffer::enqueue_write(
                                 events.get_cl_events(), &return_event );
     cl_ensure(err, "clEnqueueWriteBuffer()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_write, return_event,
+        data.size() * sizeof(T),
+        event_gid.get_gid() );
+
     // register the data to prevent deallocation
     parent_device->put_event_data(return_event, data);
 
@@ -317,6 +365,56 @@ hpx::opencl::server::buffer::enqueue_write(
 }
 
 
+template <typename T>
+void
+hpx::opencl::server::buffer::enqueue_write_nowait(
+                       std::size_t offset,
+                       hpx::serialization::serialize_buffer<T> data,
+                       std::vector<hpx::naming::id_type> && dependencies,
+                       std::uint32_t source_locality ){
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_write_nowait",
+                                            "server" );
+
+    cl_int err;
+    cl_event return_event;
+
+    // errors get reported on the next device::finish_async()
+    try {
+
+        // retrieve the dependency cl_events
+        util::event_dependencies events( dependencies, parent_device.get() );
+
+        // retrieve the command queue
+        cl_command_queue command_queue = parent_device->get_write_command_queue();
+
+        // run the OpenCL-call
+        err = clEnqueueWriteBuffer( command_queue, device_mem, CL_FALSE, offset,
+                                    data.size()*sizeof(T), data.data(),
+                                    static_cast<cl_uint>(events.size()),
+                                    events.get_cl_events(), &return_event );
+        cl_ensure(err, "clEnqueueWriteBuffer()");
+
+        // count the command
+        parent_device->get_statistics().command_enqueued(
+            util::device_statistics::command_write, return_event,
+            data.size() * sizeof(T) );
+
+    } catch (...) {
+        parent_device->nowait_submitted( source_locality,
+                                         std::current_exception() );
+        return;
+    }
+
+    // keep the data alive until the device finishes
+    parent_device->put_nowait_data(return_event, data);
+
+    parent_device->nowait_submitted( source_locality );
+
+}
+
+
 template <typename T>
 void
 hpx::opencl::server::buffer::enqueue_write_rect(
@@ -326,6 +424,9 @@ hpx::opencl::server::buffer::enqueue_write_rect(
                        std::vector<hpx::naming::id_type> && dependencies ){
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_write_rect",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( event_gid.get_gid() );
 
     cl_int err;
     cl_event return_event;
@@ -366,6 +467,13 @@ hpx::opencl::server::buffer::enqueue_write_rect(
                                     events.get_cl_events(), &return_event );
     cl_ensure(err, "clEnqueueWriteBufferRect()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_write, return_event,
+        rect_properties.size_x * rect_properties.size_y
+            * rect_properties.size_z * sizeof(T),
+        event_gid.get_gid() );
+
     // register the data to prevent deallocation
     parent_device->put_event_data(return_event, data);
 
@@ -384,6 +492,9 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_local(
                        std::vector<hpx::naming::id_type> && dependencies ){
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_read_to_userbuffer_local",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( event_gid.get_gid() );
 
     cl_int err;
     cl_event return_event;
@@ -401,6 +512,12 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_local(
                                 events.get_cl_events(), &return_event );
     cl_ensure(err, "clEnqueueReadBuffer()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_read, return_event,
+        data.size() * sizeof(T),
+        event_gid.get_gid() );
+
     // register the data to prevent deallocation
     parent_device->put_event_data(return_event, data);
 
@@ -422,6 +539,9 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_remote(
     std::vector<hpx::naming::id_type> && dependencies ){
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_read_to_userbuffer_remote",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( event_gid.get_gid() );
 
     typedef hpx::serialization::serialize_buffer<char> buffer_type;
 
@@ -444,6 +564,12 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_remote(
                                 events.get_cl_events(), &return_event );
     cl_ensure(err, "clEnqueueReadBuffer()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_read, return_event,
+        data.size(),
+        event_gid.get_gid() );
+
     // put_event_data not necessary as we locally keep the buffer alive until
     // the event triggered
 
@@ -467,7 +593,12 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_remote(
 //         set_data_func;
 //     hpx::apply_colocated<set_data_func>(event_gid, event_gid, zerocopy_buffer);
 
-    hpx::set_lco_value(event_gid, std::move(zerocopy_buffer));
+    hpx::naming::id_type event_id = std::move(event_gid);
+    parent_device->send_data_after_timestamps(event_id, return_event,
+        [event_id, zerocopy_buffer]()
+        {
+            hpx::set_lco_value(event_id, zerocopy_buffer);
+        });
 }
 
 template <typename T>
@@ -479,6 +610,9 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_rect_local(
                        std::vector<hpx::naming::id_type> && dependencies ){
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_read_to_userbuffer_rect_local",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( event_gid.get_gid() );
 
     cl_int err;
     cl_event return_event;
@@ -520,6 +654,13 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_rect_local(
                 events.get_cl_events(), &return_event );
     cl_ensure(err, "clEnqueueReadBufferRect()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_read, return_event,
+        rect_properties.size_x * rect_properties.size_y
+            * rect_properties.size_z * sizeof(T),
+        event_gid.get_gid() );
+
     // register the data to prevent deallocation
     parent_device->put_event_data(return_event, data);
 
@@ -546,6 +687,9 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_rect_remote(
     //   remote destination buffer via zero-copy send
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_read_to_userbuffer_rect_remote",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( event_gid.get_gid() );
 
     typedef hpx::serialization::serialize_buffer<char> buffer_type;
 
@@ -585,6 +729,12 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_rect_remote(
                 events.get_cl_events(), &return_event );
     cl_ensure(err, "clEnqueueReadBufferRect()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_read, return_event,
+        dst_size,
+        event_gid.get_gid() );
+
     // put_event_data not necessary as we locally keep the buffer alive until
     // the event triggered
 
@@ -610,7 +760,12 @@ hpx::opencl::server::buffer::enqueue_read_to_userbuffer_rect_remote(
 //         set_data_func;
 //     hpx::apply_colocated<set_data_func>(event_gid, event_gid, zerocopy_buffer);
 
-    hpx::set_lco_value(event_gid, std::move(zerocopy_buffer));
+    hpx::naming::id_type event_id = std::move(event_gid);
+    parent_device->send_data_after_timestamps(event_id, return_event,
+        [event_id, zerocopy_buffer]()
+        {
+            hpx::set_lco_value(event_id, zerocopy_buffer);
+        });
 }
 
 
@@ -12,6 +12,7 @@
 // other hpxcl dependencies
 #include "device.hpp"
 #include "util/event_dependencies.hpp"
+#include "../util/tracer.hpp"
 
 // HPX dependencies
 #include <hpx/include/thread_executors.hpp>
@@ -23,6 +24,7 @@ using namespace hpx::opencl::server;
 
 // Constructor
 buffer::buffer()
+  : allocated_size(0)
 {}
 
 // External destructor.
@@ -54,6 +56,12 @@ buffer::~buffer()
     // run destructor in a thread, as we need it to run on a large stack size
     hpx::threads::async_execute(exec,&buffer_cleanup, reinterpret_cast<uintptr_t>(device_mem));
 
+    // count the released device memory
+    if(allocated_size > 0)
+        util::device_statistics::add(
+            parent_device->get_statistics().buffer_bytes,
+            -static_cast<std::int64_t>(allocated_size) );
+
 
 
 }
@@ -91,6 +99,11 @@ buffer::init( hpx::naming::id_type device_id, cl_mem_flags flags,
     device_mem = clCreateBuffer(context, modified_flags, size, NULL, &err);
     cl_ensure(err, "clCreateBuffer()");
 
+    // count the allocated device memory
+    allocated_size = size;
+    util::device_statistics::add( parent_device->get_statistics().buffer_bytes,
+                                  static_cast<std::int64_t>(allocated_size) );
+
 }
 
 // Get Buffer Size
@@ -119,6 +132,9 @@ buffer::enqueue_read( hpx::naming::id_type && event_gid,
                       std::vector<hpx::naming::id_type> && dependencies ){
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_read",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( event_gid.get_gid() );
 
     typedef hpx::serialization::serialize_buffer<char> buffer_type;
 
@@ -141,6 +157,11 @@ buffer::enqueue_read( hpx::naming::id_type && event_gid,
                                 events.get_cl_events(), &return_event );
     cl_ensure(err, "clEnqueueReadBuffer()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_read, return_event, data.size(),
+        event_gid.get_gid() );
+
     // register the data to prevent deallocation
     parent_device->put_event_data(return_event, data);
 
@@ -190,6 +211,11 @@ buffer::send_bruteforce( hpx::naming::id_type && dst,
                                 events.get_cl_events(), &src_event );
     cl_ensure(err, "clEnqueueReadBuffer()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_send, src_event, size,
+        src_event_gid.get_gid() );
+
     // register the cl_event to the client event
     parent_device->register_event(src_event_gid, src_event);
 
@@ -250,6 +276,11 @@ buffer::send_direct( hpx::naming::id_type && dst,
                                events_ptr, &return_event );
     cl_ensure(err, "clEnqueueCopyBuffer()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_send, return_event, size,
+        src_event_gid.get_gid() );
+
     // retain event to enable double-registration
     err = clRetainEvent( return_event );
     cl_ensure(err, "clRetainEvent()");
@@ -313,6 +344,11 @@ buffer::send_rect_bruteforce( hpx::naming::id_type && dst,
                 events.get_cl_events(), &src_event );
     cl_ensure(err, "clEnqueueReadBufferRect()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_send, src_event, dst_size,
+        src_event_gid.get_gid() );
+
     // register the cl_event to the client event
     parent_device->register_event(src_event_gid, src_event);
 
@@ -404,6 +440,13 @@ buffer::send_rect_direct( hpx::naming::id_type && dst,
                                    events_ptr, &return_event );
     cl_ensure(err, "clEnqueueCopyBufferRect()");
 
+    // count the command
+    parent_device->get_statistics().command_enqueued(
+        util::device_statistics::command_send, return_event,
+        rect_properties.size_x * rect_properties.size_y
+            * rect_properties.size_z,
+        src_event_gid.get_gid() );
+
     // retain event to enable double-registration
     err = clRetainEvent( return_event );
     cl_ensure(err, "clRetainEvent()");
@@ -425,9 +468,9 @@ buffer::enqueue_send_rect( hpx::naming::id_type dst,
 {
 
     HPX_ASSERT(dependencies.size() == dependency_devices.size());
-
-    // query the location of the destination
-    auto dst_location_future = hpx::get_colocation_id(dst);
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_send_rect",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( src_event.get_gid() );
 
     // split between src_dependencies and dst_dependencies
     std::vector<hpx::naming::id_type> src_dependencies;
@@ -444,7 +487,8 @@ buffer::enqueue_send_rect( hpx::naming::id_type dst,
     }
 
     // get the location of the destination
-    hpx::naming::id_type dst_location = dst_location_future.get();
+    hpx::naming::id_type dst_location =
+        hpx::opencl::tools::get_locality_of(dst);
     hpx::naming::id_type src_location = hpx::find_here();
 
     // choose which function to run
@@ -489,9 +533,9 @@ buffer::enqueue_send( hpx::naming::id_type dst,
 {
 
     HPX_ASSERT(dependencies.size() == dependency_devices.size());
-
-    // query the location of the destination
-    auto dst_location_future = hpx::get_colocation_id(dst);
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_send",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( src_event.get_gid() );
 
     // split between src_dependencies and dst_dependencies
     std::vector<hpx::naming::id_type> src_dependencies;
@@ -508,7 +552,8 @@ buffer::enqueue_send( hpx::naming::id_type dst,
     }
 
     // get the location of the destination
-    hpx::naming::id_type dst_location = dst_location_future.get();
+    hpx::naming::id_type dst_location =
+        hpx::opencl::tools::get_locality_of(dst);
     hpx::naming::id_type src_location = hpx::find_here();
 
     // choose which function to run
@@ -545,6 +590,139 @@ buffer::enqueue_send( hpx::naming::id_type dst,
 
 }
 
+void
+buffer::enqueue_send_nowait( hpx::naming::id_type dst,
+                             std::size_t src_offset,
+                             std::size_t dst_offset,
+                             std::size_t size,
+                             std::vector<hpx::naming::id_type> && dependencies,
+                             std::vector<hpx::naming::gid_type> &&
+                                dependency_devices,
+                             std::uint32_t source_locality )
+{
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "buffer::enqueue_send_nowait",
+                                            "server" );
+    HPX_ASSERT(dependencies.size() == dependency_devices.size());
+
+    // errors get reported on the next device::finish_async()
+    try {
+
+        // split between src_dependencies and dst_dependencies
+        std::vector<hpx::naming::id_type> src_dependencies;
+        std::vector<hpx::naming::id_type> dst_dependencies;
+        hpx::naming::gid_type src_device = parent_device_id.get_gid();
+        std::vector<hpx::naming::id_type>::iterator it = dependencies.begin();
+        for(const auto& device : dependency_devices){
+            if(device == src_device){
+                std::move(it, it+1, std::back_inserter(src_dependencies));
+            } else {
+                std::move(it, it+1, std::back_inserter(dst_dependencies));
+            }
+            it++;
+        }
+
+        // get the location of the destination
+        hpx::naming::id_type dst_location =
+            hpx::opencl::tools::get_locality_of(dst);
+        hpx::naming::id_type src_location = hpx::find_here();
+
+        cl_int err;
+
+        // optimization for context internal copies
+        if(dst_location == src_location){
+            auto dst_buffer =
+                hpx::get_ptr<hpx::opencl::server::buffer>(dst).get();
+
+            cl_context src_context = this->parent_device->get_context();
+            cl_context dst_context = dst_buffer->parent_device->get_context();
+
+            if(src_context == dst_context){
+
+                // gather all dependencies from both devices
+                std::vector<cl_event> events;
+                for(const auto& id : src_dependencies){
+                    events.push_back( parent_device->retrieve_event(id) );
+                }
+                for(const auto& id : dst_dependencies){
+                    events.push_back(
+                        dst_buffer->parent_device->retrieve_event(id) );
+                }
+
+                // Create a pointer that is either a pointer to the data or NULL
+                cl_event* events_ptr = NULL;
+                if(!events.empty()){
+                    events_ptr = events.data();
+                }
+
+                // run the OpenCL-call
+                err = clEnqueueCopyBuffer(
+                               parent_device->get_write_command_queue(),
+                               device_mem, dst_buffer->device_mem,
+                               src_offset, dst_offset, size,
+                               static_cast<cl_uint>(events.size()),
+                               events_ptr, NULL );
+                cl_ensure(err, "clEnqueueCopyBuffer()");
+
+                // count the command
+                parent_device->get_statistics().command_enqueued(
+                    util::device_statistics::command_send, NULL, size );
+
+                parent_device->nowait_submitted( source_locality );
+                return;
+            }
+        }
+
+        // Always works: read the data, then forward it to the destination
+        typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+        cl_event src_event;
+
+        // retrieve the dependency cl_events
+        util::event_dependencies events( src_dependencies, parent_device.get() );
+
+        // create new target buffer
+        buffer_type data( size );
+
+        // run the OpenCL-call
+        err = clEnqueueReadBuffer( parent_device->get_read_command_queue(),
+                                   device_mem, CL_FALSE, src_offset,
+                                   data.size(), data.data(),
+                                   static_cast<cl_uint>(events.size()),
+                                   events.get_cl_events(), &src_event );
+        cl_ensure(err, "clEnqueueReadBuffer()");
+
+        // count the command
+        parent_device->get_statistics().command_enqueued(
+            util::device_statistics::command_send, src_event, size );
+
+        // wait for clEnqueueReadBuffer to finish
+        parent_device->wait_for_cl_event(src_event);
+        err = clReleaseEvent(src_event);
+        cl_ensure(err, "clReleaseEvent()");
+
+        // the destination does not count this command, this device waits
+        // for it on finish instead
+        typedef hpx::opencl::server::buffer::enqueue_write_nowait_action<char>
+            func;
+        parent_device->put_nowait_forward(
+            hpx::async<func>( std::move(dst),
+                              dst_offset,
+                              data,
+                              std::move(dst_dependencies),
+                              hpx::naming::invalid_locality_id ) );
+
+    } catch (...) {
+        parent_device->nowait_submitted( source_locality,
+                                         std::current_exception() );
+        return;
+    }
+
+    parent_device->nowait_submitted( source_locality );
+
+}
+
 cl_mem
 buffer::get_cl_mem()
 {
@@ -0,0 +1,115 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_COMMAND_GRAPH_HPP
+#define HPX_OPENCL_SERVER_COMMAND_GRAPH_HPP
+
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../cl_headers.hpp"
+
+#include "../fwd_declarations.hpp"
+
+#include "../util/graph_description.hpp"
+
+#include <vector>
+
+// REGISTER_ACTION_DECLARATION templates
+#include "util/server_definitions.hpp"
+
+namespace hpx { namespace opencl{ namespace server{
+
+    // /////////////////////////////////////////////////////
+    //  This class represents a recorded chain of enqueue calls.
+
+    class HPX_OPENCL_EXPORT command_graph
+      : public hpx::components::managed_component_base<command_graph>
+    {
+        typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+    public:
+
+        // Constructor
+        command_graph();
+        // Destructor
+        ~command_graph();
+
+        ///////////////////////////////////////////////////
+        /// Local functions
+        ///
+        void init( hpx::naming::id_type device_id,
+                   std::vector<hpx::opencl::util::graph_node> nodes );
+
+        //////////////////////////////////////////////////
+        /// Exposed functionality of this component
+        ///
+
+        // Submits all recorded commands and waits for their completion.
+        // Returns the data of all read nodes.
+        std::vector<buffer_type>
+        replay( hpx::opencl::graph_arguments args,
+                std::vector<hpx::naming::id_type> && dependencies );
+
+        HPX_DEFINE_COMPONENT_ACTION(command_graph, replay);
+
+        //////////////////////////////////////////////////
+        // Private Member Functions
+        //
+    private:
+
+        typedef hpx::opencl::graph_arguments::scalar_argument
+            scalar_argument;
+
+        // Enqueues a single node
+        cl_event enqueue_node( std::size_t index,
+                               const buffer_type& write_data,
+                               const std::vector<scalar_argument>& scalars,
+                               buffer_type& read_data,
+                               std::vector<cl_event>& wait_list );
+
+        //////////////////////////////////////////////////
+        //  Private Member Variables
+        //
+    private:
+        // a recorded node, with the OpenCL objects already resolved
+        struct resolved_node
+        {
+            hpx::opencl::util::graph_node description;
+
+            // keep the components alive
+            std::shared_ptr<buffer> buffer_server;
+            std::shared_ptr<buffer> copy_dst_server;
+            std::shared_ptr<kernel> kernel_server;
+
+            cl_mem mem;
+            cl_mem copy_dst_mem;
+            // the node's own cl_kernel, so that the scalar arguments of
+            // one node don't leak into other nodes or launches of the kernel
+            cl_kernel kernel_id;
+        };
+
+        std::shared_ptr<device> parent_device;
+        hpx::naming::id_type parent_device_id;
+        std::vector<resolved_node> nodes;
+
+        // serializes replays. replays are not allowed to overlap on the
+        // device, as they use the same buffers.
+        hpx::lcos::local::mutex replay_lock;
+
+        // the events of the previous replay, to chain the next one to it
+        std::vector<cl_event> previous_events;
+
+    };
+
+}}}
+
+//[opencl_management_registration_declarations
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(command_graph, replay);
+//]
+
+#endif
@@ -0,0 +1,411 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "command_graph.hpp"
+
+// HPXCL tools
+#include "../tools.hpp"
+
+// other hpxcl dependencies
+#include "device.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "util/event_dependencies.hpp"
+
+// HPX dependencies
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/parallel/executors/service_executors.hpp>
+
+#include <algorithm>
+
+
+using hpx::opencl::server::command_graph;
+using hpx::opencl::util::graph_node;
+
+
+// Constructor
+command_graph::command_graph()
+{}
+
+// External destructor.
+// This is needed because OpenCL calls only run properly on large stack size.
+static void command_graph_cleanup(std::vector<cl_event> events,
+                                  std::vector<cl_kernel> kernels)
+{
+    cl_int err;
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    // Release the events of the last replay
+    for(cl_event event : events)
+    {
+        err = clReleaseEvent(event);
+        cl_ensure_nothrow(err, "clReleaseEvent()");
+    }
+
+    // Release the kernels of the nodes
+    for(cl_kernel kernel_id : kernels)
+    {
+        err = clReleaseKernel(kernel_id);
+        cl_ensure_nothrow(err, "clReleaseKernel()");
+    }
+}
+
+// Destructor
+command_graph::~command_graph()
+{
+
+    hpx::threads::executors::default_executor exec(
+                                          hpx::threads::thread_priority_normal,
+                                          hpx::threads::thread_stacksize_medium);
+
+    std::vector<cl_kernel> kernels;
+    for(const auto & node : nodes)
+    {
+        if(node.kernel_id)
+            kernels.push_back(node.kernel_id);
+    }
+
+    // run dectructor in a thread, as we need it to run on a large stack size
+    hpx::threads::async_execute( exec, &command_graph_cleanup,
+                                 std::move(previous_events),
+                                 std::move(kernels) ).wait();
+
+}
+
+void
+command_graph::init( hpx::naming::id_type device_id,
+                     std::vector<hpx::opencl::util::graph_node> descriptions )
+{
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    this->parent_device_id = std::move(device_id);
+    this->parent_device = hpx::get_ptr
+                          <hpx::opencl::server::device>(parent_device_id).get();
+
+    nodes.reserve(descriptions.size());
+    for(std::size_t i = 0; i < descriptions.size(); i++)
+    {
+        resolved_node node;
+        node.description = std::move(descriptions[i]);
+        node.mem = NULL;
+        node.copy_dst_mem = NULL;
+        node.kernel_id = NULL;
+
+        const graph_node& description = node.description;
+
+        // Only earlier nodes are allowed as dependencies, this keeps the
+        // graph free of cycles
+        for(std::size_t dependency : description.dependencies)
+        {
+            if(dependency >= i)
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                    "command_graph::init()",
+                                    "Nodes can only depend on earlier nodes!");
+        }
+
+        // Resolve the components to OpenCL objects
+        bool same_device = true;
+        switch(description.type)
+        {
+            case graph_node::copy_node:
+                node.copy_dst_server = hpx::get_ptr<buffer>
+                                            (description.copy_dst).get();
+                node.copy_dst_mem = node.copy_dst_server->get_cl_mem();
+                same_device = same_device &&
+                    node.copy_dst_server->get_parent_device_id()
+                        == parent_device_id;
+                // fall through
+            case graph_node::write_node:
+            case graph_node::read_node:
+                node.buffer_server = hpx::get_ptr<buffer>
+                                            (description.target).get();
+                node.mem = node.buffer_server->get_cl_mem();
+                same_device = same_device &&
+                    node.buffer_server->get_parent_device_id()
+                        == parent_device_id;
+                break;
+
+            case graph_node::kernel_node:
+            {
+                node.kernel_server = hpx::get_ptr<kernel>
+                                            (description.target).get();
+                same_device = node.kernel_server->get_parent_device_id()
+                                == parent_device_id;
+                if(same_device)
+                    node.kernel_id = node.kernel_server->create_cl_kernel();
+
+                // Resolve local_size_auto once, at creation
+                std::vector<std::size_t>& work_size = node.description.work_size;
+                HPX_ASSERT( work_size.size() % 3 == 0 );
+                std::size_t dim = work_size.size() / 3;
+                if(dim > 0 && work_size[2 * dim] == hpx::opencl::local_size_auto)
+                {
+                    std::vector<std::size_t> global_size(
+                        work_size.begin() + 1 * dim, work_size.begin() + 2 * dim );
+                    std::vector<std::size_t> local_size;
+                    if(!node.kernel_server->lookup_tuned_local_size(
+                                                    global_size, local_size) ||
+                       local_size.size() != dim)
+                        local_size.assign(dim, 0);
+                    std::copy( local_size.begin(), local_size.end(),
+                               work_size.begin() + 2 * dim );
+                }
+                break;
+            }
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "command_graph::init()",
+                                    "Unknown node type!");
+        }
+
+        if(!same_device)
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "command_graph::init()",
+                                "All buffers and kernels of a command graph "
+                                "need to belong to its device!");
+
+        nodes.push_back(std::move(node));
+    }
+
+}
+
+cl_event
+command_graph::enqueue_node( std::size_t index,
+                             const buffer_type& write_data,
+                             const std::vector<scalar_argument>& scalars,
+                             buffer_type& read_data,
+                             std::vector<cl_event>& wait_list )
+{
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+    cl_event return_event;
+
+    const resolved_node& node = nodes[index];
+    const graph_node& description = node.description;
+
+    // Create a pointer that is either a pointer to the data or NULL
+    cl_event* wait_list_ptr = NULL;
+    if(!wait_list.empty()){
+        wait_list_ptr = wait_list.data();
+    }
+    cl_uint wait_list_size = static_cast<cl_uint>(wait_list.size());
+
+    switch(description.type)
+    {
+        case graph_node::write_node:
+        {
+            // use the recorded data, if not replaced for this replay
+            const buffer_type& data =
+                write_data.size() > 0 ? write_data : description.data;
+            err = clEnqueueWriteBuffer( parent_device->get_write_command_queue(),
+                                        node.mem, CL_FALSE,
+                                        description.offset, data.size(),
+                                        data.data(),
+                                        wait_list_size, wait_list_ptr,
+                                        &return_event );
+            cl_ensure(err, "clEnqueueWriteBuffer()");
+            parent_device->get_statistics().command_enqueued(
+                util::device_statistics::command_write, return_event,
+                data.size() );
+            break;
+        }
+
+        case graph_node::read_node:
+            read_data = buffer_type(description.size);
+            err = clEnqueueReadBuffer( parent_device->get_read_command_queue(),
+                                       node.mem, CL_FALSE,
+                                       description.offset, read_data.size(),
+                                       read_data.data(),
+                                       wait_list_size, wait_list_ptr,
+                                       &return_event );
+            cl_ensure(err, "clEnqueueReadBuffer()");
+            parent_device->get_statistics().command_enqueued(
+                util::device_statistics::command_read, return_event,
+                read_data.size() );
+            break;
+
+        case graph_node::copy_node:
+            err = clEnqueueCopyBuffer( parent_device->get_write_command_queue(),
+                                       node.mem, node.copy_dst_mem,
+                                       description.offset,
+                                       description.dst_offset,
+                                       description.size,
+                                       wait_list_size, wait_list_ptr,
+                                       &return_event );
+            cl_ensure(err, "clEnqueueCopyBuffer()");
+            parent_device->get_statistics().command_enqueued(
+                util::device_statistics::command_send, return_event,
+                description.size );
+            break;
+
+        case graph_node::kernel_node:
+        {
+            // prepare args for OpenCL call
+            const std::vector<std::size_t>& work_size = description.work_size;
+            std::size_t dim = work_size.size() / 3;
+            const std::size_t* global_work_offset = work_size.data() + 0 * dim;
+            const std::size_t* global_work_size   = work_size.data() + 1 * dim;
+            const std::size_t* local_work_size    = work_size.data() + 2 * dim;
+
+            // If local_work_size is not specified, let the OpenCL driver decide
+            if(local_work_size[0] == 0){
+                local_work_size = NULL;
+            }
+
+            // the buffer arguments of the kernel at the time of the replay,
+            // and the scalar arguments of this node
+            std::lock_guard<hpx::lcos::local::mutex> lock(
+                node.kernel_server->get_arg_lock());
+
+            node.kernel_server->copy_buffer_args(node.kernel_id);
+            for(const auto & scalar : scalars)
+            {
+                err = clSetKernelArg( node.kernel_id,
+                                      scalar.arg_index,
+                                      scalar.value.size(),
+                                      scalar.value.data() );
+                cl_ensure(err, "clSetKernelArg()");
+            }
+
+            err = clEnqueueNDRangeKernel( parent_device->get_kernel_command_queue(),
+                                          node.kernel_id,
+                                          static_cast<cl_uint>(dim),
+                                          global_work_offset,
+                                          global_work_size,
+                                          local_work_size,
+                                          wait_list_size, wait_list_ptr,
+                                          &return_event );
+            cl_ensure(err, "clEnqueueNDRangeKernel()");
+            parent_device->get_statistics().kernel_enqueued(
+                return_event, node.kernel_server->get_statistics() );
+            break;
+        }
+
+        default:
+            HPX_ASSERT(false);
+            return_event = NULL;
+    }
+
+    return return_event;
+
+}
+
+std::vector<hpx::serialization::serialize_buffer<char> >
+command_graph::replay( hpx::opencl::graph_arguments args,
+                       std::vector<hpx::naming::id_type> && dependencies )
+{
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+
+    // sort the per-replay write data by node
+    std::vector<buffer_type> write_data(nodes.size());
+    for(auto & write : args.writes)
+    {
+        if(write.node >= nodes.size() ||
+           nodes[write.node].description.type != graph_node::write_node)
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "command_graph::replay()",
+                                "Write data does not refer to a write node!");
+        if(write.data.size() != nodes[write.node].description.size)
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "command_graph::replay()",
+                                "Write data does not match the recorded size!");
+        write_data[write.node] = write.data;
+    }
+    // sort the scalar arguments by node
+    std::vector<std::vector<scalar_argument> > scalars(nodes.size());
+    for(auto & scalar : args.scalars)
+    {
+        if(scalar.node >= nodes.size() ||
+           nodes[scalar.node].description.type != graph_node::kernel_node)
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "command_graph::replay()",
+                                "Scalar argument does not refer to a kernel "
+                                "node!");
+        scalars[scalar.node].push_back(std::move(scalar));
+    }
+
+    std::vector<buffer_type> read_data(nodes.size());
+    std::vector<cl_event> events;
+    events.reserve(nodes.size());
+
+    {
+        std::lock_guard<hpx::lcos::local::mutex> lock(replay_lock);
+
+        // retrieve the dependency cl_events
+        util::event_dependencies external_events( dependencies,
+                                                  parent_device.get() );
+
+        // nodes without dependencies wait for the external dependencies
+        // and for the previous replay
+        std::vector<cl_event> root_wait_list( previous_events );
+        root_wait_list.insert( root_wait_list.end(),
+                               external_events.get_cl_events(),
+                               external_events.get_cl_events()
+                                    + external_events.size() );
+
+        // enqueue all nodes, connected through their events
+        std::vector<cl_event> wait_list;
+        for(std::size_t i = 0; i < nodes.size(); i++)
+        {
+            const std::vector<std::size_t>& node_dependencies =
+                nodes[i].description.dependencies;
+
+            if(node_dependencies.empty()){
+                wait_list = root_wait_list;
+            } else {
+                wait_list.clear();
+                for(std::size_t dependency : node_dependencies)
+                    wait_list.push_back(events[dependency]);
+            }
+
+            events.push_back( enqueue_node( i, write_data[i], scalars[i],
+                                            read_data[i], wait_list ) );
+        }
+
+        // submit everything at once
+        err = clFlush(parent_device->get_kernel_command_queue());
+        cl_ensure(err, "clFlush()");
+
+        // chain the next replay to this one
+        for(cl_event event : previous_events)
+        {
+            err = clReleaseEvent(event);
+            cl_ensure(err, "clReleaseEvent()");
+        }
+        previous_events = events;
+        for(cl_event event : previous_events)
+        {
+            err = clRetainEvent(event);
+            cl_ensure(err, "clRetainEvent()");
+        }
+    }
+
+    // wait for completion. this happens outside of the lock, so the next
+    // replay can already be submitted.
+    for(cl_event event : events)
+    {
+        parent_device->wait_for_cl_event(event);
+    }
+    for(cl_event event : events)
+    {
+        err = clReleaseEvent(event);
+        cl_ensure(err, "clReleaseEvent()");
+    }
+
+    // collect the results of the read nodes
+    std::vector<buffer_type> results;
+    for(std::size_t i = 0; i < nodes.size(); i++)
+    {
+        if(nodes[i].description.type == graph_node::read_node)
+            results.push_back(std::move(read_data[i]));
+    }
+
+    return results;
+
+}
@@ -14,6 +14,7 @@
 
 #include "../fwd_declarations.hpp"
 #include "../device.hpp"
+#include "../create_devices.hpp"
 
 ////////////////////////////////////////////////////////////////
 namespace hpx { namespace opencl { namespace server {
@@ -23,12 +24,19 @@ namespace hpx { namespace opencl { namespace server {
     //  Global opencl functions
     //
 
-    // Returns the IDs of all devices on current host
+    // Returns the IDs of all devices on current host, partitioned into
+    // sub-devices if requested
     std::vector<hpx::opencl::device>
-    create_devices(cl_device_type, std::string cl_version);
+    create_devices(cl_device_type, std::string cl_version,
+                   hpx::opencl::device_partition partition);
+
+    // Drops one reference of the devices returned by create_devices
+    void
+    release_devices(std::vector<hpx::naming::id_type> device_ids);
 
     //[opencl_management_action_types
     HPX_DEFINE_PLAIN_ACTION(create_devices, create_devices_action);
+    HPX_DEFINE_PLAIN_ACTION(release_devices, release_devices_action);
     //]
 
 }}}
@@ -36,6 +44,9 @@ namespace hpx { namespace opencl { namespace server {
 HPX_ACTION_USES_MEDIUM_STACK(hpx::opencl::server::create_devices_action);
 HPX_REGISTER_ACTION_DECLARATION(hpx::opencl::server::create_devices_action,
                                 hpx_opencl_server_create_devices_action)
+HPX_ACTION_USES_MEDIUM_STACK(hpx::opencl::server::release_devices_action);
+HPX_REGISTER_ACTION_DECLARATION(hpx::opencl::server::release_devices_action,
+                                hpx_opencl_server_release_devices_action)
 
 #endif
 
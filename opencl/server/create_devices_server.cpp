@@ -12,6 +12,12 @@
 // HPXCL dependencies
 #include "../device.hpp"
 #include "device.hpp"
+#include "util/core_budget.hpp"
+#include "util/device_registry.hpp"
+
+// HPX dependencies
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/lcos/when_all.hpp>
 
 // Other dependencies
 #include <vector>
@@ -65,6 +71,208 @@ parse_version_string(std::string version_str)
 }
 
 
+// Splits a device into sub-devices, according to the given partition.
+// Returns the device itself if it can't be partitioned this way.
+static std::vector<cl_device_id>
+partition_device( cl_device_id device, const std::vector<int> & version,
+                  const hpx::opencl::device_partition & partition )
+{
+
+    std::vector<cl_device_id> sub_devices;
+
+#ifdef CL_VERSION_1_2
+
+    // Sub-devices need OpenCL 1.2
+    bool supports_partitioning = version[0] > 1 ||
+                                 (version[0] == 1 && version[1] >= 2);
+
+    // Unpartitioned CPU devices get limited to the core budget, if
+    // requested
+    bool use_core_budget =
+        partition.type == hpx::opencl::device_partition::none &&
+        supports_partitioning &&
+        hpx::opencl::server::util::core_budget::uses_sub_devices() &&
+        hpx::opencl::server::util::core_budget::applies_to(device);
+
+    if((partition.type != hpx::opencl::device_partition::none &&
+        supports_partitioning) || use_core_budget)
+    {
+        cl_int err;
+
+        // Build the partition properties
+        cl_device_partition_property properties[4] = {0, 0, 0, 0};
+        if(use_core_budget)
+        {
+            properties[0] = CL_DEVICE_PARTITION_BY_COUNTS;
+            properties[1] = static_cast<cl_device_partition_property>(
+                hpx::opencl::server::util::core_budget::reserved_cores());
+            properties[2] = CL_DEVICE_PARTITION_BY_COUNTS_LIST_END;
+        }
+        else switch(partition.type)
+        {
+            case hpx::opencl::device_partition::by_numa_domain:
+                properties[0] = CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN;
+                properties[1] = CL_DEVICE_AFFINITY_DOMAIN_NUMA;
+                break;
+            default:
+                properties[0] = CL_DEVICE_PARTITION_EQUALLY;
+                properties[1] = partition.compute_units;
+                break;
+        }
+
+        // Query the supported partition types
+        std::size_t param_size;
+        err = clGetDeviceInfo(device, CL_DEVICE_PARTITION_PROPERTIES, 0, NULL,
+                              &param_size);
+        cl_ensure(err, "clGetDeviceInfo()");
+        std::vector<cl_device_partition_property> supported_properties(
+                    param_size / sizeof(cl_device_partition_property));
+        err = clGetDeviceInfo(device, CL_DEVICE_PARTITION_PROPERTIES,
+                              param_size, supported_properties.data(), NULL);
+        cl_ensure(err, "clGetDeviceInfo()");
+
+        bool supported = false;
+        for(const auto & property : supported_properties)
+        {
+            if(property == properties[0])
+                supported = true;
+        }
+
+        // Check for the NUMA affinity domain
+        if(supported && properties[0] == CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN)
+        {
+            cl_device_affinity_domain affinity_domains;
+            err = clGetDeviceInfo(device, CL_DEVICE_PARTITION_AFFINITY_DOMAIN,
+                                  sizeof(affinity_domains), &affinity_domains,
+                                  NULL);
+            cl_ensure(err, "clGetDeviceInfo()");
+            supported = (affinity_domains & CL_DEVICE_AFFINITY_DOMAIN_NUMA)
+                        != 0;
+        }
+
+        if(supported)
+        {
+            // Query for number of sub-devices
+            cl_uint num_sub_devices;
+            err = clCreateSubDevices(device, properties, 0, NULL,
+                                     &num_sub_devices);
+
+            // The device might still not be partitionable, e.g. if the
+            // compute units don't divide evenly or the core budget exceeds
+            // the device
+            if(err != CL_DEVICE_PARTITION_FAILED &&
+               err != CL_INVALID_DEVICE_PARTITION_COUNT)
+            {
+                cl_ensure(err, "clCreateSubDevices()");
+
+                // Create sub-devices
+                sub_devices.resize(num_sub_devices);
+                err = clCreateSubDevices(device, properties, num_sub_devices,
+                                         sub_devices.data(), NULL);
+                cl_ensure(err, "clCreateSubDevices()");
+
+                return sub_devices;
+            }
+        }
+    }
+
+#endif //CL_VERSION_1_2
+
+    // Use the whole device
+    sub_devices.push_back(device);
+    return sub_devices;
+
+}
+
+
+// Returns whether the command queues should have profiling enabled
+static bool
+profiling_enabled()
+{
+    static bool enabled =
+        (hpx::get_config_entry("hpx.opencl.profiling", "0") == "1");
+    return enabled;
+}
+
+// Creates and initializes a device component.
+// Runs on its own thread, so that multiple devices get initialized in
+// parallel.
+static hpx::opencl::device
+create_device( uintptr_t device_ptr, bool is_sub_device,
+               hpx::opencl::server::util::device_statistics* statistics )
+{
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_device_id device_id = reinterpret_cast<cl_device_id>(device_ptr);
+
+    // Create a new device client
+    hpx::opencl::device device_client(
+        hpx::components::new_<hpx::opencl::server::device>(
+                    hpx::find_here()));
+
+    // Initialize device server locally
+    std::shared_ptr<hpx::opencl::server::device> device_server =
+                         hpx::get_ptr<hpx::opencl::server::device>
+                                    (device_client.get_id()).get();
+    device_server->init(device_id, profiling_enabled(), is_sub_device,
+                        statistics);
+
+    return device_client;
+
+}
+
+// Partitions an OpenCL device and creates the device components.
+static hpx::future<std::vector<hpx::opencl::device> >
+create_devices_of( cl_device_id device, const std::vector<int> & version,
+                   const hpx::opencl::device_partition & partition )
+{
+
+    // Split the device, if requested
+    std::vector<cl_device_id> sub_devices =
+                        partition_device(device, version, partition);
+    bool is_sub_device = (sub_devices.size() != 1 ||
+                          sub_devices[0] != device);
+
+    // Device initialization needs a large stack size
+    hpx::threads::executors::default_executor exec(
+                                          hpx::threads::thread_priority_normal,
+                                          hpx::threads::thread_stacksize_medium);
+
+    // Create the devices in parallel, as context and command queue
+    // creation can take a while on some drivers
+    std::vector<hpx::future<hpx::opencl::device> > device_futures;
+    for(const auto & sub_device : sub_devices)
+    {
+        // Number the devices before, so their counter instances follow
+        // the enumeration order and not the order of initialization
+        hpx::opencl::server::util::device_statistics* statistics =
+            hpx::opencl::server::util::device_statistics::create();
+
+        device_futures.push_back(
+            hpx::threads::async_execute( exec, &create_device,
+                                         (uintptr_t)sub_device,
+                                         is_sub_device, statistics ));
+    }
+
+    return hpx::when_all(device_futures).then( hpx::launch::sync,
+        [](hpx::future<std::vector<hpx::future<hpx::opencl::device> > > && f)
+        {
+            std::vector<hpx::future<hpx::opencl::device> > device_futures =
+                                                                    f.get();
+
+            std::vector<hpx::opencl::device> devices;
+            devices.reserve(device_futures.size());
+            for(auto & device_future : device_futures)
+            {
+                devices.push_back(device_future.get());
+            }
+            return devices;
+        });
+
+}
+
+
 ///////////////////////////////////////////////////
 /// Implementations
 ///
@@ -72,15 +280,31 @@ parse_version_string(std::string version_str)
 // This method initializes the devices-list if it's not done yet.
 std::vector<hpx::opencl::device>
 hpx::opencl::server::create_devices(cl_device_type device_type,
-                                    std::string min_cl_version)
+                                    std::string min_cl_version,
+                                    hpx::opencl::device_partition partition)
 {
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
 
+    // Check the partition
+    if(partition.type != hpx::opencl::device_partition::none &&
+       partition.type != hpx::opencl::device_partition::by_numa_domain &&
+       partition.type != hpx::opencl::device_partition::equally)
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "create_devices()",
+                            "Unknown partition type!");
+    if(partition.type == hpx::opencl::device_partition::equally &&
+       partition.compute_units == 0)
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "create_devices()",
+                            "compute_units must not be zero!");
+
+    // Limit CPU OpenCL runtimes before they get initialized
+    hpx::opencl::server::util::core_budget::apply();
+
     // Parse required OpenCL version
     std::vector<int> required_version = parse_version_string(min_cl_version);
 
-    // Initialize device list
-    std::vector<hpx::opencl::device> devices;
+    // The devices of every OpenCL device
+    std::vector<hpx::shared_future<std::vector<hpx::opencl::device> > >
+        device_futures;
 
     // Declaire the cl error code variable
     cl_int err;
@@ -159,23 +383,40 @@ hpx::opencl::server::create_devices(cl_device_type device_type,
                 if(version[1] < required_version[1]) continue;
             }
 
-            // Create a new device client
-            hpx::opencl::device device_client(
-                hpx::components::new_<hpx::opencl::server::device>(
-                            hpx::find_here()));
-
-            // Initialize device server locally
-            std::shared_ptr<hpx::opencl::server::device> device_server =
-                                 hpx::get_ptr<hpx::opencl::server::device>
-                                                (device_client.get_id()).get();
-            device_server->init(device);
-
-            // Add device to list of valid devices
-            devices.push_back(device_client);
+            // Get the devices from the registry. They only get created if
+            // no earlier call created them already.
+            device_futures.push_back(
+                hpx::opencl::server::util::device_registry::get_instance()
+                    .acquire( device, partition,
+                              [device, version, partition]()
+                              {
+                                  return create_devices_of(device, version,
+                                                           partition);
+                              } ));
         }
     }
 
+    // Collect the devices, in the order they were found
+    std::vector<hpx::opencl::device> devices;
+    for(auto & device_future : device_futures)
+    {
+        const std::vector<hpx::opencl::device> & devices_of_device =
+                                                        device_future.get();
+        devices.insert(devices.end(), devices_of_device.begin(),
+                                      devices_of_device.end());
+    }
+
     return devices;
 }
 
+void
+hpx::opencl::server::release_devices(
+                            std::vector<hpx::naming::id_type> device_ids)
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    hpx::opencl::server::util::device_registry::get_instance()
+        .release(device_ids);
+}
+
 
@@ -14,9 +14,18 @@
 #include "../cl_headers.hpp"
 
 #include "../fwd_declarations.hpp"
+#include "../profiling.hpp"
 
 #include "util/event_map.hpp"
 #include "util/data_map.hpp"
+#include "util/device_statistics.hpp"
+
+#include "../util/graph_description.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <vector>
 
 // REGISTER_ACTION_DECLARATION templates
 #include "util/server_definitions.hpp"
@@ -42,7 +51,11 @@ namespace hpx { namespace opencl{ namespace server{
         //////////////////////////////////////////////////
         /// Local public functions
         ///
-        void init(cl_device_id device_id, bool enable_profiling=false);
+        // Sub-devices get released together with this component.
+        // Without statistics, the device creates its own.
+        void init(cl_device_id device_id, bool enable_profiling=false,
+                  bool is_sub_device=false,
+                  util::device_statistics* statistics=NULL);
 
         cl_context get_context();
         cl_device_id get_device_id();
@@ -71,6 +84,10 @@ namespace hpx { namespace opencl{ namespace server{
         hpx::id_type
         create_program_with_binary(hpx::serialization::serialize_buffer<char>);
 
+        // creates a new command graph from recorded nodes
+        hpx::id_type
+        create_command_graph(std::vector<hpx::opencl::util::graph_node>);
+
         /////////////////////////////////////////////////
         /// Behind-the-scenes functionality of this component
         ///
@@ -87,13 +104,56 @@ namespace hpx { namespace opencl{ namespace server{
         void
         activate_deferred_event_with_data(hpx::naming::id_type);
 
+        // registers a new user event to a GID. Used for dependencies that
+        // are no OpenCL events of this device.
+        void
+        create_user_event(hpx::naming::id_type);
+
+        // completes the user event registered to a GID
+        void
+        set_user_event_status(hpx::naming::id_type, bool failed);
+
+        // registers an event to a GID that completes together with an event
+        // of another device
+        void
+        import_event( hpx::naming::id_type event_id,
+                      hpx::naming::id_type source_device_id,
+                      hpx::naming::id_type source_event_id );
+
+        // waits for the cl_event registered to a GID
+        void
+        wait_for_event(hpx::naming::id_type);
+
+        // waits until all nowait commands of a locality arrived, then
+        // enqueues a barrier
+        void
+        barrier(std::uint32_t source_locality, std::uint64_t num_submitted);
+
+        // waits until all nowait commands of a locality arrived and all
+        // commands enqueued so far completed
+        void
+        finish(std::uint32_t source_locality, std::uint64_t num_submitted);
+
+        // returns the statistics of the kernels launched on this device,
+        // one entry per kernel name
+        std::vector<hpx::opencl::kernel_profile>
+        get_kernel_profiles();
+
         HPX_DEFINE_COMPONENT_ACTION(device, get_device_info);
         HPX_DEFINE_COMPONENT_ACTION(device, get_platform_info);
         HPX_DEFINE_COMPONENT_ACTION(device, create_buffer);
         HPX_DEFINE_COMPONENT_ACTION(device, create_program_with_source);
         HPX_DEFINE_COMPONENT_ACTION(device, create_program_with_binary);
+        HPX_DEFINE_COMPONENT_ACTION(device, create_command_graph);
         HPX_DEFINE_COMPONENT_ACTION(device, release_event);
         HPX_DEFINE_COMPONENT_ACTION(device, activate_deferred_event);
+        HPX_DEFINE_COMPONENT_ACTION(device, create_user_event);
+        HPX_DEFINE_COMPONENT_ACTION(device, set_user_event_status);
+        HPX_DEFINE_COMPONENT_ACTION(device, import_event);
+        HPX_DEFINE_COMPONENT_ACTION(device, wait_for_event);
+        HPX_DEFINE_COMPONENT_ACTION(device, barrier);
+        HPX_DEFINE_COMPONENT_ACTION(device, finish);
+        HPX_DEFINE_COMPONENT_ACTION(device, get_kernel_profiles);
 
     public:
         /////////////////////////////////////////////////
@@ -107,6 +167,9 @@ namespace hpx { namespace opencl{ namespace server{
         cl_event
         retrieve_event(const hpx::naming::id_type & gid);
 
+        // the statistics of this device, for the performance counters
+        util::device_statistics& get_statistics();
+
         // command queue retrievals
         cl_command_queue get_read_command_queue();
         cl_command_queue get_write_command_queue();
@@ -125,6 +188,61 @@ namespace hpx { namespace opencl{ namespace server{
         // Necessary to offload wait from hpx to os thread.
         void wait_for_cl_event(cl_event);
 
+        // Lets other HPX threads run before the given query of a polling
+        // loop. Backs off on devices with a core budget.
+        void pause_between_queries(std::size_t query);
+
+        // Reads the timestamps of a completed command. Returns false if
+        // the device has no profiling enabled or they are missing.
+        bool read_timestamps( cl_event event,
+                              hpx::opencl::command_timestamps & timestamps );
+
+        // Triggers the client event of a completed command. Profiling
+        // devices send the timestamps along.
+        void trigger_event( const hpx::naming::id_type & event_id,
+                            cl_event event );
+
+        // Sends the data of a completed command to its client event,
+        // after its timestamps got stored on the locality of the event, so
+        // they are there once the future is ready. Does not wait for the
+        // delivery. Sends right away if the device has no profiling
+        // enabled.
+        void send_data_after_timestamps( const hpx::naming::id_type & event_id,
+                                         cl_event event,
+                                         hpx::util::function_nonser<void()>
+                                             send_data );
+
+        // Nowait command handling.
+        // Commands without client event (enqueue_nowait) report their
+        // arrival here, so barrier() and finish() can wait for them.
+        // Commands forwarded by other devices use invalid_locality_id
+        // as source and do not get counted.
+        void nowait_submitted( std::uint32_t source_locality,
+                               std::exception_ptr error = std::exception_ptr() );
+
+        // Keeps the data of a nowait command alive until finish()
+        template<typename T>
+        void put_nowait_data( cl_event event,
+                              hpx::serialization::serialize_buffer<T> data )
+        {
+            event_data_map.add(event, data);
+
+            bool needs_purge;
+            {
+                std::lock_guard<lock_type> lock(nowait_lock);
+                nowait_events.push_back(event);
+                needs_purge = (nowait_events.size() % nowait_purge_interval == 0);
+            }
+
+            // Don't let the data of long nowait streams pile up
+            if(needs_purge)
+                purge_nowait_data();
+        }
+
+        // Keeps track of a nowait command that got forwarded to another
+        // device. finish() waits for it.
+        void put_nowait_forward(hpx::future<void> && forward);
+
     private:
         ///////////////////////////////////////////////
         // Private Member Functions
@@ -140,6 +258,18 @@ namespace hpx { namespace opencl{ namespace server{
         // Releases the data that was being kept alive
         void delete_event_data(cl_event);
 
+        // Waits until all nowait commands of a locality arrived.
+        // Rethrows errors of nowait commands.
+        void wait_for_nowait_commands( std::uint32_t source_locality,
+                                       std::uint64_t num_submitted );
+
+        // Releases the data of completed nowait commands
+        void purge_nowait_data();
+
+        // Releases the data of the given nowait commands. They need to be
+        // completed.
+        void release_nowait_data(std::vector<cl_event> events);
+
     private:
         ///////////////////////////////////////////////
         // Private Member Variables
@@ -148,10 +278,28 @@ namespace hpx { namespace opencl{ namespace server{
         cl_platform_id      platform_id;
         cl_context          context;
         cl_command_queue    command_queue;
+        bool                is_sub_device;
+        bool                profiling;
+
+        // pause_between_queries backs off after wait_spin_count queries on
+        // devices with a core budget
+        static const std::size_t wait_spin_count = 16;
+        static const std::size_t wait_max_backoff_us = 50;
+        bool                backoff_waits;
 
         util::event_map     event_map;
         util::data_map      event_data_map;
 
+        util::device_statistics* statistics;
+
+        // nowait command bookkeeping
+        static const std::size_t nowait_purge_interval = 256;
+        lock_type                                nowait_lock;
+        std::map<std::uint32_t, std::uint64_t>   nowait_received;
+        std::exception_ptr                       nowait_error;
+        std::vector<cl_event>                    nowait_events;
+        std::vector<hpx::future<void> >          nowait_forwards;
+
     };
 }}}
 
@@ -161,8 +309,16 @@ HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, get_platform_info);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, create_buffer);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, create_program_with_source);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, create_program_with_binary);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, create_command_graph);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, release_event);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, activate_deferred_event);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, create_user_event);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, set_user_event_status);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, import_event);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, wait_for_event);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, barrier);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, finish);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(device, get_kernel_profiles);
 //]
 
 #endif
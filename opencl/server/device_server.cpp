@@ -12,16 +12,26 @@
 // other hpxcl dependencies
 #include "buffer.hpp"
 #include "program.hpp"
+#include "command_graph.hpp"
+#include "util/core_budget.hpp"
+#include "../launch_stages.hpp"
 
 // HPX dependencies
 #include <hpx/include/thread_executors.hpp>
 #include <hpx/parallel/executors/service_executors.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 
 using namespace hpx::opencl::server;
 
 
 // Constructor
 device::device()
+  : is_sub_device(false), profiling(false), backoff_waits(false),
+    statistics(NULL)
 {
     // Register the event deletion callback function at the event map
     event_map.register_deletion_callback(&delete_event);
@@ -30,7 +40,10 @@ device::device()
 // External destructor.
 // This is needed because OpenCL calls only run properly on large stack size.
 static void device_cleanup(uintptr_t command_queue_ptr,
-                           uintptr_t context_ptr)
+                           uintptr_t context_ptr,
+                           uintptr_t sub_device_ptr,
+                           std::vector<cl_event> nowait_events,
+                           util::device_statistics* statistics)
 {
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
@@ -45,6 +58,18 @@ static void device_cleanup(uintptr_t command_queue_ptr,
     {
         err = clFinish(command_queue);
         cl_ensure_nothrow(err, "clFinish()");
+
+        // Release the events that the statistics still hold
+        if(statistics)
+            statistics->collect_completed();
+
+        // Release the events of unfinished nowait commands
+        for(cl_event event : nowait_events)
+        {
+            err = clReleaseEvent(event);
+            cl_ensure_nothrow(err, "clReleaseEvent()");
+        }
+
         err = clReleaseCommandQueue(command_queue);
         cl_ensure_nothrow(err, "clReleaseCommandQueue()");
         command_queue = NULL;
@@ -58,6 +83,16 @@ static void device_cleanup(uintptr_t command_queue_ptr,
         context = NULL;
     }
 
+#ifdef CL_VERSION_1_2
+    // Release sub-device
+    cl_device_id sub_device = reinterpret_cast<cl_device_id>(sub_device_ptr);
+    if(sub_device)
+    {
+        err = clReleaseDevice(sub_device);
+        cl_ensure_nothrow(err, "clReleaseDevice()");
+    }
+#endif
+
 }
 
 // Destructor
@@ -70,19 +105,28 @@ device::~device()
 
     // run dectructor in a thread, as we need it to run on a large stack size
     hpx::threads::async_execute( exec, &device_cleanup, (uintptr_t)command_queue,
-                                       (uintptr_t)context).wait();
+                                       (uintptr_t)context,
+                                       (uintptr_t)(is_sub_device ? device_id
+                                                                 : NULL),
+                                       std::move(nowait_events),
+                                       statistics).wait();
 
 }
 
 // Initialization function.
 // Needed because cl_device_id can not be serialized.
 void
-device::init(cl_device_id _device_id, bool enable_profiling)
+device::init(cl_device_id _device_id, bool enable_profiling,
+             bool _is_sub_device, util::device_statistics* _statistics)
 {
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
 
     this->device_id = _device_id;
+    this->is_sub_device = _is_sub_device;
+    this->backoff_waits = util::core_budget::applies_to(device_id);
+    this->statistics = _statistics ? _statistics
+                                   : util::device_statistics::create();
 
     cl_int err;
 
@@ -122,6 +166,8 @@ device::init(cl_device_id _device_id, bool enable_profiling)
     if(enable_profiling &&
                        (supported_queue_properties & CL_QUEUE_PROFILING_ENABLE))
         command_queue_properties |= CL_QUEUE_PROFILING_ENABLE;
+    this->profiling =
+        (command_queue_properties & CL_QUEUE_PROFILING_ENABLE) != 0;
 
     // Create Command Queue
     #ifdef CL_VERSION_2_0
@@ -269,6 +315,26 @@ device::create_program_with_binary(
     return prog;
 }
 
+hpx::id_type
+device::create_command_graph(
+    std::vector<hpx::opencl::util::graph_node> nodes )
+{
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    // Create new command graph
+    hpx::id_type graph = hpx::components::new_
+                     <hpx::opencl::server::command_graph>( hpx::find_here() ).get();
+
+    // Initialize command graph locally
+    std::shared_ptr<hpx::opencl::server::command_graph> graph_server =
+                hpx::get_ptr<hpx::opencl::server::command_graph>( graph ).get();
+
+    graph_server->init( get_id(), std::move(nodes) );
+
+    return graph;
+}
+
 void
 device::release_event(hpx::naming::gid_type gid)
 {
@@ -279,6 +345,10 @@ device::release_event(hpx::naming::gid_type gid)
 
     // delete event from map
     event_map.remove(gid);
+    util::device_statistics::add(statistics->events, -1);
+
+    // drop the launch stages, if the event got recorded
+    hpx::opencl::detail::release_launch_stages(gid);
 
 }
 
@@ -302,6 +372,7 @@ device::register_event( const hpx::naming::id_type & gid, cl_event event )
 
     // Add pair to event_map
     event_map.add(gid, event);
+    util::device_statistics::add(statistics->events, 1);
 
 }
 
@@ -315,6 +386,13 @@ device::retrieve_event( const hpx::naming::id_type & gid )
 }
 
 
+hpx::opencl::server::util::device_statistics&
+device::get_statistics()
+{
+    HPX_ASSERT(statistics);
+    return *statistics;
+}
+
 cl_command_queue
 device::get_read_command_queue()
 {
@@ -333,6 +411,43 @@ device::get_kernel_command_queue()
     return command_queue;
 }
 
+// Adds the time of its lifetime to a counter, in nanoseconds
+namespace {
+    struct wait_timer
+    {
+        wait_timer(std::atomic<std::uint64_t>& counter_)
+          : counter(counter_),
+            start(hpx::util::high_resolution_clock::now())
+        {}
+
+        ~wait_timer()
+        {
+            hpx::opencl::server::util::device_statistics::add(counter,
+                hpx::util::high_resolution_clock::now() - start);
+        }
+
+        std::atomic<std::uint64_t>& counter;
+        std::uint64_t start;
+    };
+}
+
+void
+device::pause_between_queries(std::size_t query)
+{
+    // If the device has a core budget, the OpenCL runtime runs on
+    // reserved cores and longer waits back off to free the HPX worker.
+    if(query > wait_spin_count && backoff_waits)
+    {
+        std::size_t backoff_us = query - wait_spin_count;
+        if(backoff_us > wait_max_backoff_us)
+            backoff_us = wait_max_backoff_us;
+        hpx::this_thread::sleep_for(
+            std::chrono::microseconds(backoff_us) );
+    }
+    else if(query > 0)
+        hpx::this_thread::yield();
+}
+
 void
 device::wait_for_cl_event(cl_event event)
 {
@@ -341,18 +456,16 @@ device::wait_for_cl_event(cl_event event)
     cl_int err;
     cl_int execution_state = CL_RUNNING;
 
+    // count the waiting time, also if the command failed
+    wait_timer timer(statistics->wait_time);
+
     // Loop until the event state turns to true.
     // Previous attempts used clSetEventCallback, but it turned out to
     // be really slow.
     for(std::size_t i = 0; execution_state != CL_COMPLETE; i++){
 
-        // Do exponential backup
-    	//hpx::util::yield_while(i);
-
-    	  hpx::util::yield_while([i]()
-    	        { return i; });
-
-
+        // Let other HPX threads run between two queries
+        pause_between_queries(i);
 
         // Query OpenCL for the event state
         err = clGetEventInfo( event, CL_EVENT_COMMAND_EXECUTION_STATUS,
@@ -361,11 +474,88 @@ device::wait_for_cl_event(cl_event event)
 
     }
 
+    // Completes the command in the statistics, no need for a callback
+    statistics->command_observed(event, execution_state);
+
     // Check for internal errors
     cl_ensure(execution_state, "OpenCL Internal Error!");
 
 }
 
+bool
+device::read_timestamps( cl_event event,
+                         hpx::opencl::command_timestamps & timestamps )
+{
+    if(!profiling)
+        return false;
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    const cl_profiling_info infos[] = { CL_PROFILING_COMMAND_QUEUED,
+                                        CL_PROFILING_COMMAND_SUBMIT,
+                                        CL_PROFILING_COMMAND_START,
+                                        CL_PROFILING_COMMAND_END };
+    cl_ulong values[4];
+
+    // Missing timestamps must not fail the command, the client gets an
+    // error from get_timestamps() instead
+    for(std::size_t i = 0; i < 4; i++){
+        cl_int err = clGetEventProfilingInfo( event, infos[i],
+                                              sizeof(cl_ulong), &values[i],
+                                              NULL );
+        if(err != CL_SUCCESS)
+            return false;
+    }
+
+    timestamps.queued = values[0];
+    timestamps.submitted = values[1];
+    timestamps.started = values[2];
+    timestamps.ended = values[3];
+    return true;
+}
+
+void
+device::trigger_event( const hpx::naming::id_type & event_id, cl_event event )
+{
+    hpx::opencl::command_timestamps timestamps;
+    if(!read_timestamps(event, timestamps))
+    {
+        hpx::trigger_lco_event(event_id, false);
+        return;
+    }
+
+    // One message stores the timestamps and triggers the event on the
+    // locality of the event
+    typedef hpx::opencl::detail::complete_profiled_event_action func;
+    hpx::apply<func>( hpx::opencl::tools::get_locality_of(event_id),
+                      event_id, timestamps );
+}
+
+void
+device::send_data_after_timestamps( const hpx::naming::id_type & event_id,
+                                    cl_event event,
+                                    hpx::util::function_nonser<void()>
+                                        send_data )
+{
+    hpx::opencl::command_timestamps timestamps;
+    if(!read_timestamps(event, timestamps))
+    {
+        send_data();
+        return;
+    }
+
+    // The data is no void value, so it can't travel with the timestamps.
+    // Send it once they got stored, without blocking this thread.
+    typedef hpx::opencl::detail::store_timestamps_action func;
+    hpx::async<func>( hpx::opencl::tools::get_locality_of(event_id),
+                      event_id.get_gid(), timestamps ).then(
+        hpx::launch::sync,
+        [send_data](hpx::future<void> &&)
+        {
+            send_data();
+        });
+}
+
 void
 device::delete_event_data(cl_event event)
 {
@@ -391,11 +581,21 @@ device::activate_deferred_event(hpx::naming::id_type event_id)
     // get the cl_event
     cl_event event = event_map.get(event_id);
 
-    // wait for the cl_event to complete
-    wait_for_cl_event(event);
+    // wait for the cl_event to complete. failed commands, e.g. after a
+    // failed user event, get reported to the client event.
+    try {
+        wait_for_cl_event(event);
+    } catch (...) {
+        hpx::set_lco_error(event_id, std::current_exception(), false);
+        return;
+    }
+    hpx::opencl::detail::record_launch_stage( event_id.get_gid(),
+                                &hpx::opencl::launch_stages::completed );
 
     // trigger the client event
-    hpx::trigger_lco_event(event_id, false);
+    hpx::opencl::detail::record_launch_stage( event_id.get_gid(),
+                                &hpx::opencl::launch_stages::lco_set );
+    trigger_event(event_id, event);
 
 }
 
@@ -413,6 +613,286 @@ device::activate_deferred_event_with_data(hpx::naming::id_type event_id)
     wait_for_cl_event(event);
 
     // send the data to the client
-    data.send_data_to_client(event_id);
+    send_data_after_timestamps(event_id, event,
+        [data, event_id]() mutable
+        {
+            data.send_data_to_client(event_id);
+        });
+
+}
+
+void
+device::create_user_event(hpx::naming::id_type event_id)
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+
+    // create the user event. commands can depend on it right away.
+    cl_event event = clCreateUserEvent(context, &err);
+    cl_ensure(err, "clCreateUserEvent()");
+
+    // register the cl_event to the client event
+    register_event(event_id, event);
+
+}
+
+void
+device::set_user_event_status(hpx::naming::id_type event_id, bool failed)
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+
+    // get the cl_event. blocks until create_user_event() registered it.
+    cl_event event = event_map.get(event_id);
+
+    // a negative status makes all dependent commands fail
+    err = clSetUserEventStatus(event, failed ? CL_INVALID_EVENT : CL_COMPLETE);
+    cl_ensure(err, "clSetUserEventStatus()");
+
+}
+
+void
+device::import_event( hpx::naming::id_type event_id,
+                      hpx::naming::id_type source_device_id,
+                      hpx::naming::id_type source_event_id )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+
+    if(hpx::opencl::tools::get_locality_of(source_device_id)
+            == hpx::find_here()){
+        std::shared_ptr<device> source_device =
+            hpx::get_ptr<device>(source_device_id).get();
+
+        // Devices that share a context can wait for each other's events
+        if(source_device->get_context() == context){
+            cl_event event = source_device->retrieve_event(source_event_id);
+            err = clRetainEvent(event);
+            cl_ensure(err, "clRetainEvent()");
+            register_event(event_id, event);
+            return;
+        }
+    }
+
+    // Otherwise, bridge the event with a user event. The source device
+    // waits for its event and the user event gets completed from the
+    // continuation, so this thread does not block.
+    cl_event event = clCreateUserEvent(context, &err);
+    cl_ensure(err, "clCreateUserEvent()");
+
+    // keep the user event alive until it got completed
+    err = clRetainEvent(event);
+    cl_ensure(err, "clRetainEvent()");
+    register_event(event_id, event);
+
+    hpx::threads::executors::default_executor exec(
+                                          hpx::threads::thread_priority_normal,
+                                          hpx::threads::thread_stacksize_medium);
+
+    typedef hpx::opencl::server::device::wait_for_event_action func;
+    hpx::async<func>(source_device_id, std::move(source_event_id)).then(exec,
+        [event](hpx::future<void> && f)
+        {
+            HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+            // a negative status makes all dependent commands fail
+            cl_int err = clSetUserEventStatus( event,
+                                               f.has_exception()
+                                                   ? CL_INVALID_EVENT
+                                                   : CL_COMPLETE );
+            cl_ensure_nothrow(err, "clSetUserEventStatus()");
+
+            err = clReleaseEvent(event);
+            cl_ensure_nothrow(err, "clReleaseEvent()");
+        });
+
+}
+
+void
+device::wait_for_event(hpx::naming::id_type event_id)
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    wait_for_cl_event(event_map.get(event_id));
+}
+
+void
+device::nowait_submitted( std::uint32_t source_locality,
+                          std::exception_ptr error )
+{
+    std::lock_guard<lock_type> lock(nowait_lock);
+
+    if(source_locality != hpx::naming::invalid_locality_id)
+        nowait_received[source_locality]++;
+
+    // keep the first error, it gets reported by the next barrier or finish
+    if(error && !nowait_error)
+        nowait_error = error;
+}
+
+void
+device::put_nowait_forward( hpx::future<void> && forward )
+{
+    std::lock_guard<lock_type> lock(nowait_lock);
+    nowait_forwards.push_back(std::move(forward));
+}
+
+void
+device::wait_for_nowait_commands( std::uint32_t source_locality,
+                                  std::uint64_t num_submitted )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    // Wait for the nowait actions that are still on their way
+    for(std::size_t i = 0; ; i++){
+
+        // Let other HPX threads run between two queries
+        pause_between_queries(i);
+
+        std::lock_guard<lock_type> lock(nowait_lock);
+        if(nowait_received[source_locality] >= num_submitted)
+            break;
+
+    }
+
+    // Wait for commands that got forwarded to other devices
+    std::vector<hpx::future<void> > forwards;
+    std::exception_ptr error;
+    {
+        std::lock_guard<lock_type> lock(nowait_lock);
+        forwards.swap(nowait_forwards);
+        error = nowait_error;
+        nowait_error = std::exception_ptr();
+    }
+    hpx::wait_all(forwards);
+
+    // Report errors
+    if(error)
+        std::rethrow_exception(error);
+    for(auto & forward : forwards){
+        forward.get();
+    }
+}
+
+void
+device::purge_nowait_data()
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    std::vector<cl_event> events;
+    {
+        std::lock_guard<lock_type> lock(nowait_lock);
+        events.swap(nowait_events);
+    }
+
+    // Sort out the completed commands
+    std::vector<cl_event> completed_events;
+    std::vector<cl_event> running_events;
+    for(cl_event event : events){
+
+        cl_int execution_state;
+        cl_int err = clGetEventInfo( event, CL_EVENT_COMMAND_EXECUTION_STATUS,
+                                     sizeof(cl_int), &execution_state, NULL );
+        cl_ensure(err, "clGetEventInfo");
+
+        if(execution_state == CL_COMPLETE || execution_state < 0)
+            completed_events.push_back(event);
+        else
+            running_events.push_back(event);
+
+    }
+
+    {
+        std::lock_guard<lock_type> lock(nowait_lock);
+        nowait_events.insert( nowait_events.end(), running_events.begin(),
+                                                   running_events.end() );
+    }
+
+    release_nowait_data(std::move(completed_events));
+}
+
+void
+device::release_nowait_data(std::vector<cl_event> events)
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    for(cl_event event : events){
+
+        event_data_map.remove(event);
+
+        cl_int err = clReleaseEvent(event);
+        cl_ensure(err, "clReleaseEvent()");
+
+    }
+}
+
+void
+device::barrier( std::uint32_t source_locality, std::uint64_t num_submitted )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    wait_for_nowait_commands(source_locality, num_submitted);
+
+    // Commands enqueued afterwards wait for all previous commands
+    cl_int err;
+    #ifdef CL_VERSION_1_2
+        err = clEnqueueBarrierWithWaitList(command_queue, 0, NULL, NULL);
+        cl_ensure(err, "clEnqueueBarrierWithWaitList()");
+    #else
+        err = clEnqueueBarrier(command_queue);
+        cl_ensure(err, "clEnqueueBarrier()");
+    #endif
+}
+
+void
+device::finish( std::uint32_t source_locality, std::uint64_t num_submitted )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    wait_for_nowait_commands(source_locality, num_submitted);
+
+    // These commands are guaranteed to be finished after the marker
+    std::vector<cl_event> finished_events;
+    {
+        std::lock_guard<lock_type> lock(nowait_lock);
+        finished_events.swap(nowait_events);
+    }
+
+    // Wait for a marker instead of calling clFinish(), which would block
+    // the HPX worker thread
+    cl_int err;
+    cl_event marker;
+    #ifdef CL_VERSION_1_2
+        err = clEnqueueMarkerWithWaitList(command_queue, 0, NULL, &marker);
+        cl_ensure(err, "clEnqueueMarkerWithWaitList()");
+    #else
+        err = clEnqueueMarker(command_queue, &marker);
+        cl_ensure(err, "clEnqueueMarker()");
+    #endif
+
+    err = clFlush(command_queue);
+    cl_ensure(err, "clFlush()");
+
+    wait_for_cl_event(marker);
+
+    err = clReleaseEvent(marker);
+    cl_ensure(err, "clReleaseEvent()");
+
+    // all earlier commands completed, including the ones nobody waited for
+    statistics->collect_completed();
+
+    release_nowait_data(std::move(finished_events));
+}
+
+std::vector<hpx::opencl::kernel_profile>
+device::get_kernel_profiles()
+{
+    HPX_ASSERT(statistics);
 
+    // count the launches that completed without anybody waiting for them
+    statistics->collect_completed();
+    return statistics->get_kernel_profiles();
 }
@@ -15,6 +15,14 @@
 
 #include "../fwd_declarations.hpp"
 
+#include "util/device_statistics.hpp"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 // REGISTER_ACTION_DECLARATION templates
 #include "util/server_definitions.hpp"
 
@@ -39,6 +47,28 @@ namespace hpx { namespace opencl{ namespace server{
         void init ( hpx::naming::id_type device_id, cl_program program,
                     std::string kernel_name );
 
+        cl_kernel get_cl_kernel();
+
+        // Creates another cl_kernel of the same kernel function, for users
+        // that need their own scalar arguments. The caller owns it.
+        cl_kernel create_cl_kernel();
+
+        // Sets the buffer arguments of this kernel on a cl_kernel created
+        // by create_cl_kernel(). The caller needs to hold get_arg_lock().
+        void copy_buffer_args( cl_kernel target );
+
+        // Serializes changes of the kernel arguments with the launches
+        // that depend on them
+        hpx::lcos::local::mutex& get_arg_lock();
+
+        // The statistics of this kernel name on the parent device
+        util::device_statistics::kernel_statistics* get_statistics();
+
+        // Looks up the tuned local work size for a global work size.
+        // Returns false if the kernel was not tuned for this size.
+        bool lookup_tuned_local_size( const std::vector<std::size_t>& global_size,
+                                      std::vector<std::size_t>& local_size );
+
         //////////////////////////////////////////////////
         /// Exposed functionality of this component
         ///
@@ -54,15 +84,59 @@ namespace hpx { namespace opencl{ namespace server{
                       std::vector<std::size_t> size,
                       std::vector<hpx::naming::id_type> && dependencies );
 
+        // Runs the kernel without client event
+        void enqueue_nowait( std::vector<std::size_t> size,
+                             std::vector<hpx::naming::id_type> && dependencies,
+                             std::uint32_t source_locality );
+
+        // Runs the kernel once for several one-dimensional launches,
+        // over the concatenation of their ranges. ranges holds offset and
+        // size of every launch. The index table gets passed as arguments
+        // table_arg_index and table_arg_index + 1.
+        void enqueue_batch( std::vector<hpx::naming::id_type> && event_gids,
+                            std::vector<std::size_t> ranges,
+                            std::size_t local_size,
+                            cl_uint table_arg_index,
+                            std::vector<hpx::naming::id_type> && dependencies );
+
+        // Finds the fastest local work size for the given work dimensions.
+        // Returns an empty vector if the driver default is the fastest.
+        std::vector<std::size_t>
+        autotune( std::vector<std::size_t> size,
+                  std::vector<std::size_t> candidates,
+                  std::vector<hpx::naming::id_type> && dependencies );
+
         HPX_DEFINE_COMPONENT_ACTION(kernel, get_parent_device_id);
         HPX_DEFINE_COMPONENT_ACTION(kernel, set_arg);
         HPX_DEFINE_COMPONENT_ACTION(kernel, enqueue);
+        HPX_DEFINE_COMPONENT_ACTION(kernel, enqueue_nowait);
+        HPX_DEFINE_COMPONENT_ACTION(kernel, enqueue_batch);
+        HPX_DEFINE_COMPONENT_ACTION(kernel, autotune);
 
         //////////////////////////////////////////////////
         // Private Member Functions
         //
     private:
 
+        // Runs the kernel. return_event can be NULL, event_gid is the
+        // client event of the launch, if it has one.
+        void enqueue_kernel( std::vector<std::size_t> & size_vec,
+                             const std::vector<hpx::naming::id_type> & dependencies,
+                             cl_event* return_event,
+                             const hpx::naming::gid_type & event_gid =
+                                 hpx::naming::gid_type() );
+
+        // Returns the key of this kernel in the tuning database
+        std::string get_tuning_key();
+
+        // Runs the kernel on a profiling queue and returns the fastest
+        // execution time in nanoseconds, or 0 if the launch failed.
+        cl_ulong time_local_size( cl_command_queue profiling_queue,
+                                  std::size_t dim,
+                                  const std::size_t* global_work_offset,
+                                  const std::size_t* global_work_size,
+                                  const std::size_t* local_work_size );
+
 
         //////////////////////////////////////////////////
         //  Private Member Variables
@@ -71,6 +145,22 @@ namespace hpx { namespace opencl{ namespace server{
         std::shared_ptr<device> parent_device;
         cl_kernel kernel_id;
         hpx::naming::id_type parent_device_id;
+        std::string kernel_name;
+        util::device_statistics::kernel_statistics* statistics;
+
+        // tuned local work sizes, indexed by global work size
+        hpx::lcos::local::spinlock tuning_lock;
+        std::string tuning_key;
+        std::map<std::vector<std::size_t>, std::vector<std::size_t> >
+            tuned_local_sizes;
+        // global work sizes the database has no entry for
+        std::set<std::vector<std::size_t> > untuned_global_sizes;
+
+        // set_arg() and batched launches change the kernel arguments,
+        // which must not interleave with launches or copies of them
+        hpx::lcos::local::mutex arg_lock;
+        // the buffer arguments set so far, by argument index
+        std::map<cl_uint, cl_mem> buffer_args;
 
     };
 
@@ -80,6 +170,9 @@ namespace hpx { namespace opencl{ namespace server{
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(kernel, get_parent_device_id);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(kernel, set_arg);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(kernel, enqueue);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(kernel, enqueue_nowait);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(kernel, enqueue_batch);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(kernel, autotune);
 //]
 
 #endif
@@ -12,17 +12,26 @@
 // other hpxcl dependencies
 #include "device.hpp"
 #include "buffer.hpp"
+#include "util/tuning_database.hpp"
+#include "../util/tracer.hpp"
+#include "../launch_stages.hpp"
+#include "../kernel.hpp"
 
 // HPX dependencies
 #include <hpx/include/thread_executors.hpp>
 #include <hpx/parallel/executors/service_executors.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+
 
 using hpx::opencl::server::kernel;
 
 
 // Constructor
 kernel::kernel()
+  : statistics(NULL)
 {}
 
 // External destructor.
@@ -83,14 +92,76 @@ kernel::init( hpx::naming::id_type device_id, cl_program program,
     kernel_id = clCreateKernel( program, kernel_name.c_str(), &err );
     cl_ensure(err, "clCreateKernel()");
 
+    this->kernel_name = kernel_name;
+    this->statistics =
+        parent_device->get_statistics().get_kernel_statistics(kernel_name);
+
+}
+
+cl_kernel
+kernel::get_cl_kernel()
+{
+    return kernel_id;
+}
+
+cl_kernel
+kernel::create_cl_kernel()
+{
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+
+    cl_program program;
+    err = clGetKernelInfo( kernel_id, CL_KERNEL_PROGRAM, sizeof(cl_program),
+                           &program, NULL );
+    cl_ensure(err, "clGetKernelInfo()");
+
+    cl_kernel new_kernel_id = clCreateKernel( program, kernel_name.c_str(),
+                                              &err );
+    cl_ensure(err, "clCreateKernel()");
+
+    return new_kernel_id;
+
+}
+
+void
+kernel::copy_buffer_args( cl_kernel target )
+{
+
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+
+    for(const auto & arg : buffer_args)
+    {
+        err = clSetKernelArg( target, arg.first, sizeof(cl_mem),
+                              &arg.second );
+        cl_ensure(err, "clSetKernelArg()");
+    }
+
+}
+
+hpx::lcos::local::mutex&
+kernel::get_arg_lock()
+{
+    return arg_lock;
 }
 
+hpx::opencl::server::util::device_statistics::kernel_statistics*
+kernel::get_statistics()
+{
+    HPX_ASSERT(statistics);
+    return statistics;
+}
 
 void
 kernel::set_arg(cl_uint arg_index, hpx::naming::id_type buffer_id)
 {
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "kernel::set_arg",
+                                            "server" );
     cl_int err;
 
     // Get direct pointer to buffer
@@ -100,8 +171,10 @@ kernel::set_arg(cl_uint arg_index, hpx::naming::id_type buffer_id)
     cl_mem mem_id = buffer->get_cl_mem();
 
     // Set the argument
+    std::lock_guard<hpx::lcos::local::mutex> lock(arg_lock);
     err = clSetKernelArg(kernel_id, arg_index, sizeof(cl_mem), &mem_id);
     cl_ensure(err, "clSetKernelArg()");
+    buffer_args[arg_index] = mem_id;
 
 }
 
@@ -111,10 +184,152 @@ kernel::enqueue( hpx::naming::id_type && event_gid,
                  std::vector<hpx::naming::id_type> && dependencies )
 {
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "kernel::enqueue",
+                                            "server" );
+    hpx::opencl::util::tracer::event_arrived( event_gid.get_gid() );
+    hpx::opencl::detail::record_launch_stage( event_gid.get_gid(),
+                                &hpx::opencl::launch_stages::action_started );
+
+    cl_event return_event;
+
+    // run the kernel
+    enqueue_kernel( size_vec, dependencies, &return_event,
+                    event_gid.get_gid() );
+    hpx::opencl::detail::record_launch_stage( event_gid.get_gid(),
+                                &hpx::opencl::launch_stages::enqueue_returned );
+
+    // register the cl_event to the client event
+    parent_device->register_event(event_gid, return_event);
+
+}
+
+void
+kernel::enqueue_nowait( std::vector<std::size_t> size_vec,
+                        std::vector<hpx::naming::id_type> && dependencies,
+                        std::uint32_t source_locality )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "kernel::enqueue_nowait",
+                                            "server" );
+
+    // run the kernel without event. errors get reported on the next
+    // device::finish_async()
+    try {
+        enqueue_kernel( size_vec, dependencies, NULL );
+    } catch (...) {
+        parent_device->nowait_submitted( source_locality,
+                                         std::current_exception() );
+        return;
+    }
+
+    parent_device->nowait_submitted( source_locality );
+
+}
+
+void
+kernel::enqueue_batch( std::vector<hpx::naming::id_type> && event_gids,
+                       std::vector<std::size_t> ranges,
+                       std::size_t local_size,
+                       cl_uint table_arg_index,
+                       std::vector<hpx::naming::id_type> && dependencies )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "kernel::enqueue_batch",
+                                            "server" );
+    HPX_ASSERT(!event_gids.empty());
+    HPX_ASSERT(ranges.size() == 2 * event_gids.size());
 
     cl_int err;
     cl_event return_event;
 
+    // Build the index table. For every launch: its start in the
+    // concatenated range, and its original offset.
+    std::vector<cl_ulong> index_table(ranges.size());
+    std::size_t global_work_size = 0;
+    for(std::size_t i = 0; i < event_gids.size(); i++){
+        index_table[2 * i + 0] = global_work_size;
+        index_table[2 * i + 1] = ranges[2 * i + 0];
+        global_work_size += ranges[2 * i + 1];
+    }
+    cl_uint num_launches = static_cast<cl_uint>(event_gids.size());
+
+    // retrieve the dependency cl_events
+    util::event_dependencies events( dependencies, parent_device.get() );
+
+    // If local_work_size is not specified, let the OpenCL driver decide
+    std::vector<std::size_t> tuned_local_size;
+    std::size_t* local_work_size = NULL;
+    if(local_size == hpx::opencl::local_size_auto){
+        std::vector<std::size_t> global_size(1, global_work_size);
+        if(lookup_tuned_local_size(global_size, tuned_local_size) &&
+           tuned_local_size.size() == 1){
+            local_work_size = tuned_local_size.data();
+        }
+    } else if(local_size != 0){
+        local_work_size = &local_size;
+    }
+
+    {
+        std::lock_guard<hpx::lcos::local::mutex> lock(arg_lock);
+
+        // The table only lives as long as the launch, OpenCL keeps it
+        // alive after the release below
+        cl_mem table_mem = clCreateBuffer( parent_device->get_context(),
+                                           CL_MEM_READ_ONLY |
+                                           CL_MEM_COPY_HOST_PTR,
+                                           index_table.size() * sizeof(cl_ulong),
+                                           index_table.data(),
+                                           &err );
+        cl_ensure(err, "clCreateBuffer()");
+
+        err = clSetKernelArg( kernel_id, table_arg_index, sizeof(cl_mem),
+                              &table_mem );
+        if(err == CL_SUCCESS)
+            err = clSetKernelArg( kernel_id, table_arg_index + 1,
+                                  sizeof(cl_uint), &num_launches );
+        if(err == CL_SUCCESS)
+            err = clEnqueueNDRangeKernel( parent_device->get_kernel_command_queue(),
+                                          kernel_id, 1,
+                                          NULL,
+                                          &global_work_size,
+                                          local_work_size,
+                                          static_cast<cl_uint>(events.size()),
+                                          events.get_cl_events(),
+                                          &return_event );
+
+        cl_int release_err = clReleaseMemObject(table_mem);
+        cl_ensure(err, "clEnqueueNDRangeKernel()");
+        cl_ensure(release_err, "clReleaseMemObject()");
+    }
+
+    // count the command, the launches share one kernel
+    parent_device->get_statistics().kernel_enqueued( return_event,
+                                                     statistics );
+
+    // every launch gets its own reference to the event, as every client
+    // event releases it
+    for(std::size_t i = 1; i < event_gids.size(); i++){
+        err = clRetainEvent(return_event);
+        cl_ensure(err, "clRetainEvent()");
+    }
+
+    // fan the completion out to the client events
+    for(const auto & event_gid : event_gids){
+        parent_device->register_event(event_gid, return_event);
+    }
+
+}
+
+void
+kernel::enqueue_kernel( std::vector<std::size_t> & size_vec,
+                        const std::vector<hpx::naming::id_type> & dependencies,
+                        cl_event* return_event,
+                        const hpx::naming::gid_type & event_gid )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+
     // retrieve the dependency cl_events
     util::event_dependencies events( dependencies, parent_device.get() );
 
@@ -133,6 +348,19 @@ kernel::enqueue( hpx::naming::id_type && event_gid,
         local_work_size = NULL;
     }
 
+    // If local_work_size is auto, use the result of autotune()
+    std::vector<std::size_t> tuned_local_size;
+    if(local_work_size && local_work_size[0] == hpx::opencl::local_size_auto){
+        std::vector<std::size_t> global_size( global_work_size,
+                                              global_work_size + size );
+        if(lookup_tuned_local_size(global_size, tuned_local_size) &&
+           tuned_local_size.size() == size){
+            local_work_size = tuned_local_size.data();
+        } else {
+            local_work_size = NULL;
+        }
+    }
+
     // run the OpenCL-call
     err = clEnqueueNDRangeKernel( command_queue, kernel_id,
                                   static_cast<cl_uint>(size),
@@ -141,11 +369,393 @@ kernel::enqueue( hpx::naming::id_type && event_gid,
                                   local_work_size,
                                   static_cast<cl_uint>(events.size()),
                                   events.get_cl_events(),
-                                  &return_event );
+                                  return_event );
     cl_ensure(err, "clEnqueueNDRangeKernel()");
 
-    // register the cl_event to the client event
-    parent_device->register_event(event_gid, return_event);
+    // count the command
+    parent_device->get_statistics().kernel_enqueued(
+        return_event ? *return_event : NULL, statistics, event_gid );
+
+}
+
+// 64-bit FNV-1a. Used instead of std::hash, as the tuning database keys
+// need to be stable between runs.
+static std::uint64_t fnv1a_hash(const std::string& str,
+                                std::uint64_t hash = 14695981039346656037ULL)
+{
+    for(char c : str){
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Removes characters that would break the tuning database format
+static std::string sanitize_key_part(const char* str)
+{
+    std::string result(str);
+    for(char & c : result){
+        if(c == '\t' || c == '\n' || c == '|')
+            c = ' ';
+    }
+    return result;
+}
+
+std::string
+kernel::get_tuning_key()
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> lock(tuning_lock);
+        if(!tuning_key.empty())
+            return tuning_key;
+    }
+
+    cl_int err;
+    cl_device_id device_id = parent_device->get_device_id();
+
+    // Identify the program by its source and build options
+    cl_program program;
+    err = clGetKernelInfo( kernel_id, CL_KERNEL_PROGRAM, sizeof(cl_program),
+                           &program, NULL );
+    cl_ensure(err, "clGetKernelInfo()");
+
+    std::size_t source_size;
+    err = clGetProgramInfo( program, CL_PROGRAM_SOURCE, 0, NULL,
+                            &source_size );
+    cl_ensure(err, "clGetProgramInfo()");
+    std::vector<char> source(source_size + 1, '\0');
+    err = clGetProgramInfo( program, CL_PROGRAM_SOURCE, source_size,
+                            source.data(), NULL );
+    cl_ensure(err, "clGetProgramInfo()");
+
+    std::size_t options_size;
+    err = clGetProgramBuildInfo( program, device_id, CL_PROGRAM_BUILD_OPTIONS,
+                                 0, NULL, &options_size );
+    cl_ensure(err, "clGetProgramBuildInfo()");
+    std::vector<char> options(options_size + 1, '\0');
+    err = clGetProgramBuildInfo( program, device_id, CL_PROGRAM_BUILD_OPTIONS,
+                                 options_size, options.data(), NULL );
+    cl_ensure(err, "clGetProgramBuildInfo()");
+
+    std::uint64_t program_hash = fnv1a_hash(source.data());
+    program_hash = fnv1a_hash(options.data(), program_hash);
+
+    // Identify the device by its name and driver version
+    auto device_name = parent_device->get_device_info(CL_DEVICE_NAME);
+    auto driver_version = parent_device->get_device_info(CL_DRIVER_VERSION);
+
+    std::ostringstream key;
+    key << sanitize_key_part(kernel_name.c_str()) << "|"
+        << std::hex << program_hash << std::dec << "|"
+        << sanitize_key_part(device_name.data()) << "|"
+        << sanitize_key_part(driver_version.data());
+
+    std::lock_guard<hpx::lcos::local::spinlock> lock(tuning_lock);
+    tuning_key = key.str();
+    return tuning_key;
+}
+
+// Appends the global work size to the tuning key
+static std::string
+tuning_database_key( const std::string& kernel_key,
+                     const std::vector<std::size_t>& global_size )
+{
+    std::ostringstream key;
+    key << kernel_key << "|";
+    for(std::size_t i = 0; i < global_size.size(); i++){
+        if(i > 0) key << "x";
+        key << global_size[i];
+    }
+    return key.str();
+}
+
+bool
+kernel::lookup_tuned_local_size( const std::vector<std::size_t>& global_size,
+                                 std::vector<std::size_t>& local_size )
+{
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> lock(tuning_lock);
+        auto it = tuned_local_sizes.find(global_size);
+        if(it != tuned_local_sizes.end()){
+            local_size = it->second;
+            return true;
+        }
+
+        // The database had no entry before, don't ask it on every launch
+        if(untuned_global_sizes.count(global_size))
+            return false;
+    }
+
+    // Not tuned in this run, ask the database
+    util::tuning_database& database = util::tuning_database::get_instance();
+    bool found =
+        database.lookup( tuning_database_key(get_tuning_key(), global_size),
+                         local_size );
+
+    std::lock_guard<hpx::lcos::local::spinlock> lock(tuning_lock);
+    if(found)
+        tuned_local_sizes[global_size] = local_size;
+    else
+        untuned_global_sizes.insert(global_size);
+    return found;
+}
+
+// Creates a command queue with profiling enabled
+static cl_command_queue
+create_profiling_queue(cl_context context, cl_device_id device_id)
+{
+    cl_int err;
+    cl_command_queue queue;
+
+    #ifdef CL_VERSION_2_0
+        cl_queue_properties queue_properties[] = {CL_QUEUE_PROPERTIES,
+                              (cl_queue_properties) CL_QUEUE_PROFILING_ENABLE,
+                              (cl_queue_properties) 0};
+        queue = clCreateCommandQueueWithProperties(context, device_id,
+                                                   queue_properties, &err);
+        cl_ensure(err, "clCreateCommandQueueWithProperties()");
+    #else
+        queue = clCreateCommandQueue(context, device_id,
+                                     CL_QUEUE_PROFILING_ENABLE, &err);
+        cl_ensure(err, "clCreateCommandQueue()");
+    #endif
+
+    return queue;
+}
+
+cl_ulong
+kernel::time_local_size( cl_command_queue profiling_queue,
+                         std::size_t dim,
+                         const std::size_t* global_work_offset,
+                         const std::size_t* global_work_size,
+                         const std::size_t* local_work_size )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    // one warmup run, then take the fastest of the timed runs
+    const std::size_t num_runs = 4;
+
+    cl_ulong best_time = 0;
+    for(std::size_t run = 0; run < num_runs; run++){
+
+        cl_int err;
+        cl_event event;
+
+        err = clEnqueueNDRangeKernel( profiling_queue, kernel_id,
+                                      static_cast<cl_uint>(dim),
+                                      global_work_offset,
+                                      global_work_size,
+                                      local_work_size,
+                                      0, NULL, &event );
+
+        // Some candidates are rejected by the driver, e.g. if the kernel
+        // uses too much local memory. Those just lose.
+        if(err != CL_SUCCESS)
+            return 0;
+
+        err = clFlush(profiling_queue);
+        cl_ensure(err, "clFlush()");
+
+        parent_device->wait_for_cl_event(event);
+
+        cl_ulong start_time, end_time;
+        err = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_START,
+                                       sizeof(cl_ulong), &start_time, NULL );
+        cl_ensure(err, "clGetEventProfilingInfo()");
+        err = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_END,
+                                       sizeof(cl_ulong), &end_time, NULL );
+        cl_ensure(err, "clGetEventProfilingInfo()");
+
+        err = clReleaseEvent(event);
+        cl_ensure(err, "clReleaseEvent()");
+
+        // skip the warmup run
+        if(run == 0)
+            continue;
+
+        // never report 0, as 0 means 'failed'
+        cl_ulong time = std::max<cl_ulong>(end_time - start_time, 1);
+        if(best_time == 0 || time < best_time)
+            best_time = time;
+
+    }
+
+    return best_time;
+}
+
+// Generates local work sizes that are multiples of the preferred work group
+// size multiple, up to the maximum work group size.
+static std::vector<std::size_t>
+generate_local_size_candidates( const std::vector<std::size_t>& global_size,
+                                const std::vector<std::size_t>& max_item_sizes,
+                                std::size_t max_work_group_size,
+                                std::size_t preferred_multiple )
+{
+    std::size_t dim = global_size.size();
+    std::vector<std::size_t> candidates;
+
+    // all combinations of powers of two
+    std::vector<std::size_t> local_size(dim, 1);
+    while(true){
+
+        std::size_t product = 1;
+        bool valid = true;
+        for(std::size_t i = 0; i < dim; i++){
+            product *= local_size[i];
+            if(global_size[i] % local_size[i] != 0)
+                valid = false;
+        }
+
+        if(valid && product <= max_work_group_size &&
+           (product % preferred_multiple == 0 || product == max_work_group_size))
+            candidates.insert(candidates.end(), local_size.begin(),
+                                                local_size.end());
+
+        // next combination
+        std::size_t i = 0;
+        for(; i < dim; i++){
+            local_size[i] *= 2;
+            if(local_size[i] <= max_item_sizes[i] &&
+               local_size[i] <= max_work_group_size)
+                break;
+            local_size[i] = 1;
+        }
+        if(i == dim)
+            break;
+
+    }
+
+    return candidates;
+}
+
+std::vector<std::size_t>
+kernel::autotune( std::vector<std::size_t> size_vec,
+                  std::vector<std::size_t> candidates,
+                  std::vector<hpx::naming::id_type> && dependencies )
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+    cl_int err;
+    cl_device_id device_id = parent_device->get_device_id();
+
+    // prepare work dimensions
+    HPX_ASSERT( size_vec.size() % 3 == 0 );
+    std::size_t dim = size_vec.size() / 3;
+    const std::size_t* global_work_offset = size_vec.data() + 0 * dim;
+    std::vector<std::size_t> global_size( size_vec.begin() + 1 * dim,
+                                          size_vec.begin() + 2 * dim );
+
+    if(candidates.size() % dim != 0){
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "kernel::autotune()",
+                            "Candidates do not match the work dimensions!");
+    }
+
+    // wait for the dependencies, the tuning runs do not use the
+    // device command queue
+    {
+        util::event_dependencies events( dependencies, parent_device.get() );
+        for(std::size_t i = 0; i < events.size(); i++){
+            parent_device->wait_for_cl_event(events.get_cl_events()[i]);
+        }
+    }
+
+    // query the limits of this kernel
+    std::size_t max_work_group_size;
+    err = clGetKernelWorkGroupInfo( kernel_id, device_id,
+                                    CL_KERNEL_WORK_GROUP_SIZE,
+                                    sizeof(std::size_t), &max_work_group_size,
+                                    NULL );
+    cl_ensure(err, "clGetKernelWorkGroupInfo()");
+
+    std::size_t preferred_multiple;
+    err = clGetKernelWorkGroupInfo( kernel_id, device_id,
+                                    CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE,
+                                    sizeof(std::size_t), &preferred_multiple,
+                                    NULL );
+    cl_ensure(err, "clGetKernelWorkGroupInfo()");
+    if(preferred_multiple == 0)
+        preferred_multiple = 1;
+
+    auto max_item_sizes_data =
+                    parent_device->get_device_info(CL_DEVICE_MAX_WORK_ITEM_SIZES);
+    const std::size_t* max_item_sizes_ptr =
+            reinterpret_cast<const std::size_t*>(max_item_sizes_data.data());
+    std::size_t max_item_dims = max_item_sizes_data.size() / sizeof(std::size_t);
+    if(dim > max_item_dims){
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "kernel::autotune()",
+                            "Too many work dimensions!");
+    }
+    std::vector<std::size_t> max_item_sizes( max_item_sizes_ptr,
+                                             max_item_sizes_ptr + dim );
+
+    // use the default candidate space if none was given
+    if(candidates.empty()){
+        candidates = generate_local_size_candidates( global_size,
+                                                     max_item_sizes,
+                                                     max_work_group_size,
+                                                     preferred_multiple );
+    }
+
+    // time all candidates on a separate queue with profiling enabled
+    cl_command_queue profiling_queue =
+            create_profiling_queue(parent_device->get_context(), device_id);
+
+    std::vector<std::size_t> best_local_size;
+    cl_ulong best_time = 0;
+
+    try {
+
+        // the driver default is the baseline
+        best_time = time_local_size( profiling_queue, dim, global_work_offset,
+                                     global_size.data(), NULL );
+
+        for(std::size_t c = 0; c < candidates.size(); c += dim){
+
+            const std::size_t* local_size = candidates.data() + c;
+
+            // skip invalid candidates
+            std::size_t product = 1;
+            bool valid = true;
+            for(std::size_t i = 0; i < dim; i++){
+                product *= local_size[i];
+                if(local_size[i] == 0 ||
+                   local_size[i] > max_item_sizes[i] ||
+                   global_size[i] % local_size[i] != 0)
+                    valid = false;
+            }
+            if(!valid || product > max_work_group_size)
+                continue;
+
+            cl_ulong time = time_local_size( profiling_queue, dim,
+                                             global_work_offset,
+                                             global_size.data(), local_size );
+            if(time != 0 && (best_time == 0 || time < best_time)){
+                best_time = time;
+                best_local_size.assign(local_size, local_size + dim);
+            }
+
+        }
+
+    } catch (...) {
+        err = clReleaseCommandQueue(profiling_queue);
+        cl_ensure_nothrow(err, "clReleaseCommandQueue()");
+        throw;
+    }
+
+    err = clReleaseCommandQueue(profiling_queue);
+    cl_ensure(err, "clReleaseCommandQueue()");
+
+    // remember the winner
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> lock(tuning_lock);
+        tuned_local_sizes[global_size] = best_local_size;
+        untuned_global_sizes.erase(global_size);
+    }
+    util::tuning_database::get_instance().store(
+        tuning_database_key(get_tuning_key(), global_size), best_local_size );
 
+    return best_local_size;
 }
 
@@ -50,29 +50,40 @@ namespace hpx { namespace opencl{ namespace server{
 
         // builds the program.
         // mutually exclusive to compile() and link().
-        void build(std::string options);
+        // The compilation runs on the build service, the returned future
+        // becomes ready once it finished.
+        hpx::future<void> build(std::string options);
 
         // Returns the binary representation of the program
         hpx::serialization::serialize_buffer<char> get_binary();
 
         // creates a kernel from the buffer
-        hpx::naming::id_type create_kernel(std::string kernel_name);
+        hpx::future<hpx::naming::id_type>
+        create_kernel(std::string kernel_name);
+
+        // creates a built variant of this program with additional
+        // build options. variants are cached in util::program_cache.
+        hpx::future<hpx::naming::id_type> specialize(std::string options);
 
         HPX_DEFINE_COMPONENT_ACTION(program, get_parent_device_id);
         HPX_DEFINE_COMPONENT_ACTION(program, build);
         HPX_DEFINE_COMPONENT_ACTION(program, get_binary);
         HPX_DEFINE_COMPONENT_ACTION(program, create_kernel);
+        HPX_DEFINE_COMPONENT_ACTION(program, specialize);
 
         //////////////////////////////////////////////////
         // Private Member Functions
         //
     private:
 
-        // returns the build log
-        std::string acquire_build_log();
+        // initializes a specialized variant of original. takes ownership of
+        // one reference of built_program, creates an unbuilt program from
+        // the source of original if it is NULL.
+        void init_as_variant( const program& original,
+                              cl_program built_program );
 
-        // checks for build errors
-        void throw_on_build_errors(const char* function_name);
+        // replaces program_id with the program returned by the build service
+        void adopt_built_program(cl_program built_program);
 
 
         //////////////////////////////////////////////////
@@ -83,6 +94,11 @@ namespace hpx { namespace opencl{ namespace server{
         cl_program program_id;
         hpx::naming::id_type parent_device_id;
 
+        // the source or binary this program was created from.
+        // used by the build service to detect identical builds.
+        std::string source;
+        bool created_from_binary;
+
     };
 
 }}}
@@ -92,6 +108,7 @@ HPX_OPENCL_REGISTER_ACTION_DECLARATION(program, get_parent_device_id);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(program, build);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(program, get_binary);
 HPX_OPENCL_REGISTER_ACTION_DECLARATION(program, create_kernel);
+HPX_OPENCL_REGISTER_ACTION_DECLARATION(program, specialize);
 //]
 
 #endif
@@ -11,7 +11,9 @@
 
 // other hpxcl dependencies
 #include "device.hpp"
-#include "util/hpx_cl_interop.hpp"
+#include "util/build_service.hpp"
+#include "util/program_cache.hpp"
+#include "../util/tracer.hpp"
 #include "kernel.hpp"
 
 // HPX dependencies
@@ -21,8 +23,38 @@
 using hpx::opencl::server::program;
 
 
+namespace {
+
+    // Creates a component on this locality and hands its id and its server
+    // object to f, on a medium stack thread. Neither the creation nor the
+    // pointer lookup blocks the calling thread.
+    template <typename Component, typename F>
+    hpx::future<hpx::naming::id_type>
+    create_local_component(F f)
+    {
+        // OpenCL calls only run properly on large stack size
+        hpx::threads::executors::default_executor exec(
+                                          hpx::threads::thread_priority_normal,
+                                          hpx::threads::thread_stacksize_medium);
+
+        return hpx::components::new_<Component>(hpx::find_here()).then( exec,
+            [exec, f](hpx::future<hpx::naming::id_type> && id_future)
+            {
+                hpx::naming::id_type id = id_future.get();
+                return hpx::get_ptr<Component>(id).then( exec,
+                    [id, f](hpx::future<std::shared_ptr<Component> > && ptr)
+                    {
+                        return f(id, ptr.get());
+                    });
+            });
+    }
+
+}
+
+
 // Constructor
 program::program()
+  : program_id(NULL), created_from_binary(false)
 {}
 
 // External destructor.
@@ -97,6 +129,10 @@ program::init_with_source( hpx::naming::id_type device_id,
                                             &err );
     cl_ensure(err, "clCreateProgramWithSource()");
 
+    // Remember the source for build deduplication
+    source.assign(src_data, src_size);
+    created_from_binary = false;
+
 }
 
 void
@@ -131,119 +167,80 @@ program::init_with_binary( hpx::naming::id_type device_id,
     cl_ensure(err, "clCreateProgramWithBinary()");
     cl_ensure(binary_status, "clCreateProgramWithBinary().binary_status");
 
-}
-
-std::string
-program::acquire_build_log()
-{
-    cl_int err;
-
-    std::size_t build_log_size;
-
-    // Query size
-    err = clGetProgramBuildInfo(program_id, parent_device->get_device_id(),
-                                CL_PROGRAM_BUILD_LOG, 0, NULL, &build_log_size);
-
-    // Create buffer
-    std::vector<char> buf(build_log_size);
-
-    // Get log
-    err = clGetProgramBuildInfo(program_id, parent_device->get_device_id(),
-                                CL_PROGRAM_BUILD_LOG, build_log_size,
-                                buf.data(), NULL);
-
-    // make build log look nice in exception
-    std::stringstream sstream;
-    sstream << std::endl << std::endl;
-    sstream << "//////////////////////////////////////" << std::endl;
-    sstream << "/// OPENCL BUILD LOG" << std::endl;
-    sstream << "///" << std::endl;
-    sstream << std::endl << buf.data() << std::endl;
-    sstream << "///" << std::endl;
-    sstream << "/// OPENCL BUILD LOG END" << std::endl;
-    sstream << "//////////////////////////////////////" << std::endl;
-    sstream << std::endl;
-
-    // return the nice looking error string.
-    return sstream.str();
+    // Remember the binary for build deduplication
+    source.assign(binary.data(), binary.size());
+    created_from_binary = true;
 
 }
 
 void
-program::throw_on_build_errors(const char* function_name){
+program::init_as_variant( const program& original, cl_program built_program )
+{
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
 
-    cl_int err;
-    cl_build_status build_status;
-
-    // Read build status
-    err = clGetProgramBuildInfo( program_id, parent_device->get_device_id(),
-                                 CL_PROGRAM_BUILD_STATUS,
-                                 sizeof(cl_build_status), &build_status, NULL );
-    cl_ensure(err, "clGetProgramBuildInfo()");
+    this->parent_device_id = original.parent_device_id;
+    this->parent_device = original.parent_device;
+    this->source = original.source;
+    this->created_from_binary = false;
 
-    // Throw if build did not succeed
-    if(build_status != CL_BUILD_SUCCESS)
+    if(built_program)
     {
-        HPX_THROW_EXCEPTION(hpx::no_success, function_name,
-                            std::string("A build error occured!") +
-                            acquire_build_log());
+        this->program_id = built_program;
+        return;
     }
-}
 
-struct build_callback_args{
-    hpx::runtime* rt;
-    hpx::lcos::local::promise<void>* promise;
-};
-
-static void CL_CALLBACK
-build_callback( cl_program program_id, void* user_data )
-{
-    // Cast arguments
-    build_callback_args* args =
-        static_cast<build_callback_args*>(user_data);
+    // The source is stored without its terminating zero
+    cl_int err;
+    const char* src_data = source.data();
+    std::size_t src_size = source.size();
+    program_id = clCreateProgramWithSource( parent_device->get_context(), 1,
+                                            &src_data, &src_size, &err );
+    cl_ensure(err, "clCreateProgramWithSource()");
 
-    // Send exec status to waiting future
-    using hpx::opencl::server::util::set_promise_from_external;
-    set_promise_from_external ( args->rt, args->promise );
 }
 
 void
-program::build(std::string options)
+program::adopt_built_program(cl_program built_program)
 {
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
 
-    cl_int err;
-
-    // fetch device id from parent device
-    cl_device_id device_id = parent_device->get_device_id();
-
-    // Create a new promise
-    hpx::lcos::local::promise<void> promise;
+    // The build service retained built_program for us. If an identical
+    // build was already running, we got the program of that build and
+    // drop our own, unbuilt one.
+    cl_int err = clReleaseProgram(program_id);
+    cl_ensure(err, "clReleaseProgram()");
 
-    // Retrieve the future
-    hpx::future<void> future = promise.get_future();
+    program_id = built_program;
+}
 
-    // Create args for build_callback
-    build_callback_args args;
-    args.rt = hpx::get_runtime_ptr();
-    args.promise = &promise;
+hpx::future<void>
+program::build(std::string options)
+{
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+    hpx::opencl::util::tracer::scope trace( "program::build",
+                                            "server" );
 
-    // Initialize compilation
-    err = clBuildProgram( program_id, 1, &device_id, options.c_str(),
-                          &build_callback, &args );
+    // Hand the compilation over to the build service.
+    // This does not block the current HPX worker.
+    hpx::future<cl_program> built_program =
+        util::build_service::get_instance().build(
+            parent_device->get_context(), parent_device->get_device_id(),
+            program_id, source, std::move(options) );
 
-    // ignore CL_BUILD_PROGRAM_FAILURE.
-    // we handle this case in throw_on_build_errors()
-    if(err != CL_BUILD_PROGRAM_FAILURE)
-        cl_ensure(err, "clBuildProgram()");
+    // Keep this component alive until the build finished
+    hpx::naming::id_type self = get_id();
 
-    // Wait for compilation to finish
-    future.wait();
+    // OpenCL calls only run properly on large stack size
+    hpx::threads::executors::default_executor exec(
+                                          hpx::threads::thread_priority_normal,
+                                          hpx::threads::thread_stacksize_medium);
 
-    // check build status
-    throw_on_build_errors("clBuildProgram()");
+    return built_program.then( exec,
+        [this, self](hpx::future<cl_program> && fut)
+        {
+            adopt_built_program(fut.get());
+        });
 
 }
 
@@ -295,21 +292,72 @@ program::get_binary()
 
 }
 
-hpx::naming::id_type
+hpx::future<hpx::naming::id_type>
 program::create_kernel(std::string kernel_name)
 {
 
     HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
 
-    // Create new kernel
-    hpx::id_type kernel = hpx::components::new_<hpx::opencl::server::kernel>
-                                                     ( hpx::find_here() ).get();
+    // Keep this component alive until the kernel is initialized
+    hpx::naming::id_type self = get_id();
+
+    return create_local_component<hpx::opencl::server::kernel>(
+        [this, self, kernel_name]
+        ( hpx::naming::id_type kernel,
+          std::shared_ptr<hpx::opencl::server::kernel> kernel_server )
+        {
+            kernel_server->init(parent_device_id, program_id, kernel_name);
+            return hpx::make_ready_future(std::move(kernel));
+        });
+
+}
+
+hpx::future<hpx::naming::id_type>
+program::specialize(std::string options)
+{
 
-    // Initialize kernel locally
-    auto kernel_server = hpx::get_ptr<hpx::opencl::server::kernel>(kernel).get();
+    HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
 
-    kernel_server->init(parent_device_id, program_id, kernel_name);
+    if(created_from_binary)
+    {
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "program::specialize()",
+                            "Only programs created from source can be "
+                            "specialized!");
+    }
 
-    return kernel;
+    // Keep this component alive until the variant is initialized
+    hpx::naming::id_type self = get_id();
+
+    return create_local_component<program>(
+        [this, self, options]
+        ( hpx::naming::id_type variant,
+          std::shared_ptr<program> variant_server )
+            -> hpx::future<hpx::naming::id_type>
+        {
+            cl_context context = parent_device->get_context();
+            cl_device_id device_id = parent_device->get_device_id();
+
+            // Reuse a cached build, if there is one
+            cl_program cached_program =
+                util::program_cache::get_instance().get( context, device_id,
+                                                         source, options );
+            variant_server->init_as_variant(*this, cached_program);
+            if(cached_program)
+                return hpx::make_ready_future(std::move(variant));
+
+            // Otherwise build the variant and add it to the cache
+            std::string src = source;
+            return variant_server->build(options).then( hpx::launch::sync,
+                [variant, variant_server, context, device_id, src, options]
+                (hpx::future<void> && fut) -> hpx::naming::id_type
+                {
+                    fut.get();
+                    util::program_cache::get_instance().insert(
+                        context, device_id, src, options,
+                        variant_server->program_id );
+                    return variant;
+                });
+        });
 
 }
+
@@ -0,0 +1,312 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "build_service.hpp"
+
+// HPXCL tools
+#include "../../tools.hpp"
+
+#include <hpx/runtime.hpp>
+
+#include <functional>
+#include <sstream>
+#include <utility>
+
+using hpx::opencl::server::util::build_service;
+
+
+build_service&
+build_service::get_instance()
+{
+    static build_service instance;
+    return instance;
+}
+
+build_service::build_service()
+  : running(false), stopped(false)
+{
+}
+
+build_service::~build_service()
+{
+    stop();
+}
+
+bool
+build_service::build_key::operator<(const build_key& other) const
+{
+    if(context != other.context) return context < other.context;
+    if(device_id != other.device_id) return device_id < other.device_id;
+    if(source_hash != other.source_hash)
+        return source_hash < other.source_hash;
+    if(options != other.options) return options < other.options;
+    return source < other.source;
+}
+
+void
+build_service::ensure_running()
+{
+    // needs to be called with the lock held
+    if(running)
+        return;
+
+    std::size_t num_threads = 2;
+    try {
+        num_threads = std::stoul(
+            hpx::get_config_entry("hpx.opencl.build_threads", "2"));
+    } catch (std::exception const&) {
+    }
+    if(num_threads < 1)
+        num_threads = 1;
+
+    threads.reserve(num_threads);
+    for(std::size_t i = 0; i < num_threads; i++)
+    {
+        threads.push_back(std::thread(&build_service::worker_main, this, i));
+    }
+
+    // The threads are registered with the HPX runtime, so they need to
+    // be gone before the runtime shuts down.
+    hpx::register_shutdown_function(
+        []{ build_service::get_instance().stop(); });
+
+    running = true;
+}
+
+void
+build_service::stop()
+{
+    std::vector<std::thread> threads_to_join;
+    std::deque<std::shared_ptr<build_job> > cancelled_jobs;
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if(stopped || !running) {
+            stopped = true;
+            return;
+        }
+        stopped = true;
+
+        threads_to_join = std::move(threads);
+        cancelled_jobs = std::move(queue);
+        for(const auto& job : cancelled_jobs)
+            jobs.erase(job->key);
+    }
+    cv.notify_all();
+
+    for(auto& thread : threads_to_join)
+        thread.join();
+
+    // Release the references held by the cancelled builds.
+    // The waiting futures get a broken_promise error.
+    for(const auto& job : cancelled_jobs)
+    {
+        cl_int err = clReleaseProgram(job->program_id);
+        cl_ensure_nothrow(err, "clReleaseProgram()");
+    }
+}
+
+hpx::future<cl_program>
+build_service::build( cl_context context, cl_device_id device_id,
+                      cl_program program_id, std::string source,
+                      std::string options )
+{
+    build_key key;
+    key.context = context;
+    key.device_id = device_id;
+    key.source_hash = std::hash<std::string>()(source);
+    key.source = std::move(source);
+    key.options = std::move(options);
+
+    hpx::lcos::local::promise<cl_program> promise;
+    hpx::future<cl_program> result = promise.get_future();
+
+    bool new_job = false;
+    {
+        std::lock_guard<std::mutex> lock(m);
+
+        if(stopped)
+        {
+            HPX_THROW_EXCEPTION(hpx::invalid_status, "build_service::build()",
+                                "The build service is already shut down!");
+        }
+
+        ensure_running();
+
+        // attach to an identical build, if one is in progress
+        auto it = jobs.find(key);
+        if(it != jobs.end())
+        {
+            it->second->promises.push_back(std::move(promise));
+        }
+        else
+        {
+            // keep the program alive while it gets built
+            cl_int err = clRetainProgram(program_id);
+            cl_ensure(err, "clRetainProgram()");
+
+            std::shared_ptr<build_job> job = std::make_shared<build_job>();
+            job->key = key;
+            job->program_id = program_id;
+            job->promises.push_back(std::move(promise));
+
+            jobs.insert(std::make_pair(std::move(key), job));
+            queue.push_back(std::move(job));
+            new_job = true;
+        }
+    }
+
+    if(new_job)
+        cv.notify_one();
+
+    return result;
+}
+
+void
+build_service::worker_main(std::size_t thread_num)
+{
+    // Register with HPX, as the waiting futures get set from this thread
+    hpx::runtime* rt = hpx::get_runtime_ptr();
+    rt->register_thread("opencl-build", thread_num, false);
+
+    while(true)
+    {
+        std::shared_ptr<build_job> job;
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [this]{ return stopped || !queue.empty(); });
+
+            if(stopped)
+                break;
+
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        run_job(std::move(job));
+    }
+
+    rt->unregister_thread();
+}
+
+void
+build_service::run_job(std::shared_ptr<build_job> job)
+{
+    std::exception_ptr error;
+
+    try {
+        cl_int err;
+
+        // Compile. Without a callback, clBuildProgram blocks this thread.
+        err = clBuildProgram( job->program_id, 1, &job->key.device_id,
+                              job->key.options.c_str(), NULL, NULL );
+
+        // A failed compilation is reported below, together with the
+        // build log, and reaches every waiter through its promise
+        if(err != CL_BUILD_PROGRAM_FAILURE)
+            cl_ensure(err, "clBuildProgram()");
+
+        throw_on_build_errors(job->program_id, job->key.device_id);
+
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // Remove the job from the deduplication map.
+    // After this point, no new waiters can attach to it.
+    std::vector<hpx::lcos::local::promise<cl_program> > promises;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        jobs.erase(job->key);
+        promises = std::move(job->promises);
+    }
+
+    for(auto& promise : promises)
+    {
+        if(error)
+        {
+            promise.set_exception(error);
+            continue;
+        }
+
+        // every waiter owns one reference
+        cl_int err = clRetainProgram(job->program_id);
+        if(err != CL_SUCCESS)
+        {
+            try {
+                cl_ensure(err, "clRetainProgram()");
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+            continue;
+        }
+        promise.set_value(job->program_id);
+    }
+
+    // Release the reference taken in build()
+    cl_int err = clReleaseProgram(job->program_id);
+    cl_ensure_nothrow(err, "clReleaseProgram()");
+}
+
+std::string
+build_service::acquire_build_log(cl_program program_id, cl_device_id device_id)
+{
+    cl_int err;
+
+    std::size_t build_log_size;
+
+    // Query size
+    err = clGetProgramBuildInfo(program_id, device_id,
+                                CL_PROGRAM_BUILD_LOG, 0, NULL, &build_log_size);
+    if(err != CL_SUCCESS)
+        return std::string();
+
+    // Create buffer
+    std::vector<char> buf(build_log_size + 1, '\0');
+
+    // Get log
+    err = clGetProgramBuildInfo(program_id, device_id,
+                                CL_PROGRAM_BUILD_LOG, build_log_size,
+                                buf.data(), NULL);
+
+    // make build log look nice in exception
+    std::stringstream sstream;
+    sstream << std::endl << std::endl;
+    sstream << "//////////////////////////////////////" << std::endl;
+    sstream << "/// OPENCL BUILD LOG" << std::endl;
+    sstream << "///" << std::endl;
+    sstream << std::endl << buf.data() << std::endl;
+    sstream << "///" << std::endl;
+    sstream << "/// OPENCL BUILD LOG END" << std::endl;
+    sstream << "//////////////////////////////////////" << std::endl;
+    sstream << std::endl;
+
+    // return the nice looking error string.
+    return sstream.str();
+
+}
+
+void
+build_service::throw_on_build_errors(cl_program program_id,
+                                     cl_device_id device_id)
+{
+    cl_int err;
+    cl_build_status build_status;
+
+    // Read build status
+    err = clGetProgramBuildInfo( program_id, device_id,
+                                 CL_PROGRAM_BUILD_STATUS,
+                                 sizeof(cl_build_status), &build_status, NULL );
+    cl_ensure(err, "clGetProgramBuildInfo()");
+
+    // Throw if build did not succeed
+    if(build_status != CL_BUILD_SUCCESS)
+    {
+        HPX_THROW_EXCEPTION(hpx::no_success, "clBuildProgram()",
+                            std::string("A build error occured!") +
+                            acquire_build_log(program_id, device_id));
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_UTIL_BUILD_SERVICE_HPP_
+#define HPX_OPENCL_SERVER_UTIL_BUILD_SERVICE_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../../export_definitions.hpp"
+#include "../../cl_headers.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{ namespace server{ namespace util{
+
+
+    ////////////////////////////////////////////////////////
+    // This class compiles OpenCL programs on dedicated OS threads.
+    //
+    // clBuildProgram can take seconds. The build service queues build
+    // requests and runs them on a small pool of OS threads, so that no
+    // HPX worker is occupied while the OpenCL compiler runs.
+    // Concurrent requests for identical builds
+    // (context, device, source, options) are merged into one compilation.
+    //
+    // The number of build threads is read from the configuration entry
+    // 'hpx.opencl.build_threads' (default: 2).
+    //
+    class HPX_OPENCL_EXPORT build_service
+    {
+    public:
+        // Returns the build service of this locality
+        static build_service& get_instance();
+
+        ~build_service();
+
+        // Queues the build of 'program_id'.
+        //
+        // 'source' is the source or binary the program was created from.
+        // It is only used to detect identical builds.
+        //
+        // The future returns the built program. This is either
+        // 'program_id' or, if an identical build was already in progress,
+        // the program of that build. In both cases the returned cl_program
+        // got retained once for the caller.
+        hpx::future<cl_program> build( cl_context context,
+                                       cl_device_id device_id,
+                                       cl_program program_id,
+                                       std::string source,
+                                       std::string options );
+
+        // Stops all build threads. Queued builds get cancelled.
+        void stop();
+
+    private:
+        build_service();
+
+        // Identifies a build
+        struct build_key
+        {
+            cl_context context;
+            cl_device_id device_id;
+            std::size_t source_hash;
+            std::string source;
+            std::string options;
+
+            bool operator<(const build_key& other) const;
+        };
+
+        // A queued or running build
+        struct build_job
+        {
+            build_key key;
+            cl_program program_id;
+            std::vector<hpx::lcos::local::promise<cl_program> > promises;
+        };
+
+        // Starts the build threads on first use
+        void ensure_running();
+
+        // The main loop of a build thread
+        void worker_main(std::size_t thread_num);
+
+        // Runs the compilation and notifies all waiting futures
+        void run_job(std::shared_ptr<build_job> job);
+
+        // Throws if the build failed, including the build log
+        static void throw_on_build_errors(cl_program program_id,
+                                          cl_device_id device_id);
+
+        // Returns the build log
+        static std::string acquire_build_log(cl_program program_id,
+                                             cl_device_id device_id);
+
+    private:
+        ///////////////////////////////////////////////
+        // Private Member Variables
+        //
+
+        // Protects all members below.
+        // The build threads are plain OS threads, so this needs to be an
+        // OS level mutex.
+        std::mutex m;
+        std::condition_variable cv;
+
+        // The builds that have not been started yet
+        std::deque<std::shared_ptr<build_job> > queue;
+
+        // All queued or running builds, for deduplication
+        std::map<build_key, std::shared_ptr<build_job> > jobs;
+
+        // The build threads
+        std::vector<std::thread> threads;
+        bool running;
+        bool stopped;
+
+    };
+}}}}
+
+#endif
@@ -0,0 +1,92 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "core_budget.hpp"
+
+// HPXCL tools
+#include "../../tools.hpp"
+
+#include <cstdlib>
+#include <mutex>
+#include <string>
+
+using hpx::opencl::server::util::core_budget;
+
+
+static std::size_t read_reserved_cores()
+{
+    std::size_t num_cores = 0;
+    try {
+        num_cores = std::stoul(
+            hpx::get_config_entry("hpx.opencl.cpu_cores", "0"));
+    } catch (std::exception const&) {
+    }
+    return num_cores;
+}
+
+std::size_t
+core_budget::reserved_cores()
+{
+    static std::size_t num_cores = read_reserved_cores();
+    return num_cores;
+}
+
+static void set_environment(const char* name, const std::string& value)
+{
+#if defined(HPX_WINDOWS)
+    if(std::getenv(name) == NULL)
+        _putenv_s(name, value.c_str());
+#else
+    setenv(name, value.c_str(), 0);
+#endif
+}
+
+void
+core_budget::apply()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []{
+
+        std::size_t num_cores = reserved_cores();
+        if(num_cores == 0)
+            return;
+
+        std::string value = std::to_string(num_cores);
+
+        // POCL, pthread driver and its successor
+        set_environment("POCL_MAX_PTHREAD_COUNT", value);
+        set_environment("POCL_CPU_MAX_CU_COUNT", value);
+
+        // Pins POCL thread i to processing unit i, so the POCL threads
+        // use the first processing units. These are only free of HPX
+        // workers if HPX got started with the matching pu_offset, see
+        // hpx::opencl::core_budget_configuration().
+        set_environment("POCL_AFFINITY", "1");
+
+    });
+}
+
+bool
+core_budget::uses_sub_devices()
+{
+    static bool enabled = reserved_cores() != 0 &&
+        hpx::get_config_entry("hpx.opencl.cpu_cores_subdevice", "0") == "1";
+    return enabled;
+}
+
+bool
+core_budget::applies_to(cl_device_id device_id)
+{
+    if(reserved_cores() == 0)
+        return false;
+
+    cl_device_type device_type;
+    cl_int err = clGetDeviceInfo(device_id, CL_DEVICE_TYPE,
+                                 sizeof(device_type), &device_type, NULL);
+    cl_ensure(err, "clGetDeviceInfo()");
+
+    return (device_type & CL_DEVICE_TYPE_CPU) != 0;
+}
@@ -0,0 +1,63 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_UTIL_CORE_BUDGET_HPP_
+#define HPX_OPENCL_SERVER_UTIL_CORE_BUDGET_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../../export_definitions.hpp"
+#include "../../cl_headers.hpp"
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{ namespace server{ namespace util{
+
+
+    ////////////////////////////////////////////////////////
+    // This class limits the cores used by CPU OpenCL runtimes.
+    //
+    // On CPU devices, the worker threads of the OpenCL runtime compete
+    // with the HPX worker threads for the same cores. The configuration
+    // entry 'hpx.opencl.cpu_cores' (default: 0, no limit) reserves a
+    // number of processing units for the OpenCL runtime. The OpenCL side
+    // gets limited with the controls the runtime offers:
+    //
+    //  - The thread count environment variables of POCL. They need to be
+    //    set before the first OpenCL call, which is why apply() gets called
+    //    at the start of create_devices.
+    //  - Only if 'hpx.opencl.cpu_cores_subdevice' is set to 1: a
+    //    sub-device with the reserved number of compute units replaces
+    //    every unpartitioned CPU device, on runtimes that support
+    //    CL_DEVICE_PARTITION_BY_COUNTS.
+    //
+    // The HPX side can't be changed at runtime. hpx::opencl::
+    // core_budget_configuration() creates the configuration that pins the
+    // HPX workers to the remaining processing units.
+    //
+    class HPX_OPENCL_EXPORT core_budget
+    {
+    public:
+        // Returns the number of reserved processing units, 0 if disabled
+        static std::size_t reserved_cores();
+
+        // Sets the environment variables of the OpenCL runtimes.
+        // Only the first call has an effect, variables that are already set
+        // are not overwritten.
+        static void apply();
+
+        // Returns whether the budget applies to the given device
+        static bool applies_to(cl_device_id device_id);
+
+        // Returns whether CPU devices get replaced by a sub-device with
+        // the reserved number of compute units
+        static bool uses_sub_devices();
+    };
+}}}}
+
+#endif
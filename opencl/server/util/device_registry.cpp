@@ -0,0 +1,160 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "device_registry.hpp"
+
+// HPXCL tools
+#include "../../tools.hpp"
+
+#include <mutex>
+#include <utility>
+
+using hpx::opencl::server::util::device_registry;
+
+
+device_registry&
+device_registry::get_instance()
+{
+    static device_registry instance;
+    return instance;
+}
+
+device_registry::device_registry()
+{
+    // The devices need to be destroyed while the runtime is still running
+    hpx::register_shutdown_function(
+        []{ device_registry::get_instance().clear(); });
+}
+
+device_registry::~device_registry()
+{
+    // Correct use clears the registry on shutdown
+    HPX_ASSERT(map.empty());
+}
+
+bool
+device_registry::registry_key::operator<(const registry_key& other) const
+{
+    if(device_id != other.device_id) return device_id < other.device_id;
+    if(partition_type != other.partition_type)
+        return partition_type < other.partition_type;
+    return compute_units < other.compute_units;
+}
+
+hpx::shared_future<std::vector<hpx::opencl::device> >
+device_registry::acquire( cl_device_id device_id,
+                          const hpx::opencl::device_partition & partition,
+                          creator_type && create )
+{
+    registry_key key;
+    key.device_id = device_id;
+    key.partition_type = partition.type;
+    key.compute_units = partition.compute_units;
+
+    // The first caller creates the devices, all others share them
+    std::shared_ptr<hpx::lcos::local::promise<
+        std::vector<hpx::opencl::device> > > promise;
+    hpx::shared_future<std::vector<hpx::opencl::device> > devices;
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+
+        map_type::iterator it = map.find(key);
+        if(it != map.end())
+        {
+            it->second.refcount++;
+            return it->second.devices;
+        }
+
+        promise = std::make_shared<hpx::lcos::local::promise<
+                        std::vector<hpx::opencl::device> > >();
+
+        registry_entry entry;
+        entry.refcount = 1;
+        entry.devices = promise->get_future().share();
+        devices = entry.devices;
+
+        map.insert(std::make_pair(key, std::move(entry)));
+    }
+
+    // Create the devices outside of the lock
+    hpx::future<std::vector<hpx::opencl::device> > created;
+    try {
+        created = create();
+    } catch (...) {
+        created = hpx::make_exceptional_future<
+                      std::vector<hpx::opencl::device> >(
+                          std::current_exception());
+    }
+
+    created.then( hpx::launch::sync,
+        [this, key, promise](
+            hpx::future<std::vector<hpx::opencl::device> > && f)
+        {
+            try {
+                promise->set_value(f.get());
+            } catch (...) {
+                // Failed creations are not kept, the next call retries
+                {
+                    std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+                    map.erase(key);
+                }
+                promise->set_exception(std::current_exception());
+            }
+        });
+
+    return devices;
+}
+
+void
+device_registry::release( const std::vector<hpx::naming::id_type> & device_ids )
+{
+    // Destroy the devices outside of the lock
+    std::vector<hpx::shared_future<std::vector<hpx::opencl::device> > >
+        released;
+
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+
+        for(map_type::iterator it = map.begin(); it != map.end();)
+        {
+            // Entries that are still being created can't be released yet
+            bool contains_device = false;
+            if(it->second.devices.is_ready() &&
+               !it->second.devices.has_exception())
+            {
+                for(const auto & dev : it->second.devices.get())
+                {
+                    for(const auto & id : device_ids)
+                    {
+                        if(dev.get_id() == id)
+                            contains_device = true;
+                    }
+                }
+            }
+
+            if(contains_device && --it->second.refcount == 0)
+            {
+                released.push_back(std::move(it->second.devices));
+                it = map.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+void
+device_registry::clear()
+{
+    // Destroy the devices outside of the lock
+    map_type entries;
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+        std::swap(entries, map);
+    }
+}
@@ -0,0 +1,99 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_UTIL_DEVICE_REGISTRY_HPP_
+#define HPX_OPENCL_SERVER_UTIL_DEVICE_REGISTRY_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../../export_definitions.hpp"
+#include "../../cl_headers.hpp"
+
+#include "../../device.hpp"
+#include "../../create_devices.hpp"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{ namespace server{ namespace util{
+
+
+    ////////////////////////////////////////////////////////
+    // This class shares device components between create_devices calls.
+    //
+    // Every OpenCL device gets only one set of device components per
+    // partition, no matter how often create_devices gets called. This keeps
+    // all users of a device in one context.
+    //
+    // Entries are reference counted. Every create_devices call that
+    // returns an entry counts as one reference, release_devices drops one.
+    // The registry keeps the device components alive until the last
+    // reference is gone, or until shutdown.
+    //
+    class HPX_OPENCL_EXPORT device_registry
+    {
+    public:
+        typedef std::function<
+            hpx::future<std::vector<hpx::opencl::device> >()> creator_type;
+
+    public:
+        // Returns the device registry of this locality
+        static device_registry& get_instance();
+
+        ~device_registry();
+
+        // Returns the devices of an OpenCL device and partition.
+        // Calls 'create' if they don't exist yet. Concurrent calls for the
+        // same devices wait for the first one.
+        hpx::shared_future<std::vector<hpx::opencl::device> >
+        acquire( cl_device_id device_id,
+                 const hpx::opencl::device_partition & partition,
+                 creator_type && create );
+
+        // Drops one reference of every entry that contains one of the
+        // given devices
+        void release( const std::vector<hpx::naming::id_type> & device_ids );
+
+        // Drops all entries
+        void clear();
+
+    private:
+        device_registry();
+
+        struct registry_key
+        {
+            cl_device_id device_id;
+            int partition_type;
+            cl_uint compute_units;
+
+            bool operator<(const registry_key& other) const;
+        };
+
+        struct registry_entry
+        {
+            std::size_t refcount;
+            hpx::shared_future<std::vector<hpx::opencl::device> > devices;
+        };
+
+        typedef std::map<registry_key, registry_entry> map_type;
+
+    private:
+        ///////////////////////////////////////////////
+        // Private Member Variables
+        //
+        map_type map;
+
+        // Lock for synchronization
+        hpx::lcos::local::spinlock lock;
+
+    };
+}}}}
+
+#endif
@@ -0,0 +1,365 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "device_statistics.hpp"
+
+#include "../../util/tracer.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+using hpx::opencl::server::util::device_statistics;
+
+
+// The statistics of all devices of this locality, by device index
+namespace {
+    struct statistics_list
+    {
+        hpx::lcos::local::spinlock lock;
+        std::vector<std::unique_ptr<device_statistics> > devices;
+    };
+
+    statistics_list& get_statistics_list()
+    {
+        static statistics_list list;
+        return list;
+    }
+
+    // The pending commands get polled at the latest when they grow
+    // beyond this
+    const std::size_t min_collect = 1024;
+
+    bool get_track_completions()
+    {
+        return hpx::get_config_entry("hpx.opencl.track_commands", "0") == "1"
+            || hpx::get_config_entry("hpx.opencl.profiling", "0") == "1";
+    }
+
+    // The trace names of the command types
+    const char* const command_names[] = {
+        "read",
+        "write",
+        "send",
+        "kernel"
+    };
+
+    // Reads the profiling timestamps of a completed command. Only
+    // available if the command queue has profiling enabled.
+    bool get_command_times( cl_event event, cl_ulong & queued,
+                            cl_ulong & start, cl_ulong & end )
+    {
+        cl_int err = clGetEventProfilingInfo( event,
+                                              CL_PROFILING_COMMAND_QUEUED,
+                                              sizeof(cl_ulong), &queued, NULL );
+        if(err == CL_SUCCESS)
+            err = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_START,
+                                           sizeof(cl_ulong), &start, NULL );
+        if(err == CL_SUCCESS)
+            err = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_END,
+                                           sizeof(cl_ulong), &end, NULL );
+        return err == CL_SUCCESS && end >= start && start >= queued;
+    }
+
+    void update_min( std::atomic<std::uint64_t> & counter,
+                     std::uint64_t value )
+    {
+        std::uint64_t current = counter.load(std::memory_order_relaxed);
+        while(value < current &&
+              !counter.compare_exchange_weak(current, value,
+                                             std::memory_order_relaxed))
+        {}
+    }
+
+    void update_max( std::atomic<std::uint64_t> & counter,
+                     std::uint64_t value )
+    {
+        std::uint64_t current = counter.load(std::memory_order_relaxed);
+        while(value > current &&
+              !counter.compare_exchange_weak(current, value,
+                                             std::memory_order_relaxed))
+        {}
+    }
+}
+
+device_statistics::kernel_statistics::kernel_statistics(
+    device_statistics* device_, const char* name_ )
+  : device(device_), name(name_), launches(0), profiled_launches(0), total_time(0),
+    min_time(std::numeric_limits<std::uint64_t>::max()), max_time(0),
+    total_queue_delay(0)
+{}
+
+device_statistics::device_statistics(std::size_t index_)
+  : index(index_), track_completions(get_track_completions()),
+    next_collect(min_collect),
+    commands_tracked(0), commands_completed(0), events(0),
+    bytes_read(0), bytes_written(0), bytes_sent(0),
+    kernel_time(0), buffer_bytes(0), wait_time(0)
+{
+    for(std::size_t i = 0; i < num_command_types; i++)
+        commands_enqueued[i].store(0, std::memory_order_relaxed);
+}
+
+device_statistics*
+device_statistics::create()
+{
+    statistics_list& list = get_statistics_list();
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(list.lock);
+
+    std::unique_ptr<device_statistics> statistics(
+        new device_statistics(list.devices.size()));
+    device_statistics* result = statistics.get();
+    list.devices.push_back(std::move(statistics));
+
+    return result;
+}
+
+device_statistics*
+device_statistics::get(std::size_t index)
+{
+    statistics_list& list = get_statistics_list();
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(list.lock);
+    if(index >= list.devices.size())
+        return NULL;
+    return list.devices[index].get();
+}
+
+std::size_t
+device_statistics::num_devices()
+{
+    statistics_list& list = get_statistics_list();
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(list.lock);
+    return list.devices.size();
+}
+
+void
+device_statistics::count_command( command_type type, std::uint64_t bytes )
+{
+    add(commands_enqueued[type], 1);
+
+    switch(type)
+    {
+        case command_read:  add(bytes_read, bytes);    break;
+        case command_write: add(bytes_written, bytes); break;
+        case command_send:  add(bytes_sent, bytes);    break;
+        default: break;
+    }
+}
+
+void
+device_statistics::command_enqueued( command_type type, cl_event event,
+                                     std::uint64_t bytes,
+                                     const hpx::naming::gid_type & event_gid )
+{
+    count_command(type, bytes);
+
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::command_submitted(command_names[type],
+                                                     index, event, event_gid);
+
+    if(event == NULL || !track_completions)
+        return;
+
+    track_command(event, type, NULL);
+}
+
+void
+device_statistics::track_command( cl_event event, command_type type,
+                                  kernel_statistics* kernel )
+{
+    add(commands_tracked, 1);
+
+    // Statistics must not fail the command. Without a reference, the
+    // command must not look in flight forever.
+    if(clRetainEvent(event) != CL_SUCCESS)
+    {
+        add(commands_completed, 1);
+        return;
+    }
+
+    pending_command command;
+    command.type = type;
+    command.kernel = kernel;
+
+    bool collect;
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(pending_lock);
+        pending[event] = command;
+        collect = pending.size() >= next_collect;
+    }
+
+    // Commands that nobody waits for would pile up otherwise
+    if(collect)
+        collect_completed();
+}
+
+void
+device_statistics::command_observed( cl_event event, cl_int execution_state )
+{
+    if(!track_completions ||
+       (execution_state != CL_COMPLETE && execution_state >= 0))
+        return;
+
+    pending_command command;
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(pending_lock);
+
+        auto it = pending.find(event);
+        if(it == pending.end())
+            return;
+
+        command = it->second;
+        pending.erase(it);
+    }
+
+    complete_command(event, command, execution_state);
+}
+
+void
+device_statistics::collect_completed()
+{
+    if(!track_completions)
+        return;
+
+    // Takes all pending commands, so that no one else completes them
+    // while their events get polled
+    std::unordered_map<cl_event, pending_command> polled;
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(pending_lock);
+        polled.swap(pending);
+    }
+
+    std::vector<std::pair<cl_event, pending_command> > running;
+    for(const auto & entry : polled)
+    {
+        cl_int execution_state;
+        cl_int err = clGetEventInfo( entry.first,
+                                     CL_EVENT_COMMAND_EXECUTION_STATUS,
+                                     sizeof(cl_int), &execution_state, NULL );
+        if(err != CL_SUCCESS)
+            execution_state = err;
+
+        if(execution_state == CL_COMPLETE || execution_state < 0)
+            complete_command(entry.first, entry.second, execution_state);
+        else
+            running.push_back(entry);
+    }
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(pending_lock);
+    pending.insert(running.begin(), running.end());
+
+    // amortizes the polling over the commands enqueued in between
+    next_collect = (std::max)(min_collect, 2 * pending.size());
+}
+
+void
+device_statistics::complete_command( cl_event event,
+                                     const pending_command& command,
+                                     cl_int execution_state )
+{
+    // Only available if the command queue has profiling enabled
+    cl_ulong queued, start, end;
+    if(command.type == command_kernel && execution_state == CL_COMPLETE &&
+       get_command_times(event, queued, start, end))
+    {
+        std::uint64_t time = end - start;
+
+        add(kernel_time, time);
+
+        if(command.kernel != NULL)
+        {
+            kernel_statistics* kernel = command.kernel;
+
+            add(kernel->total_time, time);
+            add(kernel->total_queue_delay, start - queued);
+            update_min(kernel->min_time, time);
+            update_max(kernel->max_time, time);
+
+            // count last, so profiled launches never lack their times
+            add(kernel->profiled_launches, 1);
+        }
+    }
+
+    add(commands_completed, 1);
+
+    clReleaseEvent(event);
+}
+
+device_statistics::kernel_statistics*
+device_statistics::get_kernel_statistics( const std::string& name )
+{
+    std::lock_guard<hpx::lcos::local::spinlock> guard(kernels_lock);
+
+    auto it = kernels.find(name);
+    if(it == kernels.end())
+    {
+        it = kernels.insert(std::make_pair(name,
+                            std::unique_ptr<kernel_statistics>())).first;
+
+        // the key of the map is stable, the tracer refers to it
+        it->second.reset(new kernel_statistics(this, it->first.c_str()));
+    }
+
+    return it->second.get();
+}
+
+void
+device_statistics::kernel_enqueued( cl_event event, kernel_statistics* kernel,
+                                    const hpx::naming::gid_type & event_gid )
+{
+    HPX_ASSERT(kernel && kernel->device == this);
+
+    count_command(command_kernel, 0);
+    add(kernel->launches, 1);
+
+    if(hpx::opencl::util::tracer::enabled())
+        hpx::opencl::util::tracer::command_submitted(kernel->name, index,
+                                                     event, event_gid);
+
+    if(event == NULL || !track_completions)
+        return;
+
+    // Kernel statistics live as long as the device statistics
+    track_command(event, command_kernel, kernel);
+}
+
+std::vector<hpx::opencl::kernel_profile>
+device_statistics::get_kernel_profiles()
+{
+    std::vector<hpx::opencl::kernel_profile> profiles;
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(kernels_lock);
+    profiles.reserve(kernels.size());
+
+    for(const auto & entry : kernels)
+    {
+        const kernel_statistics & kernel = *entry.second;
+
+        hpx::opencl::kernel_profile profile;
+        profile.name = entry.first;
+        profile.launches = kernel.launches.load(std::memory_order_relaxed);
+        profile.profiled_launches =
+            kernel.profiled_launches.load(std::memory_order_relaxed);
+        profile.total_time = kernel.total_time.load(std::memory_order_relaxed);
+        profile.max_time = kernel.max_time.load(std::memory_order_relaxed);
+        profile.total_queue_delay =
+            kernel.total_queue_delay.load(std::memory_order_relaxed);
+
+        // min_time starts at its maximum
+        if(profile.profiled_launches > 0)
+            profile.min_time = kernel.min_time.load(std::memory_order_relaxed);
+
+        profiles.push_back(std::move(profile));
+    }
+
+    return profiles;
+}
@@ -0,0 +1,218 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_UTIL_DEVICE_STATISTICS_HPP_
+#define HPX_OPENCL_SERVER_UTIL_DEVICE_STATISTICS_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../../export_definitions.hpp"
+#include "../../cl_headers.hpp"
+#include "../../profiling.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{ namespace server{ namespace util{
+
+
+    ////////////////////////////////////////////////////////
+    // The statistics of one device, exposed as performance counters.
+    //
+    // The members get updated with relaxed atomics. They are independent
+    // of each other; a reader sees each value on its own, not a
+    // consistent snapshot of all of them.
+    //
+    // Statistics are never destroyed. Every device of a locality gets an
+    // index in the order create_devices found it, which is the device
+    // instance of its performance counters. Counters of devices that are
+    // gone keep their last values.
+    //
+    // Enqueuing a command only increments relaxed atomics. Tracking the
+    // completions needs a reference to every event, so it is opt-in with
+    // hpx.opencl.track_commands=1, and implied by hpx.opencl.profiling=1 for
+    // the kernel times. Tracked commands stay pending until
+    // device::wait_for_cl_event sees them complete, or until
+    // collect_completed() polls them on finish() and once they pile up.
+    //
+    class HPX_OPENCL_EXPORT device_statistics
+    {
+    public:
+        enum command_type {
+            command_read = 0,
+            command_write,
+            command_send,
+            command_kernel,
+            num_command_types
+        };
+
+        // The statistics of the kernels with one name. The times need
+        // a command queue with profiling enabled.
+        struct kernel_statistics
+        {
+            kernel_statistics( device_statistics* device, const char* name );
+
+            device_statistics* device;
+
+            // Lives as long as the statistics
+            const char* name;
+
+            std::atomic<std::uint64_t> launches;
+            std::atomic<std::uint64_t> profiled_launches;
+            std::atomic<std::uint64_t> total_time;
+            std::atomic<std::uint64_t> min_time;
+            std::atomic<std::uint64_t> max_time;
+            std::atomic<std::uint64_t> total_queue_delay;
+        };
+
+    public:
+        // Creates the statistics of a new device
+        static device_statistics* create();
+
+        // Returns the statistics of a device index, NULL if there is no
+        // such device (yet)
+        static device_statistics* get(std::size_t index);
+
+        // Returns the number of devices of this locality
+        static std::size_t num_devices();
+
+        // Returns the index of this device
+        std::size_t get_index() const
+        {
+            return index;
+        }
+
+        // Returns whether the completions of the commands get tracked
+        bool tracks_completions() const
+        {
+            return track_completions;
+        }
+
+        // Counts an enqueued command and the bytes it transfers, and
+        // traces its submission together with its client event, if it
+        // has one.
+        // If completions get tracked, commands with a completion event
+        // count as in flight until their completion got observed. The
+        // completion of kernels adds their execution time, if the command
+        // queue has profiling enabled.
+        void command_enqueued( command_type type, cl_event event,
+                               std::uint64_t bytes = 0,
+                               const hpx::naming::gid_type & event_gid =
+                                   hpx::naming::gid_type() );
+
+        // Reports the state of an event that got waited for. Completes
+        // the command if the event belongs to a pending one.
+        void command_observed( cl_event event, cl_int execution_state );
+
+        // Polls the pending commands and completes the finished ones
+        void collect_completed();
+
+        // Returns the statistics of a kernel name. They live as long as
+        // the device statistics, kernels can keep the pointer.
+        kernel_statistics* get_kernel_statistics(const std::string& name);
+
+        // Counts an enqueued kernel, like command_enqueued. The completion
+        // adds to the statistics of its kernel name as well.
+        void kernel_enqueued( cl_event event, kernel_statistics* kernel,
+                              const hpx::naming::gid_type & event_gid =
+                                  hpx::naming::gid_type() );
+
+        // Returns the statistics of all kernel names
+        std::vector<hpx::opencl::kernel_profile> get_kernel_profiles();
+
+        // Adds to a counter
+        static void add( std::atomic<std::uint64_t> & counter,
+                         std::uint64_t value )
+        {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        static void add( std::atomic<std::int64_t> & counter,
+                         std::int64_t value )
+        {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        // Reads a counter
+        template<typename T>
+        static std::int64_t read( const std::atomic<T> & counter )
+        {
+            return static_cast<std::int64_t>(
+                counter.load(std::memory_order_relaxed));
+        }
+
+    private:
+        explicit device_statistics(std::size_t index);
+
+        // A command with a completion event that did not complete yet
+        struct pending_command
+        {
+            command_type type;
+            kernel_statistics* kernel;
+        };
+
+        // Counts an enqueued command without its completion
+        void count_command( command_type type, std::uint64_t bytes );
+
+        // Keeps a reference of the event until the completion got observed
+        void track_command( cl_event event, command_type type,
+                            kernel_statistics* kernel );
+
+        // Counts the completion and releases the event
+        void complete_command( cl_event event, const pending_command& command,
+                               cl_int execution_state );
+
+    private:
+        std::size_t index;
+        const bool track_completions;
+
+        hpx::lcos::local::spinlock kernels_lock;
+        std::map<std::string, std::unique_ptr<kernel_statistics> > kernels;
+
+        hpx::lcos::local::spinlock pending_lock;
+        std::unordered_map<cl_event, pending_command> pending;
+        // track_command() polls the pending commands once they grow
+        // beyond this
+        std::size_t next_collect;
+
+    public:
+        ///////////////////////////////////////////////
+        // The counters
+        //
+        std::atomic<std::uint64_t> commands_enqueued[num_command_types];
+
+        // Commands with a completion event, and how many of them completed
+        std::atomic<std::uint64_t> commands_tracked;
+        std::atomic<std::uint64_t> commands_completed;
+
+        // Entries of the event map
+        std::atomic<std::int64_t>  events;
+
+        std::atomic<std::uint64_t> bytes_read;
+        std::atomic<std::uint64_t> bytes_written;
+        std::atomic<std::uint64_t> bytes_sent;
+
+        // Execution time of the completed kernels, in nanoseconds
+        std::atomic<std::uint64_t> kernel_time;
+
+        // Device memory of the existing buffers, in bytes
+        std::atomic<std::int64_t>  buffer_bytes;
+
+        // Time spent in device::wait_for_cl_event, in nanoseconds
+        std::atomic<std::uint64_t> wait_time;
+
+    };
+}}}}
+
+#endif
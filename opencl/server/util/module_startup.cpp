@@ -0,0 +1,48 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "module_startup.hpp"
+
+// other hpxcl dependencies
+#include "performance_counters.hpp"
+#include "../../util/tracer.hpp"
+#include "../../launch_stages.hpp"
+#include "tuning_database.hpp"
+
+namespace {
+
+    void module_startup()
+    {
+        hpx::opencl::util::tracer::init();
+        hpx::opencl::detail::init_launch_stages();
+        hpx::opencl::server::util::install_performance_counters();
+    }
+
+    void module_shutdown()
+    {
+        hpx::opencl::util::tracer::shutdown();
+        hpx::opencl::server::util::tuning_database::get_instance().flush();
+    }
+}
+
+bool
+hpx::opencl::server::util::get_module_startup(
+    hpx::startup_function_type & startup, bool & pre_startup )
+{
+    startup = &module_startup;
+    pre_startup = true;
+    return true;
+}
+
+bool
+hpx::opencl::server::util::get_module_shutdown(
+    hpx::shutdown_function_type & shutdown, bool & pre_shutdown )
+{
+    // flush while the runtime is still fully up
+    shutdown = &module_shutdown;
+    pre_shutdown = true;
+    return true;
+}
@@ -0,0 +1,38 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_UTIL_MODULE_STARTUP_HPP_
+#define HPX_OPENCL_SERVER_UTIL_MODULE_STARTUP_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../../export_definitions.hpp"
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{ namespace server{ namespace util{
+
+
+    ////////////////////////////////////////////////////////
+    // The startup and shutdown functions of the component module, see
+    // HPX_REGISTER_STARTUP_SHUTDOWN_MODULE. They run on every locality.
+    //
+    // Startup installs the performance counters and reads the tracer and
+    // launch stage configuration. Shutdown flushes the trace and the tuning
+    // database.
+    //
+
+    HPX_OPENCL_EXPORT bool
+    get_module_startup( hpx::startup_function_type & startup,
+                        bool & pre_startup );
+
+    HPX_OPENCL_EXPORT bool
+    get_module_shutdown( hpx::shutdown_function_type & shutdown,
+                         bool & pre_shutdown );
+
+}}}}
+
+#endif
@@ -0,0 +1,238 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "performance_counters.hpp"
+
+// other hpxcl dependencies
+#include "device_statistics.hpp"
+
+// HPX dependencies
+#include <hpx/include/performance_counters.hpp>
+
+#include <cstdint>
+#include <string>
+
+using hpx::opencl::server::util::device_statistics;
+
+namespace counters = hpx::performance_counters;
+
+
+// Reads one statistic of a device
+typedef std::int64_t (*statistic_reader)(const device_statistics&);
+
+namespace {
+
+    std::int64_t read_enqueued_reads(const device_statistics& s)
+    {
+        return device_statistics::read(
+            s.commands_enqueued[device_statistics::command_read]);
+    }
+
+    std::int64_t read_enqueued_writes(const device_statistics& s)
+    {
+        return device_statistics::read(
+            s.commands_enqueued[device_statistics::command_write]);
+    }
+
+    std::int64_t read_enqueued_sends(const device_statistics& s)
+    {
+        return device_statistics::read(
+            s.commands_enqueued[device_statistics::command_send]);
+    }
+
+    std::int64_t read_enqueued_kernels(const device_statistics& s)
+    {
+        return device_statistics::read(
+            s.commands_enqueued[device_statistics::command_kernel]);
+    }
+
+    std::int64_t read_commands_in_flight(const device_statistics& s)
+    {
+        // read the completed ones first, so the result can't get negative
+        std::int64_t completed = device_statistics::read(s.commands_completed);
+        return device_statistics::read(s.commands_tracked) - completed;
+    }
+
+    std::int64_t read_events(const device_statistics& s)
+    {
+        return device_statistics::read(s.events);
+    }
+
+    std::int64_t read_bytes_read(const device_statistics& s)
+    {
+        return device_statistics::read(s.bytes_read);
+    }
+
+    std::int64_t read_bytes_written(const device_statistics& s)
+    {
+        return device_statistics::read(s.bytes_written);
+    }
+
+    std::int64_t read_bytes_sent(const device_statistics& s)
+    {
+        return device_statistics::read(s.bytes_sent);
+    }
+
+    std::int64_t read_kernel_time(const device_statistics& s)
+    {
+        return device_statistics::read(s.kernel_time);
+    }
+
+    std::int64_t read_buffer_bytes(const device_statistics& s)
+    {
+        return device_statistics::read(s.buffer_bytes);
+    }
+
+    std::int64_t read_wait_time(const device_statistics& s)
+    {
+        return device_statistics::read(s.wait_time);
+    }
+
+    struct counter_description
+    {
+        const char* name;
+        const char* helptext;
+        const char* unit;
+        statistic_reader reader;
+    };
+
+    const counter_description counter_descriptions[] = {
+        { "/opencl/commands/enqueued/read",
+          "returns the number of read commands enqueued on the device",
+          "", &read_enqueued_reads },
+        { "/opencl/commands/enqueued/write",
+          "returns the number of write commands enqueued on the device",
+          "", &read_enqueued_writes },
+        { "/opencl/commands/enqueued/send",
+          "returns the number of send commands enqueued on the device",
+          "", &read_enqueued_sends },
+        { "/opencl/commands/enqueued/kernel",
+          "returns the number of kernels enqueued on the device",
+          "", &read_enqueued_kernels },
+        { "/opencl/commands/in_flight",
+          "returns the number of commands with a completion event that did "
+          "not complete yet, needs hpx.opencl.track_commands=1",
+          "", &read_commands_in_flight },
+        { "/opencl/events/count",
+          "returns the number of events registered at the device",
+          "", &read_events },
+        { "/opencl/data/read",
+          "returns the number of bytes read from the device",
+          "bytes", &read_bytes_read },
+        { "/opencl/data/written",
+          "returns the number of bytes written to the device",
+          "bytes", &read_bytes_written },
+        { "/opencl/data/sent",
+          "returns the number of bytes sent from the device to other buffers",
+          "bytes", &read_bytes_sent },
+        { "/opencl/kernels/time",
+          "returns the cumulative execution time of the kernels of the "
+          "device, needs hpx.opencl.profiling=1",
+          "ns", &read_kernel_time },
+        { "/opencl/buffers/allocated",
+          "returns the number of bytes allocated by the buffers of the device",
+          "bytes", &read_buffer_bytes },
+        { "/opencl/wait/time",
+          "returns the time HPX threads spent waiting for commands of the "
+          "device",
+          "ns", &read_wait_time }
+    };
+
+    // Creates the counter of one device
+    hpx::naming::gid_type
+    create_device_counter( counters::counter_info const& info,
+                           hpx::error_code& ec,
+                           statistic_reader reader )
+    {
+        counters::counter_path_elements paths;
+        counters::get_counter_path_elements(info.fullname_, paths, ec);
+        if(ec)
+            return hpx::naming::invalid_gid;
+
+        if(paths.parentinstance_is_basename_ ||
+           paths.parentinstancename_ != "locality" ||
+           paths.parentinstanceindex_ !=
+                static_cast<std::int64_t>(hpx::get_locality_id()) ||
+           paths.instancename_ != "device" ||
+           paths.instanceindex_ < 0)
+        {
+            HPX_THROWS_IF(ec, hpx::bad_parameter,
+                "hpx::opencl::server::util::create_device_counter",
+                "invalid counter instance name, expected "
+                "'locality#<this locality>/device#<index>': " + info.fullname_);
+            return hpx::naming::invalid_gid;
+        }
+
+        // The device might not exist yet, look it up on every evaluation
+        std::size_t index = static_cast<std::size_t>(paths.instanceindex_);
+        return counters::detail::create_raw_counter(info,
+            [index, reader](bool reset) -> std::int64_t
+            {
+                // Only reads the atomics, never polls the driver
+                device_statistics* statistics = device_statistics::get(index);
+                if(statistics == NULL)
+                    return 0;
+
+                return reader(*statistics);
+            }, ec);
+    }
+
+    // Lists the counters of all devices of this locality
+    bool
+    discover_device_counters( counters::counter_info const& info,
+                              counters::discover_counter_func const& f,
+                              counters::discover_counters_mode mode,
+                              hpx::error_code& ec )
+    {
+        counters::counter_info device_info = info;
+
+        counters::counter_path_elements paths;
+        counters::counter_status status =
+            counters::get_counter_path_elements(info.fullname_, paths, ec);
+        if(!counters::status_is_valid(status))
+            return false;
+
+        paths.parentinstancename_ = "locality";
+        paths.parentinstanceindex_ =
+            static_cast<std::int64_t>(hpx::get_locality_id());
+        paths.parentinstance_is_basename_ = false;
+        paths.instancename_ = "device";
+
+        std::size_t num_devices = device_statistics::num_devices();
+        for(std::size_t i = 0; i < num_devices; i++)
+        {
+            paths.instanceindex_ = static_cast<std::int64_t>(i);
+
+            status = counters::get_counter_name(paths, device_info.fullname_,
+                                                ec);
+            if(!counters::status_is_valid(status) || !f(device_info, ec) || ec)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+void
+hpx::opencl::server::util::install_performance_counters()
+{
+    for(const counter_description & description : counter_descriptions)
+    {
+        statistic_reader reader = description.reader;
+        counters::install_counter_type(
+            description.name,
+            counters::counter_raw,
+            description.helptext,
+            [reader](counters::counter_info const& info,
+                     hpx::error_code& ec)
+            {
+                return create_device_counter(info, ec, reader);
+            },
+            &discover_device_counters,
+            HPX_PERFORMANCE_COUNTER_V1,
+            description.unit);
+    }
+}
@@ -0,0 +1,35 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_UTIL_PERFORMANCE_COUNTERS_HPP_
+#define HPX_OPENCL_SERVER_UTIL_PERFORMANCE_COUNTERS_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../../export_definitions.hpp"
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{ namespace server{ namespace util{
+
+
+    ////////////////////////////////////////////////////////
+    // The performance counters of the OpenCL devices.
+    //
+    // Every device statistic is a raw counter type with one instance per
+    // device, e.g. '/opencl{locality#0/device#1}/commands/enqueued/kernel'.
+    // Counters can be created before their device exists and read 0 until
+    // then. Devices get discovered when they exist; wildcards given at
+    // startup, e.g. with --hpx:print-counter, don't match any device yet.
+    //
+
+    // Installs the counter types. Runs as part of the startup function of
+    // the component module.
+    HPX_OPENCL_EXPORT void install_performance_counters();
+
+}}}}
+
+#endif
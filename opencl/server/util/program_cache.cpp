@@ -0,0 +1,139 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "program_cache.hpp"
+
+// HPXCL tools
+#include "../../tools.hpp"
+
+#include <functional>
+#include <utility>
+
+using hpx::opencl::server::util::program_cache;
+
+
+program_cache&
+program_cache::get_instance()
+{
+    static program_cache instance;
+    return instance;
+}
+
+program_cache::program_cache()
+  : max_size(64)
+{
+    try {
+        max_size = std::stoul(
+            hpx::get_config_entry("hpx.opencl.program_cache_size", "64"));
+    } catch (std::exception const&) {
+    }
+
+    // The cached programs need to be released while OpenCL is still
+    // available
+    hpx::register_shutdown_function(
+        []{ program_cache::get_instance().clear(); });
+}
+
+program_cache::~program_cache()
+{
+    // Correct use clears the cache on shutdown
+    HPX_ASSERT(map.empty());
+}
+
+bool
+program_cache::cache_key::operator<(const cache_key& other) const
+{
+    if(context != other.context) return context < other.context;
+    if(device_id != other.device_id) return device_id < other.device_id;
+    if(source_hash != other.source_hash)
+        return source_hash < other.source_hash;
+    if(options != other.options) return options < other.options;
+    return source < other.source;
+}
+
+program_cache::cache_key
+program_cache::make_key( cl_context context, cl_device_id device_id,
+                         const std::string& source,
+                         const std::string& options )
+{
+    cache_key key;
+    key.context = context;
+    key.device_id = device_id;
+    key.source_hash = std::hash<std::string>()(source);
+    key.source = source;
+    key.options = options;
+    return key;
+}
+
+cl_program
+program_cache::get( cl_context context, cl_device_id device_id,
+                    const std::string& source, const std::string& options )
+{
+    cache_key key = make_key(context, device_id, source, options);
+
+    std::lock_guard<hpx::compat::mutex> lock(m);
+
+    map_type::iterator it = map.find(key);
+    if(it == map.end())
+        return NULL;
+
+    // mark as most recently used
+    lru_list.splice(lru_list.begin(), lru_list, it->second);
+
+    cl_program program_id = it->second->second;
+    cl_int err = clRetainProgram(program_id);
+    cl_ensure(err, "clRetainProgram()");
+
+    return program_id;
+}
+
+void
+program_cache::insert( cl_context context, cl_device_id device_id,
+                       const std::string& source, const std::string& options,
+                       cl_program program_id )
+{
+    if(max_size == 0)
+        return;
+
+    cache_key key = make_key(context, device_id, source, options);
+
+    std::lock_guard<hpx::compat::mutex> lock(m);
+
+    // identical variants that got built concurrently end up here twice
+    if(map.count(key) > 0)
+        return;
+
+    cl_int err = clRetainProgram(program_id);
+    cl_ensure(err, "clRetainProgram()");
+
+    lru_list.push_front(std::make_pair(key, program_id));
+    map.insert(std::make_pair(std::move(key), lru_list.begin()));
+
+    // evict the least recently used entries
+    while(map.size() > max_size)
+    {
+        std::pair<cache_key, cl_program>& oldest = lru_list.back();
+        err = clReleaseProgram(oldest.second);
+        cl_ensure_nothrow(err, "clReleaseProgram()");
+        map.erase(oldest.first);
+        lru_list.pop_back();
+    }
+}
+
+void
+program_cache::clear()
+{
+    std::lock_guard<hpx::compat::mutex> lock(m);
+
+    for(const auto& entry : lru_list)
+    {
+        cl_int err = clReleaseProgram(entry.second);
+        cl_ensure_nothrow(err, "clReleaseProgram()");
+    }
+
+    lru_list.clear();
+    map.clear();
+}
@@ -0,0 +1,93 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_UTIL_PROGRAM_CACHE_HPP_
+#define HPX_OPENCL_SERVER_UTIL_PROGRAM_CACHE_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../../export_definitions.hpp"
+#include "../../cl_headers.hpp"
+
+#include <hpx/compat/mutex.hpp>
+
+#include <list>
+#include <map>
+#include <string>
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{ namespace server{ namespace util{
+
+
+    ////////////////////////////////////////////////////////
+    // This class caches built program variants.
+    //
+    // Entries are keyed by (context, device, source, build options) and
+    // evicted in least-recently-used order. The maximum number of entries is
+    // read from the configuration entry 'hpx.opencl.program_cache_size'
+    // (default: 64).
+    //
+    class HPX_OPENCL_EXPORT program_cache
+    {
+    public:
+        // Returns the program cache of this locality
+        static program_cache& get_instance();
+
+        ~program_cache();
+
+        // Returns the cached program, retained once for the caller.
+        // Returns NULL if no such program is cached.
+        cl_program get( cl_context context, cl_device_id device_id,
+                        const std::string& source,
+                        const std::string& options );
+
+        // Adds a built program to the cache.
+        // The cache retains the program.
+        void insert( cl_context context, cl_device_id device_id,
+                     const std::string& source, const std::string& options,
+                     cl_program program_id );
+
+        // Releases all cached programs
+        void clear();
+
+    private:
+        program_cache();
+
+        struct cache_key
+        {
+            cl_context context;
+            cl_device_id device_id;
+            std::size_t source_hash;
+            std::string source;
+            std::string options;
+
+            bool operator<(const cache_key& other) const;
+        };
+
+        static cache_key make_key( cl_context context, cl_device_id device_id,
+                                   const std::string& source,
+                                   const std::string& options );
+
+        // Most recently used entries are at the front
+        typedef std::list<std::pair<cache_key, cl_program> > lru_list_type;
+        typedef std::map<cache_key, lru_list_type::iterator> map_type;
+
+    private:
+        ///////////////////////////////////////////////
+        // Private Member Variables
+        //
+        lru_list_type lru_list;
+        map_type map;
+        std::size_t max_size;
+
+        // Lock for synchronization
+        hpx::compat::mutex m;
+
+    };
+}}}}
+
+#endif
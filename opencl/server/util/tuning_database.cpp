@@ -0,0 +1,165 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "tuning_database.hpp"
+
+#include <hpx/include/iostreams.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using hpx::opencl::server::util::tuning_database;
+
+
+// File format: one entry per line,
+//     <key>\t<local sizes separated by spaces, or '-' for driver default>
+static void read_entries( const std::string& filename,
+                          std::map<std::string,
+                                   std::vector<std::size_t> >& entries )
+{
+    std::ifstream file(filename.c_str());
+    std::string line;
+    while(std::getline(file, line))
+    {
+        std::size_t separator = line.rfind('\t');
+        if(separator == std::string::npos)
+            continue;
+
+        std::vector<std::size_t> local_size;
+        std::istringstream values(line.substr(separator + 1));
+        std::size_t value;
+        while(values >> value)
+            local_size.push_back(value);
+
+        entries[line.substr(0, separator)] = std::move(local_size);
+    }
+}
+
+
+tuning_database&
+tuning_database::get_instance()
+{
+    static tuning_database instance;
+    return instance;
+}
+
+tuning_database::tuning_database()
+  : filename(hpx::get_config_entry("hpx.opencl.tuning_database",
+                                   "hpxcl_tuning.db")),
+    loaded(false), flush_scheduled(false)
+{
+}
+
+bool
+tuning_database::lookup( const std::string& key,
+                         std::vector<std::size_t>& local_size )
+{
+    std::lock_guard<hpx::compat::mutex> lock(m);
+
+    ensure_loaded();
+
+    auto it = entries.find(key);
+    if(it == entries.end())
+        return false;
+
+    local_size = it->second;
+    return true;
+}
+
+void
+tuning_database::store( const std::string& key,
+                        const std::vector<std::size_t>& local_size )
+{
+    {
+        std::lock_guard<hpx::compat::mutex> lock(m);
+
+        ensure_loaded();
+
+        entries[key] = local_size;
+
+        if(filename.empty())
+            return;
+
+        unsaved[key] = local_size;
+
+        // Entries stored until the flush runs get written together
+        if(flush_scheduled)
+            return;
+        flush_scheduled = true;
+    }
+
+    hpx::apply(&tuning_database::flush, this);
+}
+
+void
+tuning_database::ensure_loaded()
+{
+    if(loaded)
+        return;
+    loaded = true;
+
+    if(filename.empty())
+        return;
+
+    read_entries(filename, entries);
+}
+
+void
+tuning_database::flush()
+{
+    std::lock_guard<hpx::compat::mutex> file_lock(file_mutex);
+
+    entry_map changes;
+    {
+        std::lock_guard<hpx::compat::mutex> lock(m);
+        changes.swap(unsaved);
+        flush_scheduled = false;
+    }
+
+    if(changes.empty())
+        return;
+
+    // keep the entries that other runs stored in the meantime
+    entry_map stored_entries;
+    read_entries(filename, stored_entries);
+    for(const auto& entry : changes)
+        stored_entries[entry.first] = entry.second;
+
+    // Write to a temporary file first, so that concurrent readers
+    // never see a partially written database. Localities on the same node
+    // share the file, so every locality needs its own temporary file.
+    std::string tmp_filename =
+        filename + "." + std::to_string(hpx::get_locality_id()) + ".tmp";
+    {
+        std::ofstream file(tmp_filename.c_str(), std::ios::trunc);
+        if(!file)
+        {
+            hpx::cerr << "tuning_database: unable to write '"
+                      << tmp_filename << "'" << hpx::endl;
+            return;
+        }
+
+        for(const auto& entry : stored_entries)
+        {
+            file << entry.first << '\t';
+            if(entry.second.empty())
+                file << '-';
+            for(std::size_t i = 0; i < entry.second.size(); i++)
+            {
+                if(i > 0) file << ' ';
+                file << entry.second[i];
+            }
+            file << '\n';
+        }
+    }
+
+    if(std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+        hpx::cerr << "tuning_database: unable to write '"
+                  << filename << "'" << hpx::endl;
+    }
+}
@@ -0,0 +1,88 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_SERVER_UTIL_TUNING_DATABASE_HPP_
+#define HPX_OPENCL_SERVER_UTIL_TUNING_DATABASE_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../../export_definitions.hpp"
+
+#include <hpx/compat/mutex.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+namespace hpx { namespace opencl{ namespace server{ namespace util{
+
+
+    ////////////////////////////////////////////////////////
+    // This class stores the results of kernel::autotune().
+    //
+    // Entries map a key (kernel, device and global size) to the best local
+    // work size. An empty local work size means that the driver default won.
+    //
+    // The database is persisted in the file given by the configuration
+    // entry 'hpx.opencl.tuning_database' (default: hpxcl_tuning.db).
+    // An empty file name disables persistence. Stored entries get written
+    // in batches by a background thread, merged with the entries other
+    // localities wrote to the file in the meantime.
+    //
+    class HPX_OPENCL_EXPORT tuning_database
+    {
+    public:
+        // Returns the tuning database of this locality
+        static tuning_database& get_instance();
+
+        // Looks up the local work size stored for 'key'.
+        // Returns false if no entry exists.
+        bool lookup( const std::string& key,
+                     std::vector<std::size_t>& local_size );
+
+        // Stores the local work size for 'key' and schedules writing it
+        // to disk
+        void store( const std::string& key,
+                    const std::vector<std::size_t>& local_size );
+
+        // Writes the entries stored since the last flush to disk.
+        // Called at shutdown, so no entry gets lost.
+        void flush();
+
+    private:
+        tuning_database();
+
+        // Reads the database file on first access.
+        // Needs to be called with the lock held.
+        void ensure_loaded();
+
+    private:
+        ///////////////////////////////////////////////
+        // Private Member Variables
+        //
+        typedef std::map<std::string, std::vector<std::size_t> > entry_map;
+
+        entry_map entries;
+        std::string filename;
+        bool loaded;
+
+        // The entries stored since the last flush
+        entry_map unsaved;
+        bool flush_scheduled;
+
+        // Lock for synchronization
+        hpx::compat::mutex m;
+
+        // Serializes the flushes, so newer entries never get overwritten
+        // by older ones. Acquired before m.
+        hpx::compat::mutex file_mutex;
+
+    };
+}}}}
+
+#endif
@@ -99,5 +99,14 @@ const char* cl_err_to_str(cl_int errCode)
 }
 
 
+hpx::naming::id_type
+get_locality_of(const hpx::naming::id_type& id)
+{
+
+    return hpx::naming::get_id_from_locality_id(
+                hpx::naming::get_locality_id_from_gid(id.get_gid()) );
+
+}
+
 }}}
 
@@ -65,6 +65,12 @@ namespace hpx { namespace opencl { namespace tools {
     // Returns true if curren thread runs on a large stack
     HPX_OPENCL_EXPORT bool runs_on_medium_stack();
 
+    // Returns the locality of an HPXCL component, without asking AGAS.
+    // HPXCL components never migrate, so they stay on the locality that
+    // is encoded in their GID.
+    HPX_OPENCL_EXPORT hpx::naming::id_type
+    get_locality_of(const hpx::naming::id_type& id);
+
 }}}
 
 #endif//HPX_OPENCL_TOOLS_HPP_
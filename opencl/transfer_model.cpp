@@ -0,0 +1,405 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "transfer_model.hpp"
+
+// Internal Dependencies
+#include "buffer.hpp"
+#include "tools.hpp"
+
+#include <hpx/include/iostreams.hpp>
+#include <hpx/compat/mutex.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+using hpx::opencl::transfer_model;
+using hpx::opencl::transfer_fit;
+using hpx::opencl::transfer_kind;
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+
+// Serializes the accesses of all models of this locality to the file
+static hpx::compat::mutex file_mutex;
+
+static const char* get_kind_name( transfer_kind kind )
+{
+    switch(kind)
+    {
+        case transfer_kind::host_to_device: return "host_to_device";
+        case transfer_kind::device_to_host: return "device_to_host";
+        case transfer_kind::same_context:   return "same_context";
+        case transfer_kind::cross_context:  return "cross_context";
+        case transfer_kind::cross_locality: return "cross_locality";
+    }
+    return "unknown";
+}
+
+// File format: one fit per line,
+//     <kind>\t<source>\t<destination>\t<latency> <bandwidth>
+static void read_fits( const std::string & filename,
+                       std::map<std::string, transfer_fit> & fits )
+{
+    std::ifstream file(filename.c_str());
+    std::string line;
+    while(std::getline(file, line))
+    {
+        std::size_t separator = line.rfind('\t');
+        if(separator == std::string::npos)
+            continue;
+
+        transfer_fit fit;
+        std::istringstream values(line.substr(separator + 1));
+        if(!(values >> fit.latency >> fit.bandwidth))
+            continue;
+
+        fits[line.substr(0, separator)] = fit;
+    }
+}
+
+// Fits time = latency + size / bandwidth. The squared errors are weighted
+// with the inverse squared times, so that the small copies, which determine
+// the latency, count as much as the large ones.
+static transfer_fit fit_model( const std::vector<double> & sizes,
+                               const std::vector<double> & times )
+{
+    double s = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    for(std::size_t i = 0; i < sizes.size(); i++)
+    {
+        double w = times[i] > 0.0 ? 1.0 / (times[i] * times[i]) : 1.0;
+        s   += w;
+        sx  += w * sizes[i];
+        sy  += w * times[i];
+        sxx += w * sizes[i] * sizes[i];
+        sxy += w * sizes[i] * times[i];
+    }
+
+    double denominator = s * sxx - sx * sx;
+    double seconds_per_byte =
+        denominator != 0.0 ? (s * sxy - sx * sy) / denominator : 0.0;
+
+    // noisy measurements can make the slope vanish, fall back to the
+    // throughput of the largest copy
+    if(seconds_per_byte <= 0.0)
+        seconds_per_byte = times.back() / sizes.back();
+
+    transfer_fit fit;
+    fit.latency = std::max(0.0, (sy - seconds_per_byte * sx) / s);
+    fit.bandwidth = seconds_per_byte > 0.0 ? 1.0 / seconds_per_byte : 0.0;
+    return fit;
+}
+
+static double get_median( std::vector<double> times )
+{
+    std::sort(times.begin(), times.end());
+    std::size_t size = times.size();
+    if(size % 2 == 0)
+        return (times[size / 2 - 1] + times[size / 2]) / 2.0;
+    return times[size / 2];
+}
+
+
+transfer_model::transfer_model()
+  : filename(hpx::get_config_entry("hpx.opencl.transfer_model",
+                                   "hpxcl_transfers.db"))
+{
+
+    if(filename.empty())
+        return;
+
+    std::lock_guard<hpx::compat::mutex> guard(file_mutex);
+    read_fits(filename, fits);
+
+}
+
+void
+transfer_model::calibrate( const std::vector<device> & devices,
+                           std::size_t min_size,
+                           std::size_t max_size,
+                           std::size_t repetitions )
+{
+
+    if(min_size == 0 || max_size < min_size || repetitions == 0)
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "hpx::opencl::transfer_model::calibrate()",
+                            "Invalid calibration sizes!");
+
+    std::vector<std::size_t> sizes;
+    for(std::size_t size = min_size; size <= max_size; size *= 4)
+    {
+        sizes.push_back(size);
+        if(size > max_size / 4)
+            break;
+    }
+
+    // the host and every device, in both directions
+    for(const auto & dev : devices)
+    {
+        transfer_fit to_device = measure(device(), dev, sizes, repetitions);
+        transfer_fit to_host = measure(dev, device(), sizes, repetitions);
+
+        std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+        fits[get_key(device(), dev)] = to_device;
+        fits[get_key(dev, device())] = to_host;
+    }
+
+    // every pair of devices, including the copies within a device
+    for(const auto & src : devices)
+    {
+        for(const auto & dst : devices)
+        {
+            transfer_fit fit = measure(src, dst, sizes, repetitions);
+
+            std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+            fits[get_key(src, dst)] = fit;
+        }
+    }
+
+    save();
+
+}
+
+bool
+transfer_model::has_fit( const device & src, const device & dst )
+{
+
+    std::string key = get_key(src, dst);
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+    return fits.find(key) != fits.end();
+
+}
+
+transfer_fit
+transfer_model::get_fit( const device & src, const device & dst )
+{
+
+    std::string key = get_key(src, dst);
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+
+    auto it = fits.find(key);
+    if(it == fits.end())
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "hpx::opencl::transfer_model::get_fit()",
+                            "No calibration for this transfer!");
+
+    return it->second;
+
+}
+
+double
+transfer_model::estimate_transfer_time( const device & src,
+                                        const device & dst,
+                                        std::size_t bytes )
+{
+
+    transfer_fit fit = get_fit(src, dst);
+
+    if(fit.bandwidth <= 0.0)
+        return fit.latency;
+    return fit.latency + static_cast<double>(bytes) / fit.bandwidth;
+
+}
+
+transfer_kind
+transfer_model::get_transfer_kind( const device & src, const device & dst )
+{
+
+    // The host memory is the one of the calling locality
+    hpx::naming::id_type src_locality = src.get_id()
+        ? hpx::opencl::tools::get_locality_of(src.get_id())
+        : hpx::find_here();
+    hpx::naming::id_type dst_locality = dst.get_id()
+        ? hpx::opencl::tools::get_locality_of(dst.get_id())
+        : hpx::find_here();
+
+    if(src_locality != dst_locality)
+        return transfer_kind::cross_locality;
+
+    if(!src.get_id())
+        return transfer_kind::host_to_device;
+    if(!dst.get_id())
+        return transfer_kind::device_to_host;
+    if(src.get_id() == dst.get_id())
+        return transfer_kind::same_context;
+    return transfer_kind::cross_context;
+
+}
+
+std::string
+transfer_model::get_endpoint_key( const device & dev )
+{
+
+    if(!dev.get_id())
+        return "host@" + hpx::opencl::detail::get_host_name();
+
+    hpx::naming::gid_type gid = dev.get_id().get_gid();
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+        auto it = endpoint_keys.find(gid);
+        if(it != endpoint_keys.end())
+            return it->second;
+    }
+
+    // query the names without holding the lock
+    hpx::future<std::string> platform_name =
+        dev.get_platform_info<CL_PLATFORM_NAME>();
+    hpx::future<std::string> device_name =
+        dev.get_device_info<CL_DEVICE_NAME>();
+
+    // locality ids depend on the startup order, host names don't
+    typedef hpx::opencl::detail::get_host_name_action func;
+    hpx::future<std::string> host_name = hpx::async<func>(
+        hpx::opencl::tools::get_locality_of(dev.get_id()));
+
+    std::string key = platform_name.get() + "/" + device_name.get() + "@"
+        + host_name.get();
+
+    std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+    endpoint_keys[gid] = key;
+    return key;
+
+}
+
+std::string
+transfer_model::get_key( const device & src, const device & dst )
+{
+
+    return std::string(get_kind_name(get_transfer_kind(src, dst))) + '\t'
+         + get_endpoint_key(src) + '\t' + get_endpoint_key(dst);
+
+}
+
+transfer_fit
+transfer_model::measure( const device & src, const device & dst,
+                         const std::vector<std::size_t> & sizes,
+                         std::size_t repetitions )
+{
+
+    std::size_t max_size = sizes.back();
+
+    buffer_type data(max_size);
+    std::fill(data.data(), data.data() + max_size, '\0');
+
+    buffer src_buffer;
+    buffer dst_buffer;
+    if(src.get_id())
+    {
+        src_buffer = src.create_buffer(CL_MEM_READ_WRITE, max_size);
+        src_buffer.enqueue_write(0, data).get();
+    }
+    if(dst.get_id())
+        dst_buffer = dst.create_buffer(CL_MEM_READ_WRITE, max_size);
+
+    // runs one copy of the given size
+    auto copy = [&](std::size_t size)
+    {
+        if(!src.get_id())
+        {
+            buffer_type part(data.data(), size,
+                             buffer_type::init_mode::reference);
+            dst_buffer.enqueue_write(0, part).get();
+        }
+        else if(!dst.get_id())
+        {
+            src_buffer.enqueue_read(0, size).get();
+        }
+        else
+        {
+            buffer::send_result result =
+                src_buffer.enqueue_send(dst_buffer, 0, 0, size);
+            result.src_future.get();
+            result.dst_future.get();
+        }
+    };
+
+    // warm up
+    copy(sizes.front());
+
+    std::vector<double> fit_sizes;
+    std::vector<double> fit_times;
+    for(std::size_t size : sizes)
+    {
+        std::vector<double> times;
+        for(std::size_t i = 0; i < repetitions; i++)
+        {
+            hpx::util::high_resolution_timer timer;
+            copy(size);
+            times.push_back(timer.elapsed());
+        }
+
+        fit_sizes.push_back(static_cast<double>(size));
+        fit_times.push_back(get_median(times));
+    }
+
+    return fit_model(fit_sizes, fit_times);
+
+}
+
+void
+transfer_model::save()
+{
+
+    if(filename.empty())
+        return;
+
+    std::map<std::string, transfer_fit> current_fits;
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(lock);
+        current_fits = fits;
+    }
+
+    std::lock_guard<hpx::compat::mutex> guard(file_mutex);
+
+    // keep the fits that other runs stored in the meantime
+    std::map<std::string, transfer_fit> stored_fits;
+    read_fits(filename, stored_fits);
+    for(const auto & fit : current_fits)
+        stored_fits[fit.first] = fit.second;
+
+    // Write to a temporary file first, so that concurrent readers
+    // never see a partially written file. Localities on the same node
+    // share the file, so every locality needs its own temporary file.
+    std::string tmp_filename =
+        filename + "." + std::to_string(hpx::get_locality_id()) + ".tmp";
+    {
+        std::ofstream file(tmp_filename.c_str(), std::ios::trunc);
+        if(!file)
+        {
+            hpx::cerr << "transfer_model: unable to write '"
+                      << tmp_filename << "'" << hpx::endl;
+            return;
+        }
+
+        file.precision(17);
+        for(const auto & fit : stored_fits)
+        {
+            file << fit.first << '\t' << fit.second.latency << ' '
+                 << fit.second.bandwidth << '\n';
+        }
+    }
+
+    if(std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+        hpx::cerr << "transfer_model: unable to write '"
+                  << filename << "'" << hpx::endl;
+    }
+
+}
+
+std::string
+hpx::opencl::detail::get_host_name()
+{
+    return boost::asio::ip::host_name();
+}
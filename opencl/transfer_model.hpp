@@ -0,0 +1,180 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_TRANSFER_MODEL_HPP_
+#define HPX_OPENCL_TRANSFER_MODEL_HPP_
+
+// Default includes
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+// Export definitions
+#include "export_definitions.hpp"
+
+#include "device.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hpx {
+namespace opencl {
+
+    //////////////////////////////////////
+    /// @brief The kinds of copies that \ref transfer_model distinguishes.
+    ///
+    enum class transfer_kind
+    {
+        /// From the host memory of the calling locality to a device of
+        /// the calling locality
+        host_to_device,
+        /// From a device of the calling locality to its host memory
+        device_to_host,
+        /// Between two buffers of the same device
+        same_context,
+        /// Between two devices of the same locality
+        cross_context,
+        /// Between two localities: between devices of different
+        /// localities, or between the host memory of the calling locality
+        /// and a device of another one
+        cross_locality
+    };
+
+    //////////////////////////////////////
+    /// @brief The fitted cost of one kind of copy between two endpoints.
+    ///
+    /// A copy of n bytes takes latency + n / bandwidth seconds.
+    ///
+    struct transfer_fit
+    {
+        transfer_fit() : latency(0.0), bandwidth(0.0) {}
+
+        /// The fixed cost of a copy, in seconds
+        double latency;
+
+        /// The bytes per second of large copies
+        double bandwidth;
+    };
+
+    //////////////////////////////////////
+    /// @brief Estimates how long copies between host and devices take.
+    ///
+    /// calibrate() times copies of increasing size between the host and
+    /// every device and between every pair of devices, and fits a
+    /// latency + size / bandwidth model to each of them.
+    ///
+    /// The fits are stored in the file given by the configuration entry
+    /// 'hpx.opencl.transfer_model' (default: hpxcl_transfers.db), so later
+    /// runs on the same node can estimate without calibrating. Devices are
+    /// identified by the host name of their locality, platform name and
+    /// device name, so the fits stay valid when the localities get numbered
+    /// differently, and identical devices share their fits. An empty file
+    /// name disables persistence.
+    ///
+    /// A default constructed device stands for the host memory of the
+    /// calling locality.
+    ///
+    /// Example:
+    /// \code{.cpp}
+    ///     hpx::opencl::transfer_model model;
+    ///     if(!model.has_fit(hpx::opencl::device(), device))
+    ///         model.calibrate(devices);
+    ///
+    ///     double upload = model.estimate_transfer_time(
+    ///                         hpx::opencl::device(), device, size);
+    /// \endcode
+    ///
+    class HPX_OPENCL_EXPORT transfer_model
+    {
+        public:
+            /**
+             *  @brief Loads the stored fits.
+             */
+            transfer_model();
+
+            /**
+             *  @brief Measures and stores the fits of all copies between
+             *         the host and the given devices.
+             *
+             *  Copies of min_size, 4 * min_size, ... up to max_size bytes
+             *  get timed, each one repetitions times. One copy runs at a
+             *  time, so the measurements don't interfere.
+             *  Blocks until all measurements completed.
+             */
+            void calibrate( const std::vector<device> & devices,
+                            std::size_t min_size = 4096,
+                            std::size_t max_size = 1 << 24,
+                            std::size_t repetitions = 5 );
+
+            /**
+             *  @brief Returns whether a fit for copies from src to dst
+             *         exists.
+             */
+            bool has_fit( const device & src, const device & dst );
+
+            /**
+             *  @brief Returns the fit for copies from src to dst.
+             *
+             *  Throws if neither calibrate() nor the stored fits cover
+             *  the pair.
+             */
+            transfer_fit get_fit( const device & src, const device & dst );
+
+            /**
+             *  @brief Estimates the seconds a copy of the given size from
+             *         src to dst takes.
+             *
+             *  Throws if neither calibrate() nor the stored fits cover
+             *  the pair.
+             */
+            double estimate_transfer_time( const device & src,
+                                           const device & dst,
+                                           std::size_t bytes );
+
+            /**
+             *  @brief Returns the kind of a copy from src to dst.
+             */
+            static transfer_kind get_transfer_kind( const device & src,
+                                                    const device & dst );
+
+        private:
+            // The name of an endpoint in the stored fits
+            std::string get_endpoint_key( const device & dev );
+
+            std::string get_key( const device & src, const device & dst );
+
+            // Measures and fits one pair
+            transfer_fit measure( const device & src, const device & dst,
+                                  const std::vector<std::size_t> & sizes,
+                                  std::size_t repetitions );
+
+            // Merges the fits into the file
+            void save();
+
+        private:
+            std::map<std::string, transfer_fit> fits;
+            std::string filename;
+
+            // The endpoint keys of the devices seen so far
+            std::map<hpx::naming::gid_type, std::string> endpoint_keys;
+
+            hpx::lcos::local::spinlock lock;
+    };
+
+    namespace detail
+    {
+        // Returns the host name of this locality
+        HPX_OPENCL_EXPORT std::string get_host_name();
+
+        HPX_DEFINE_PLAIN_ACTION(get_host_name, get_host_name_action);
+    }
+
+}}
+
+HPX_REGISTER_ACTION_DECLARATION(hpx::opencl::detail::get_host_name_action,
+                                hpx_opencl_detail_get_host_name_action)
+
+#endif// HPX_OPENCL_TRANSFER_MODEL_HPP_
@@ -5,9 +5,65 @@
 
 #include "enqueue_overloads.hpp"
 
+#include "../server/device.hpp"
+
 void
 hpx::opencl::util::enqueue_overloads::resolver_impl(
-    hpx::naming::gid_type device_id,
+    const hpx::naming::gid_type&,
+    const hpx::naming::gid_type&,
     std::vector<hpx::naming::id_type>&,
     std::vector<hpx::naming::gid_type>&){
 };
+
+hpx::naming::id_type
+hpx::opencl::util::enqueue_overloads::create_user_event(
+    hpx::naming::gid_type device_gid,
+    hpx::future<void> && trigger )
+{
+    hpx::naming::id_type device_id( device_gid,
+                                    hpx::naming::id_type::unmanaged );
+
+    // create local event
+    hpx::opencl::lcos::event<void> ev( device_id );
+    hpx::naming::id_type event_id = ev.get_event_id();
+    hpx::shared_future<void> event_future = ev.get_future();
+
+    // create the user event on the device
+    typedef hpx::opencl::server::device::create_user_event_action create_func;
+    hpx::apply<create_func>( device_id, event_id );
+
+    // complete it once the trigger is ready. the continuation keeps the
+    // event alive until then.
+    trigger.then( hpx::launch::sync,
+        [device_id, event_id, event_future](hpx::future<void> && f)
+        {
+            typedef hpx::opencl::server::device::set_user_event_status_action
+                status_func;
+            hpx::apply<status_func>( device_id, event_id, f.has_exception() );
+        });
+
+    return event_id;
+}
+
+hpx::naming::id_type
+hpx::opencl::util::enqueue_overloads::import_event(
+    hpx::naming::gid_type device_gid,
+    hpx::naming::gid_type source_device_gid,
+    hpx::naming::id_type source_event_id )
+{
+    hpx::naming::id_type device_id( device_gid,
+                                    hpx::naming::id_type::unmanaged );
+    hpx::naming::id_type source_device_id( source_device_gid,
+                                           hpx::naming::id_type::unmanaged );
+
+    // create local event
+    hpx::opencl::lcos::event<void> ev( device_id );
+    hpx::naming::id_type event_id = ev.get_event_id();
+
+    // let the device connect it to the event of the other device
+    typedef hpx::opencl::server::device::import_event_action func;
+    hpx::apply<func>( device_id, event_id, source_device_id,
+                      std::move(source_event_id) );
+
+    return event_id;
+}
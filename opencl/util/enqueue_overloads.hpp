@@ -46,11 +46,51 @@ namespace hpx { namespace opencl { namespace util
 
 namespace hpx { namespace opencl { namespace util { namespace enqueue_overloads
 {
-    // TODO implement check for correct device
+    // Creates a future<void> that becomes ready together with the given
+    // future. The given future stays valid and keeps its value.
+    template<typename Future>
+    hpx::future<void>
+    as_void_future(const Future & fut)
+    {
+        typedef typename std::remove_reference<Future>::type::result_type
+            result_type;
+        // a shared_future, as future::get() would move the value out of
+        // the shared state
+        typedef hpx::shared_future<result_type> future_type;
+
+        // create a second future on the same shared state
+        future_type f = hpx::traits::future_access<future_type>::create(
+                            hpx::traits::detail::get_shared_state(fut) );
+
+        // get() rethrows the exception of the given future
+        return f.then( hpx::launch::sync, [](future_type && f){ f.get(); } );
+    }
+
+    // Creates an event on the given device that triggers once the given
+    // future becomes ready. The device backs it with an OpenCL user event,
+    // so dependent commands get enqueued right away.
+    HPX_OPENCL_EXPORT hpx::naming::id_type
+    create_user_event( hpx::naming::gid_type device_id,
+                       hpx::future<void> && trigger );
+
+    // Creates an event on the given device that triggers together with an
+    // event of another device.
+    HPX_OPENCL_EXPORT hpx::naming::id_type
+    import_event( hpx::naming::gid_type device_id,
+                  hpx::naming::gid_type source_device_id,
+                  hpx::naming::id_type source_event_id );
+
     // This is the function that actually extrudes the GID from the futures.
+    // Futures that are no OpenCL events get converted to user events,
+    // events of devices other than device_id and other_device_id get
+    // imported to device_id. event_device_id receives the device the
+    // returned event belongs to.
+    // Returns invalid_id if there is nothing to wait for.
     template<typename Future>
     hpx::naming::id_type
-    extrude_id(const Future & fut, hpx::naming::gid_type& device_id)
+    extrude_id(const Future & fut, const hpx::naming::gid_type& device_id,
+               const hpx::naming::gid_type& other_device_id,
+               hpx::naming::gid_type& event_device_id)
     {
         typedef typename std::remove_reference<Future>::type::result_type
             result_type;
@@ -59,12 +99,24 @@ namespace hpx { namespace opencl { namespace util { namespace enqueue_overloads
 
         auto shared_state = hpx::traits::detail::get_shared_state(fut);
 
-        HPX_ASSERT(boost::dynamic_pointer_cast<event_type>(shared_state).get());
-        auto ev = boost::static_pointer_cast<event_type>(shared_state);
+        auto ev = boost::dynamic_pointer_cast<event_type>(shared_state);
+        event_device_id = device_id;
+        if(!ev){
+            // satisfied dependencies don't need an event
+            if(fut.is_ready() && !fut.has_exception())
+                return hpx::naming::invalid_id;
 
-		std::stringstream str;
-		str << "devide_id=" << device_id << " and ev_id=" << ev->get_device_gid();
-        HPX_ASSERT_MSG(device_id == ev->get_device_gid(), str.str().c_str());
+            return create_user_event( device_id, as_void_future(fut) );
+        }
+
+        // events of the other device stay on it
+        if(other_device_id == ev->get_device_gid())
+            event_device_id = other_device_id;
+
+        // events of other devices get imported
+        else if(device_id != ev->get_device_gid())
+            return import_event( device_id, ev->get_device_gid(),
+                                 ev->get_event_id() );
 
         auto event_id = ev->get_event_id();
         return event_id;
@@ -102,13 +154,19 @@ namespace hpx { namespace opencl { namespace util { namespace enqueue_overloads
     {
         template<typename T>
         void
-        operator()(hpx::naming::gid_type device_id,const T & t,
+        operator()(const hpx::naming::gid_type& device_id,
+                   const hpx::naming::gid_type& other_device_id,
+                   const T & t,
                    std::vector<hpx::naming::id_type> &event_ids,
                    std::vector<hpx::naming::gid_type> &device_ids) const
         {
-            //hpx::naming::gid_type device_id;
-            event_ids.push_back(std::move(extrude_id(t, device_id)));
-            device_ids.push_back(device_id);
+            hpx::naming::gid_type event_device_id;
+            hpx::naming::id_type event_id =
+                extrude_id(t, device_id, other_device_id, event_device_id);
+            if(!event_id)
+                return;
+            event_ids.push_back(std::move(event_id));
+            device_ids.push_back(event_device_id);
         }
     };
 
@@ -117,14 +175,20 @@ namespace hpx { namespace opencl { namespace util { namespace enqueue_overloads
     {
         template<typename T>
         void
-        operator()(hpx::naming::gid_type device_id,const std::vector<T> & t_vec,
+        operator()(const hpx::naming::gid_type& device_id,
+                   const hpx::naming::gid_type& other_device_id,
+                   const std::vector<T> & t_vec,
                    std::vector<hpx::naming::id_type> &event_ids,
                    std::vector<hpx::naming::gid_type> &device_ids) const
         {
             for(const T & t : t_vec){
-                //hpx::naming::gid_type device_id;
-                event_ids.push_back(std::move(extrude_id(t, device_id)));
-                device_ids.push_back(device_id);
+                hpx::naming::gid_type event_device_id;
+                hpx::naming::id_type event_id =
+                    extrude_id(t, device_id, other_device_id, event_device_id);
+                if(!event_id)
+                    continue;
+                event_ids.push_back(std::move(event_id));
+                device_ids.push_back(event_device_id);
             }
         }
     };
@@ -134,31 +198,42 @@ namespace hpx { namespace opencl { namespace util { namespace enqueue_overloads
     // an arbitrary number of future and std::vector<future> to
     // one single std::vector<id_type>.
     HPX_OPENCL_EXPORT void
-    resolver_impl(hpx::naming::gid_type device_id,std::vector<hpx::naming::id_type>&,
+    resolver_impl(const hpx::naming::gid_type& device_id,
+                  const hpx::naming::gid_type& other_device_id,
+                  std::vector<hpx::naming::id_type>&,
                   std::vector<hpx::naming::gid_type>&);
 
     template<typename Dep>
     void
-    resolver_impl(hpx::naming::gid_type device_id,std::vector<hpx::naming::id_type>& event_ids,
+    resolver_impl(const hpx::naming::gid_type& device_id,
+                  const hpx::naming::gid_type& other_device_id,
+                  std::vector<hpx::naming::id_type>& event_ids,
                   std::vector<hpx::naming::gid_type>& device_ids,
                   Dep&& dep)
     {
-        extrude_all_ids<detail::is_container<Dep>::value>()(device_id, dep, event_ids,
-                                                                  device_ids);
+        extrude_all_ids<detail::is_container<Dep>::value>()(device_id,
+                                                            other_device_id,
+                                                            dep, event_ids,
+                                                            device_ids);
     }
 
     template<typename Dep, typename ...Deps>
     void
-    resolver_impl(hpx::naming::gid_type device_id,std::vector<hpx::naming::id_type>& event_ids,
+    resolver_impl(const hpx::naming::gid_type& device_id,
+                  const hpx::naming::gid_type& other_device_id,
+                  std::vector<hpx::naming::id_type>& event_ids,
                   std::vector<hpx::naming::gid_type>& device_ids,
                   Dep&& dep, Deps&&... deps)
     {
         // process current dep
-        extrude_all_ids<detail::is_container<Dep>::value>()(device_id, dep, event_ids,
-                                                                  device_ids );
+        extrude_all_ids<detail::is_container<Dep>::value>()(device_id,
+                                                            other_device_id,
+                                                            dep, event_ids,
+                                                            device_ids );
 
         // recursive call
-        resolver_impl(device_id,event_ids, device_ids, std::forward<Deps>(deps)...);
+        resolver_impl(device_id, other_device_id, event_ids, device_ids,
+                      std::forward<Deps>(deps)...);
     }
 
     template<typename ...Deps>
@@ -168,11 +243,126 @@ namespace hpx { namespace opencl { namespace util { namespace enqueue_overloads
         resolved_events res;
         res.event_ids.reserve(sizeof...(deps));
         res.device_ids.reserve(sizeof...(deps));
-        resolver_impl(device_id, res.event_ids, res.device_ids,
+        resolver_impl(device_id, device_id, res.event_ids, res.device_ids,
                        std::forward<Deps>(deps)... );
         return res;
     }
 
+    // Resolves the dependencies of a copy between two devices. Events of
+    // the destination device stay on it, everything else gets resolved
+    // against the source device.
+    template<typename ...Deps>
+    resolved_events
+    send_resolver(hpx::naming::gid_type src_device_id,
+                  hpx::naming::gid_type dst_device_id, Deps&&... deps)
+    {
+        resolved_events res;
+        res.event_ids.reserve(sizeof...(deps));
+        res.device_ids.reserve(sizeof...(deps));
+        resolver_impl(src_device_id, dst_device_id, res.event_ids,
+                      res.device_ids, std::forward<Deps>(deps)... );
+        return res;
+    }
+
+    // The same recursion, converting the dependencies to futures.
+    template<bool is_vector>
+    struct collect_futures
+    {
+    };
+
+    template<>
+    struct collect_futures<false>
+    {
+        template<typename T>
+        void operator()(const T & t,
+                        std::vector<hpx::future<void> > & futures) const
+        {
+            futures.push_back(as_void_future(t));
+        }
+    };
+
+    template<>
+    struct collect_futures<true>
+    {
+        template<typename T>
+        void operator()(const std::vector<T> & t_vec,
+                        std::vector<hpx::future<void> > & futures) const
+        {
+            for(const T & t : t_vec){
+                futures.push_back(as_void_future(t));
+            }
+        }
+    };
+
+    inline void
+    dependency_futures_impl(std::vector<hpx::future<void> > &)
+    {
+    }
+
+    template<typename Dep, typename ...Deps>
+    void
+    dependency_futures_impl(std::vector<hpx::future<void> > & futures,
+                            const Dep & dep, const Deps &... deps)
+    {
+        collect_futures<detail::is_container<Dep>::value>()(dep, futures);
+        dependency_futures_impl(futures, deps...);
+    }
+
+    template<typename ...Deps>
+    std::vector<hpx::future<void> >
+    dependency_futures(const Deps &... deps)
+    {
+        std::vector<hpx::future<void> > futures;
+        futures.reserve(sizeof...(deps));
+        dependency_futures_impl(futures, deps...);
+        return futures;
+    }
+
+    // The same recursion, checking whether all dependencies are already
+    // satisfied.
+    template<bool is_vector>
+    struct all_ready
+    {
+    };
+
+    template<>
+    struct all_ready<false>
+    {
+        template<typename T>
+        bool operator()(const T & t) const
+        {
+            return t.is_ready();
+        }
+    };
+
+    template<>
+    struct all_ready<true>
+    {
+        template<typename T>
+        bool operator()(const std::vector<T> & t_vec) const
+        {
+            for(const T & t : t_vec){
+                if(!t.is_ready())
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    inline bool
+    dependencies_ready()
+    {
+        return true;
+    }
+
+    template<typename Dep, typename ...Deps>
+    bool
+    dependencies_ready(const Dep & dep, const Deps &... deps)
+    {
+        return all_ready<detail::is_container<Dep>::value>()(dep) &&
+               dependencies_ready(deps...);
+    }
+
 }}}}
 
 // #define HPX_OPENCL_GENERATE_ENQUEUE_OVERLOADS(return_value, name, ...)          \
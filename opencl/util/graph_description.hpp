@@ -0,0 +1,171 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_UTIL_GRAPH_DESCRIPTION_HPP_
+#define HPX_OPENCL_UTIL_GRAPH_DESCRIPTION_HPP_
+
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+#include "../cl_headers.hpp"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace opencl { namespace util {
+
+    ////////////////////////////////////////////////////////////////
+    // One recorded command of a command_graph.
+    //
+    struct graph_node
+    {
+        enum node_type {
+            write_node = 0,
+            read_node = 1,
+            copy_node = 2,
+            kernel_node = 3
+        };
+
+        graph_node()
+          : type(write_node), offset(0), dst_offset(0), size(0)
+        {}
+
+        int type;
+
+        // The buffer (write, read, copy source) or kernel
+        hpx::naming::id_type target;
+
+        // The destination buffer of a copy
+        hpx::naming::id_type copy_dst;
+
+        // Buffer region
+        std::size_t offset;
+        std::size_t dst_offset;
+        std::size_t size;
+
+        // Kernel work dimensions, packed like in kernel::enqueue()
+        std::vector<std::size_t> work_size;
+
+        // The data of a write
+        hpx::serialization::serialize_buffer<char> data;
+
+        // Indices of the nodes this node depends on.
+        // Only earlier nodes are allowed.
+        std::vector<std::size_t> dependencies;
+
+        template <typename Archive>
+        void serialize(Archive & ar, unsigned)
+        {
+            ar & type & target & copy_dst & offset & dst_offset & size
+               & work_size & data & dependencies;
+        }
+    };
+
+}}}
+
+namespace hpx { namespace opencl {
+
+    //////////////////////////////////////
+    /// @brief Per-replay arguments of a \ref command_graph.
+    ///
+    class graph_arguments
+    {
+    public:
+        struct scalar_argument
+        {
+            std::size_t node;
+            cl_uint arg_index;
+            std::vector<char> value;
+
+            template <typename Archive>
+            void serialize(Archive & ar, unsigned)
+            {
+                ar & node & arg_index & value;
+            }
+        };
+
+        struct write_data
+        {
+            std::size_t node;
+            hpx::serialization::serialize_buffer<char> data;
+
+            template <typename Archive>
+            void serialize(Archive & ar, unsigned)
+            {
+                ar & node & data;
+            }
+        };
+
+    public:
+        /**
+         *  @brief Sets a scalar kernel argument for one replay.
+         *
+         *  @param node         The kernel node, as returned by
+         *                      command_graph::add_kernel()
+         *  @param arg_index    The argument index
+         *  @param value        The value. Needs to be trivially copyable.
+         */
+        template <typename T>
+        void set_scalar(std::size_t node, cl_uint arg_index, const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "Scalar kernel arguments need to be trivially "
+                          "copyable!");
+
+            scalar_argument arg;
+            arg.node = node;
+            arg.arg_index = arg_index;
+            arg.value.resize(sizeof(T));
+            std::memcpy(arg.value.data(), &value, sizeof(T));
+            scalars.push_back(std::move(arg));
+        }
+
+        /**
+         *  @brief Replaces the data of a write node for one replay.
+         *
+         *  @param node         The write node, as returned by
+         *                      command_graph::add_write()
+         *  @param data         The data. Needs to have the recorded size.
+         */
+        template <typename T>
+        void set_write_data( std::size_t node,
+                             hpx::serialization::serialize_buffer<T> data )
+        {
+            typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+            // keep the typed buffer alive through the deleter
+            write_data entry;
+            entry.node = node;
+            entry.data = buffer_type( reinterpret_cast<char*>(data.data()),
+                                      data.size() * sizeof(T),
+                                      [data](char*){} );
+            writes.push_back(std::move(entry));
+        }
+
+        bool empty() const
+        {
+            return scalars.empty() && writes.empty();
+        }
+
+    public:
+        std::vector<scalar_argument> scalars;
+        std::vector<write_data> writes;
+
+    private:
+        // serialization support
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, unsigned)
+        {
+            ar & scalars & writes;
+        }
+    };
+
+}}
+
+#endif
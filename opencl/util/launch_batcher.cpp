@@ -0,0 +1,166 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The class header file
+#include "launch_batcher.hpp"
+
+// Internal Dependencies
+#include "../server/kernel.hpp"
+#include "../lcos/event.hpp"
+
+#include <mutex>
+
+using hpx::opencl::util::launch_batcher;
+
+
+launch_batcher::launch_batcher( hpx::naming::id_type kernel_id_,
+                                hpx::naming::id_type device_id_,
+                                cl_uint table_arg_index_,
+                                std::chrono::microseconds window_,
+                                std::size_t max_launches_ )
+  : kernel_id(std::move(kernel_id_)),
+    device_id(std::move(device_id_)),
+    table_arg_index(table_arg_index_),
+    window(window_),
+    max_launches(max_launches_ > 0 ? max_launches_ : 1),
+    generation(0)
+{}
+
+launch_batcher::~launch_batcher()
+{
+    // don't leave launches behind, their events would never trigger
+    if(!pending.event_ids.empty())
+        send(std::move(pending));
+}
+
+hpx::future<void>
+launch_batcher::add( std::size_t offset,
+                     std::size_t size,
+                     std::size_t local_size,
+                     resolved_events && deps,
+                     bool deps_ready )
+{
+    // create local event
+    using hpx::opencl::lcos::event;
+    event<void> ev( device_id );
+    hpx::future<void> result = ev.get_future();
+
+    batch full_batch;
+    batch single_launch;
+    bool start_timer = false;
+    std::uint64_t current_generation;
+    {
+        std::lock_guard<lock_type> lock(this->lock);
+
+        // launches that can not join the pending batch send it
+        if(!pending.event_ids.empty() &&
+           (!deps_ready || pending.local_size != local_size)){
+            full_batch = std::move(pending);
+            pending = batch();
+            generation++;
+        }
+
+        if(deps_ready){
+            // join the pending batch. the dependencies are satisfied, so
+            // waiting for them in the combined launch costs nothing.
+            if(pending.event_ids.empty()){
+                pending.local_size = local_size;
+                start_timer = true;
+            }
+            pending.event_ids.push_back(ev.get_event_id());
+            pending.ranges.push_back(offset);
+            pending.ranges.push_back(size);
+            pending.dependencies.insert( pending.dependencies.end(),
+                                         deps.event_ids.begin(),
+                                         deps.event_ids.end() );
+
+            if(pending.event_ids.size() >= max_launches){
+                HPX_ASSERT(full_batch.event_ids.empty());
+                full_batch = std::move(pending);
+                pending = batch();
+                generation++;
+                start_timer = false;
+            }
+        } else {
+            // launches with unsatisfied dependencies go alone
+            single_launch.event_ids.push_back(ev.get_event_id());
+            single_launch.ranges.push_back(offset);
+            single_launch.ranges.push_back(size);
+            single_launch.local_size = local_size;
+            single_launch.dependencies = std::move(deps.event_ids);
+        }
+
+        current_generation = generation;
+    }
+
+    // send outside of the lock
+    if(!full_batch.event_ids.empty())
+        send(std::move(full_batch));
+    if(!single_launch.event_ids.empty())
+        send(std::move(single_launch));
+
+    // the first launch of a batch starts its window
+    if(start_timer){
+        std::weak_ptr<launch_batcher> weak_this = shared_from_this();
+        std::chrono::microseconds window_ = window;
+        hpx::apply(
+            [weak_this, window_, current_generation]()
+            {
+                hpx::this_thread::sleep_for(window_);
+                if(std::shared_ptr<launch_batcher> self = weak_this.lock())
+                    self->flush_generation(current_generation);
+            });
+    }
+
+    return result;
+}
+
+void
+launch_batcher::flush()
+{
+    batch full_batch;
+    {
+        std::lock_guard<lock_type> lock(this->lock);
+        if(pending.event_ids.empty())
+            return;
+        full_batch = std::move(pending);
+        pending = batch();
+        generation++;
+    }
+
+    send(std::move(full_batch));
+}
+
+void
+launch_batcher::flush_generation(std::uint64_t batch_generation)
+{
+    batch full_batch;
+    {
+        std::lock_guard<lock_type> lock(this->lock);
+        if(generation != batch_generation || pending.event_ids.empty())
+            return;
+        full_batch = std::move(pending);
+        pending = batch();
+        generation++;
+    }
+
+    send(std::move(full_batch));
+}
+
+void
+launch_batcher::send(batch && b) const
+{
+    HPX_ASSERT(!b.event_ids.empty());
+    HPX_ASSERT(b.ranges.size() == 2 * b.event_ids.size());
+
+    // send command to server class
+    typedef hpx::opencl::server::kernel::enqueue_batch_action func;
+    hpx::apply<func>( kernel_id,
+                      std::move(b.event_ids),
+                      std::move(b.ranges),
+                      b.local_size,
+                      table_arg_index,
+                      std::move(b.dependencies) );
+}
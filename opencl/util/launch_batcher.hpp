@@ -0,0 +1,103 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_UTIL_LAUNCH_BATCHER_HPP_
+#define HPX_OPENCL_UTIL_LAUNCH_BATCHER_HPP_
+
+// Default includes
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+// Export definitions
+#include "../export_definitions.hpp"
+
+// OpenCL Headers
+#include "../cl_headers.hpp"
+
+#include "enqueue_overloads.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hpx {
+namespace opencl {
+namespace util {
+
+    ////////////////////////////////////////////////////////
+    // Gathers one-dimensional launches of one kernel and sends them to the
+    // device as a single launch over the concatenated range.
+    //
+    // A batch gets sent when its window expires, when it is full, or when a
+    // launch arrives that can not join it (different local size, or
+    // dependencies that are not satisfied yet).
+    //
+    // Every launch still gets its own event. The server registers the
+    // cl_event of the combined launch for all of them.
+    //
+    class HPX_OPENCL_EXPORT launch_batcher
+      : public std::enable_shared_from_this<launch_batcher>
+    {
+        typedef hpx::lcos::local::spinlock lock_type;
+
+    public:
+        launch_batcher( hpx::naming::id_type kernel_id,
+                        hpx::naming::id_type device_id,
+                        cl_uint table_arg_index,
+                        std::chrono::microseconds window,
+                        std::size_t max_launches );
+
+        // Sends the pending batch
+        ~launch_batcher();
+
+        // Adds a launch to the pending batch.
+        // If deps_ready is false, the launch gets sent right away, together
+        // with the pending batch.
+        hpx::future<void> add( std::size_t offset,
+                               std::size_t size,
+                               std::size_t local_size,
+                               resolved_events && deps,
+                               bool deps_ready );
+
+        // Sends the pending batch
+        void flush();
+
+    private:
+        struct batch
+        {
+            batch() : local_size(0) {}
+
+            std::vector<hpx::naming::id_type> event_ids;
+            std::vector<std::size_t> ranges;
+            std::size_t local_size;
+            std::vector<hpx::naming::id_type> dependencies;
+        };
+
+        // Sends the pending batch, if it still is the given one
+        void flush_generation(std::uint64_t generation);
+
+        // Sends a batch to the server
+        void send(batch && b) const;
+
+    private:
+        hpx::naming::id_type kernel_id;
+        hpx::naming::id_type device_id;
+        cl_uint table_arg_index;
+        std::chrono::microseconds window;
+        std::size_t max_launches;
+
+        lock_type lock;
+        batch pending;
+
+        // counts the sent batches, so a late timer does not flush a
+        // younger batch
+        std::uint64_t generation;
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The class header file
+#include "nowait_tracker.hpp"
+
+#include <map>
+
+using hpx::opencl::util::nowait_tracker;
+
+namespace
+{
+    typedef hpx::lcos::local::spinlock lock_type;
+
+    struct nowait_counters
+    {
+        std::map<hpx::naming::gid_type, std::uint64_t> counters;
+        lock_type lock;
+    };
+
+    nowait_counters& get_counters()
+    {
+        static nowait_counters instance;
+        return instance;
+    }
+}
+
+std::uint64_t
+nowait_tracker::submit(const hpx::naming::gid_type& device)
+{
+    nowait_counters& counters = get_counters();
+
+    std::lock_guard<lock_type> lock(counters.lock);
+    return ++counters.counters[device];
+}
+
+std::uint64_t
+nowait_tracker::submitted(const hpx::naming::gid_type& device)
+{
+    nowait_counters& counters = get_counters();
+
+    std::lock_guard<lock_type> lock(counters.lock);
+    auto it = counters.counters.find(device);
+    if(it == counters.counters.end())
+        return 0;
+    return it->second;
+}
@@ -0,0 +1,43 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_UTIL_NOWAIT_TRACKER_HPP_
+#define HPX_OPENCL_UTIL_NOWAIT_TRACKER_HPP_
+
+// Default includes
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+// Export definitions
+#include "../export_definitions.hpp"
+
+#include <cstdint>
+
+namespace hpx {
+namespace opencl {
+namespace util {
+
+    ////////////////////////////////////////////////////////
+    // Counts the untracked commands (enqueue_nowait) this locality submitted
+    // to each device.
+    //
+    // Actions are not ordered, so device::barrier_async() and
+    // device::finish_async() send the count along. The device then waits
+    // until all of those commands arrived.
+    //
+    class HPX_OPENCL_EXPORT nowait_tracker
+    {
+    public:
+        // Counts one submission. Returns the new count.
+        static std::uint64_t submit(const hpx::naming::gid_type& device);
+
+        // Returns the number of submissions so far
+        static std::uint64_t submitted(const hpx::naming::gid_type& device);
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_UTIL_SPECIALIZATION_HPP_
+#define HPX_OPENCL_UTIL_SPECIALIZATION_HPP_
+
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace hpx { namespace opencl {
+
+    //////////////////////////////////////
+    /// @brief The value of a preprocessor definition,
+    ///        used by program::specialize().
+    ///
+    /// Can be constructed from any arithmetic type or string.
+    ///
+    class define_value
+    {
+    public:
+        template <typename T, typename Enable = typename
+                    std::enable_if<std::is_arithmetic<T>::value>::type>
+        define_value(T value)
+        {
+            std::ostringstream stream;
+            stream.precision(std::numeric_limits<T>::max_digits10);
+            stream << +value;
+            value_ = stream.str();
+        }
+
+        define_value(const char* value)
+          : value_(value)
+        {}
+
+        define_value(std::string value)
+          : value_(std::move(value))
+        {}
+
+        const std::string& str() const
+        {
+            return value_;
+        }
+
+    private:
+        std::string value_;
+    };
+
+    //////////////////////////////////////
+    /// @brief A set of preprocessor definitions,
+    ///        e.g. <tt>{{"K", 1024}, {"TILE", 16}}</tt>.
+    ///
+    /// The map is ordered, so equal sets always produce equal build options.
+    ///
+    typedef std::map<std::string, define_value> specialization;
+
+    namespace util {
+
+        // Converts a specialization to '-D' build options
+        inline std::string to_build_options(const specialization& defines)
+        {
+            std::string options;
+            for(const auto& define : defines)
+            {
+                if(!options.empty())
+                    options += " ";
+                options += "-D " + define.first + "=" + define.second.str();
+            }
+            return options;
+        }
+
+    }
+
+}}
+
+#endif
@@ -0,0 +1,498 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Header of this class
+#include "tracer.hpp"
+
+#include <hpx/compat/mutex.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+using hpx::opencl::util::tracer;
+
+std::atomic<bool> tracer::is_enabled(false);
+
+
+namespace {
+
+    // The kinds of trace records
+    enum record_phase
+    {
+        // An operation or an instant, if it has no duration
+        phase_operation,
+        // A step of the flow of a client event. Binds to the enclosing
+        // operation of the thread.
+        phase_flow_start,
+        phase_flow_step,
+        phase_flow_end
+    };
+
+    struct trace_record
+    {
+        const char* name;
+        const char* category;
+        std::uint64_t begin;
+        std::uint64_t end;
+
+        // 0 for the recording thread, device index + 1 for devices
+        std::size_t track;
+
+        // The client event of the command, invalid if there is none
+        hpx::naming::gid_type event_gid;
+
+        record_phase phase;
+    };
+
+    ////////////////////////////////////////////////////////
+    // The records of one OS thread. Only this thread writes, flushes read
+    // concurrently and drop the records that got overwritten meanwhile.
+    //
+    class ring_buffer
+    {
+    public:
+        ring_buffer( std::size_t capacity, std::string label_ )
+          : records(capacity), head(0), label(std::move(label_))
+        {}
+
+        void push( const trace_record & record )
+        {
+            std::uint64_t pos = head.load(std::memory_order_relaxed);
+            records[pos % records.size()] = record;
+            head.store(pos + 1, std::memory_order_release);
+        }
+
+        void copy_records( std::vector<trace_record> & result ) const
+        {
+            std::size_t capacity = records.size();
+            std::uint64_t end = head.load(std::memory_order_acquire);
+            std::uint64_t begin = end > capacity ? end - capacity : 0;
+
+            std::size_t first = result.size();
+            for(std::uint64_t i = begin; i < end; i++)
+                result.push_back(records[i % capacity]);
+
+            // Record i gets overwritten by the write of record
+            // i + capacity, which might be in progress at the new head
+            std::atomic_thread_fence(std::memory_order_acquire);
+            std::uint64_t new_end = head.load(std::memory_order_relaxed);
+            if(new_end + 1 > begin + capacity)
+            {
+                std::uint64_t dropped = new_end + 1 - (begin + capacity);
+                if(dropped > end - begin)
+                    dropped = end - begin;
+                result.erase(result.begin() + first,
+                             result.begin() + first + dropped);
+            }
+        }
+
+        const std::string & get_label() const
+        {
+            return label;
+        }
+
+    private:
+        std::vector<trace_record> records;
+        std::atomic<std::uint64_t> head;
+        std::string label;
+    };
+
+    struct trace_registry
+    {
+        trace_registry()
+          : capacity(65536), filename("hpxcl_trace")
+        {}
+
+        // Buffers are never destroyed, threads that exit leave theirs
+        // behind for the next flush
+        hpx::lcos::local::spinlock lock;
+        std::vector<std::unique_ptr<ring_buffer> > buffers;
+
+        // Serializes the flushes
+        hpx::compat::mutex flush_mutex;
+
+        std::size_t capacity;
+        std::string filename;
+    };
+
+    trace_registry& get_trace_registry()
+    {
+        static trace_registry registry;
+        return registry;
+    }
+
+    ring_buffer& get_thread_buffer()
+    {
+        static thread_local ring_buffer* thread_buffer = NULL;
+        if(thread_buffer != NULL)
+            return *thread_buffer;
+
+        trace_registry& registry = get_trace_registry();
+
+        std::lock_guard<hpx::lcos::local::spinlock> guard(registry.lock);
+
+        // OpenCL runtimes call the completion callbacks on their own
+        // threads
+        std::size_t worker = hpx::get_worker_thread_num();
+        std::string label = (worker != std::size_t(-1)) ?
+            "worker#" + std::to_string(worker) :
+            "thread#" + std::to_string(registry.buffers.size());
+
+        registry.buffers.emplace_back(
+            new ring_buffer(registry.capacity, std::move(label)));
+        thread_buffer = registry.buffers.back().get();
+
+        return *thread_buffer;
+    }
+
+    void push_record( const trace_record & record )
+    {
+        get_thread_buffer().push(record);
+    }
+
+    ////////////////////////////////////////////////////////
+    // Device side of a command
+    //
+    struct device_command
+    {
+        const char* name;
+        std::size_t device_index;
+        std::uint64_t submitted;
+        hpx::naming::gid_type event_gid;
+    };
+
+    void CL_CALLBACK
+    device_command_completed( cl_event event, cl_int status,
+                              void* command_ptr )
+    {
+        std::unique_ptr<device_command> command(
+            static_cast<device_command*>(command_ptr));
+
+        trace_record record;
+        record.name = command->name;
+        record.category = "device";
+        record.begin = command->submitted;
+        record.end = tracer::now();
+        record.track = command->device_index + 1;
+        record.event_gid = command->event_gid;
+        record.phase = phase_operation;
+
+        // With profiling, take the device times. The device clock gets
+        // mapped to the host clock at the submission.
+        cl_ulong queued, start, end;
+        cl_int err = CL_SUCCESS;
+        if(status == CL_COMPLETE)
+            err = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_QUEUED,
+                                           sizeof(cl_ulong), &queued, NULL );
+        if(status == CL_COMPLETE && err == CL_SUCCESS)
+            err = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_START,
+                                           sizeof(cl_ulong), &start, NULL );
+        if(status == CL_COMPLETE && err == CL_SUCCESS)
+            err = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_END,
+                                           sizeof(cl_ulong), &end, NULL );
+        if(status == CL_COMPLETE && err == CL_SUCCESS &&
+           queued <= start && start <= end)
+        {
+            record.begin = command->submitted + (start - queued);
+            record.end = command->submitted + (end - queued);
+        }
+
+        push_record(record);
+
+        // ends the flow of the client event in the device execution
+        if(record.event_gid)
+        {
+            record.end = record.begin;
+            record.phase = phase_flow_end;
+            push_record(record);
+        }
+    }
+
+    ////////////////////////////////////////////////////////
+    // Output
+    //
+    const std::size_t device_tid_base = 1000000;
+
+    void write_string( std::ostream & out, const std::string & str )
+    {
+        out << '"';
+        for(char c : str)
+        {
+            if(c == '"' || c == '\\')
+                out << '\\' << c;
+            else if(static_cast<unsigned char>(c) < 0x20)
+                out << ' ';
+            else
+                out << c;
+        }
+        out << '"';
+    }
+
+    // Flow ids need to be unique over all localities, like the GIDs.
+    // The copies of a GID differ in their credits.
+    void write_event_gid( std::ostream & out,
+                          const hpx::naming::gid_type & event_gid )
+    {
+        hpx::naming::gid_type gid =
+            hpx::naming::detail::get_stripped_gid(event_gid);
+
+        std::ios::fmtflags flags = out.flags();
+        out << "\"0x" << std::hex << std::setfill('0')
+            << std::setw(16) << gid.get_msb()
+            << std::setw(16) << gid.get_lsb() << '"';
+        out.flags(flags);
+    }
+
+    const char* get_flow_phase( record_phase phase )
+    {
+        switch(phase)
+        {
+            case phase_flow_start: return "s";
+            case phase_flow_step:  return "t";
+            case phase_flow_end:   return "f";
+            default: break;
+        }
+        return "";
+    }
+
+    void write_thread_name( std::ostream & out, std::uint32_t pid,
+                            std::size_t tid, const std::string & name )
+    {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << tid << ",\"args\":{\"name\":";
+        write_string(out, name);
+        out << "}}";
+    }
+}
+
+void
+tracer::init()
+{
+    trace_registry& registry = get_trace_registry();
+
+    try {
+        registry.capacity = std::stoul(
+            hpx::get_config_entry("hpx.opencl.trace_buffer_size", "65536"));
+    } catch (std::exception const&) {
+    }
+    if(registry.capacity < 1)
+        registry.capacity = 1;
+
+    registry.filename =
+        hpx::get_config_entry("hpx.opencl.trace_file", "hpxcl_trace");
+
+    is_enabled.store(hpx::get_config_entry("hpx.opencl.trace", "0") == "1",
+                     std::memory_order_relaxed);
+}
+
+void
+tracer::shutdown()
+{
+    flush();
+}
+
+std::uint64_t
+tracer::now()
+{
+    return hpx::util::high_resolution_clock::now();
+}
+
+void
+tracer::record( const char* name, const char* category,
+                std::uint64_t begin, std::uint64_t end )
+{
+    if(!enabled())
+        return;
+
+    trace_record record;
+    record.name = name;
+    record.category = category;
+    record.begin = begin;
+    record.end = end;
+    record.track = 0;
+    record.phase = phase_operation;
+
+    push_record(record);
+}
+
+void
+tracer::record_flow( const hpx::naming::gid_type & event_gid, bool start )
+{
+    if(!event_gid)
+        return;
+
+    trace_record record;
+    record.name = "command";
+    record.category = start ? "client" : "server";
+    record.begin = now();
+    record.end = record.begin;
+    record.track = 0;
+    record.event_gid = event_gid;
+    record.phase = start ? phase_flow_start : phase_flow_step;
+
+    push_record(record);
+}
+
+void
+tracer::command_submitted( const char* name, std::size_t device_index,
+                           cl_event event,
+                           const hpx::naming::gid_type & event_gid )
+{
+    if(!enabled())
+        return;
+
+    std::uint64_t submitted = now();
+
+    trace_record submission;
+    submission.name = name;
+    submission.category = "submit";
+    submission.begin = submitted;
+    submission.end = submitted;
+    submission.track = 0;
+    submission.event_gid = event_gid;
+    submission.phase = phase_operation;
+    push_record(submission);
+
+    if(event == NULL)
+        return;
+
+    device_command* command = new device_command;
+    command->name = name;
+    command->device_index = device_index;
+    command->submitted = submitted;
+    command->event_gid = event_gid;
+
+    // Tracing must not fail the command
+    cl_int err = clSetEventCallback( event, CL_COMPLETE,
+                                     &device_command_completed, command );
+    if(err != CL_SUCCESS)
+        delete command;
+}
+
+void
+tracer::flush()
+{
+    if(!enabled())
+        return;
+
+    trace_registry& registry = get_trace_registry();
+
+    std::lock_guard<hpx::compat::mutex> flush_guard(registry.flush_mutex);
+
+    std::vector<ring_buffer*> buffers;
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> guard(registry.lock);
+        for(const auto & buffer : registry.buffers)
+            buffers.push_back(buffer.get());
+    }
+
+    std::uint32_t pid = hpx::get_locality_id();
+    std::string filename =
+        registry.filename + "." + std::to_string(pid) + ".json";
+
+    std::ofstream file(filename.c_str(), std::ios::trunc);
+    if(!file)
+    {
+        hpx::cerr << "tracer: unable to write '" << filename << "'"
+                  << hpx::endl;
+        return;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+         << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+         << ",\"args\":{\"name\":\"locality#" << pid << "\"}}";
+
+    std::set<std::size_t> devices;
+    std::vector<trace_record> records;
+    for(std::size_t i = 0; i < buffers.size(); i++)
+    {
+        std::size_t thread_tid = i + 1;
+        write_thread_name(file, pid, thread_tid, buffers[i]->get_label());
+
+        records.clear();
+        buffers[i]->copy_records(records);
+
+        for(const trace_record & record : records)
+        {
+            std::size_t tid = thread_tid;
+            if(record.track != 0)
+            {
+                tid = device_tid_base + record.track - 1;
+                devices.insert(record.track - 1);
+            }
+
+            file << ",\n{\"name\":";
+            write_string(file, record.name);
+            file << ",\"cat\":\"" << record.category << "\"";
+
+            // Chrome traces are in microseconds
+            if(record.phase != phase_operation)
+            {
+                file << ",\"ph\":\"" << get_flow_phase(record.phase)
+                     << "\",\"id\":";
+                write_event_gid(file, record.event_gid);
+
+                // the end binds to the device execution it is in
+                if(record.phase == phase_flow_end)
+                    file << ",\"bp\":\"e\"";
+            }
+            else if(record.begin == record.end)
+                file << ",\"ph\":\"i\",\"s\":\"t\"";
+            else
+                file << ",\"ph\":\"X\",\"dur\":"
+                     << (record.end - record.begin) / 1000.0;
+
+            file << ",\"ts\":" << record.begin / 1000.0
+                 << ",\"pid\":" << pid << ",\"tid\":" << tid;
+
+            if(record.phase == phase_operation && record.event_gid)
+            {
+                file << ",\"args\":{\"event\":";
+                write_event_gid(file, record.event_gid);
+                file << "}";
+            }
+            file << "}";
+        }
+    }
+
+    for(std::size_t device : devices)
+        write_thread_name(file, pid, device_tid_base + device,
+                          "device#" + std::to_string(device));
+
+    file << "\n]}\n";
+}
+
+hpx::future<void>
+tracer::flush_all()
+{
+    std::vector<hpx::naming::id_type> localities = hpx::find_all_localities();
+
+    std::vector<hpx::future<void> > futures;
+    futures.reserve(localities.size());
+
+    typedef hpx::opencl::util::detail::flush_trace_action func;
+    for(const auto & locality : localities)
+        futures.push_back(hpx::async<func>(locality));
+
+    return hpx::when_all(futures).then(
+        [](hpx::future<std::vector<hpx::future<void> > > && results)
+        {
+            for(auto & result : results.get())
+                result.get();
+        });
+}
+
+void
+hpx::opencl::util::detail::flush_trace()
+{
+    tracer::flush();
+}
@@ -0,0 +1,151 @@
+// Copyright (c)    2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef HPX_OPENCL_UTIL_TRACER_HPP_
+#define HPX_OPENCL_UTIL_TRACER_HPP_
+
+// Default includes
+#include <hpx/hpx.hpp>
+#include <hpx/config.hpp>
+
+// Export definitions
+#include "../export_definitions.hpp"
+
+// OpenCL
+#include "../cl_headers.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace hpx {
+namespace opencl {
+namespace util {
+
+    ////////////////////////////////////////////////////////
+    // Records a timeline of the OpenCL operations of this locality, in the
+    // Chrome trace event format (chrome://tracing, Perfetto).
+    //
+    // Enabled with hpx.opencl.trace=1. It records the client calls, the
+    // arrival of their actions on the server, the clEnqueue submissions
+    // and the device execution of the commands. Device times are exact
+    // with hpx.opencl.profiling=1, otherwise they end at the host side
+    // completion.
+    //
+    // Records of a command carry the GID of its client event. Flow events
+    // connect the client call that created the event, the server action
+    // that enqueued the command and its execution on the device.
+    //
+    // Every OS thread writes into its own ring buffer, which keeps the
+    // newest hpx.opencl.trace_buffer_size records. Every locality writes
+    // its own file, <hpx.opencl.trace_file>.<locality id>.json, at
+    // shutdown or on flush(). Timestamps of different localities use
+    // different clocks.
+    //
+    class HPX_OPENCL_EXPORT tracer
+    {
+    public:
+        // Whether tracing is enabled. Does not change after startup.
+        static bool enabled()
+        {
+            return is_enabled.load(std::memory_order_relaxed);
+        }
+
+        // Reads the configuration. Runs as startup function of the
+        // component module.
+        static void init();
+
+        // Flushes the trace, if enabled. Runs as shutdown function of
+        // the component module.
+        static void shutdown();
+
+        // The current time in nanoseconds
+        static std::uint64_t now();
+
+        // Records an operation of this thread. name and category need to
+        // outlive the tracer, e.g. string literals.
+        static void record( const char* name, const char* category,
+                            std::uint64_t begin, std::uint64_t end );
+
+        // Records the submission of a command to a device and, once it
+        // completed, its execution on the device. event can be NULL,
+        // event_gid is the client event of the command, if it has one.
+        static void command_submitted( const char* name,
+                                       std::size_t device_index,
+                                       cl_event event,
+                                       const hpx::naming::gid_type &
+                                           event_gid );
+
+        // Starts the flow of a client event, in the enclosing scope of
+        // this thread
+        static void event_created( const hpx::naming::gid_type & event_gid )
+        {
+            if(enabled())
+                record_flow(event_gid, true);
+        }
+
+        // Continues the flow of a client event, e.g. in the server action
+        // that enqueues its command
+        static void event_arrived( const hpx::naming::gid_type & event_gid )
+        {
+            if(enabled())
+                record_flow(event_gid, false);
+        }
+
+        // Writes the trace file of this locality. The records stay, a
+        // later flush writes them again.
+        static void flush();
+
+        // Writes the trace files of all localities
+        static hpx::future<void> flush_all();
+
+        ////////////////////////////////////////////////////
+        // Records the lifetime of a scope, if tracing is enabled
+        //
+        class scope
+        {
+        public:
+            scope( const char* name_, const char* category_ )
+              : name(name_), category(category_),
+                begin(enabled() ? now() : 0)
+            {}
+
+            ~scope()
+            {
+                if(begin != 0)
+                    record(name, category, begin, now());
+            }
+
+        private:
+            scope(const scope&);
+            scope& operator=(const scope&);
+
+            const char* name;
+            const char* category;
+            std::uint64_t begin;
+        };
+
+    private:
+        static void record_flow( const hpx::naming::gid_type & event_gid,
+                                 bool start );
+
+        static std::atomic<bool> is_enabled;
+    };
+
+    namespace detail
+    {
+        // Flushes the trace of this locality
+        HPX_OPENCL_EXPORT void flush_trace();
+
+        HPX_DEFINE_PLAIN_ACTION(flush_trace, flush_trace_action);
+    }
+
+}}}
+
+HPX_REGISTER_ACTION_DECLARATION(hpx::opencl::util::detail::flush_trace_action,
+                                hpx_opencl_util_detail_flush_trace_action)
+
+#endif
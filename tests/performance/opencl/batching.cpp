@@ -0,0 +1,187 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "util/cl_tests.hpp"
+
+#include "util/testresults.hpp"
+
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstdlib>
+#include <string>
+
+
+/*
+ * Compares the per-launch time of many small kernel launches with and
+ * without launch batching, across launch sizes.
+ */
+
+static const char kernel_src_str[] =
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n"
+"   __kernel void add_one_batched(__global uint * in, __global uint * out, \n"
+"                                 __global const ulong * table,            \n"
+"                                 uint num_launches)                       \n"
+"   {                                                                      \n"
+"       ulong tid = hpxcl_batch_global_id(table, num_launches);            \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n";
+
+// the launches per iteration
+static const std::size_t launches_per_iteration = 64;
+
+// the work items per launch
+static const std::size_t launch_sizes[] = {1, 16, 256, 4096};
+
+
+// global variables
+static intbuffer_type test_data;
+
+static void ensure_valid( intbuffer_type result, std::size_t num_elements )
+{
+    if( result.size() != num_elements ){
+        die("result size is wrong!");
+    }
+
+    for( std::size_t i = 0; i < result.size(); i++ ){
+        if(test_data[i] + 1 != result[i])
+            die("result is wrong!");
+    }
+}
+
+static void launch_test( hpx::opencl::device device,
+                         hpx::opencl::program program,
+                         std::size_t launch_size,
+                         bool batched )
+{
+
+    std::size_t num_elements = launch_size * launches_per_iteration;
+
+    hpx::opencl::buffer buffer_in =
+        device.create_buffer(CL_MEM_READ_WRITE, num_elements * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        device.create_buffer(CL_MEM_READ_WRITE, num_elements * sizeof(uint32_t));
+
+    buffer_in.enqueue_write( 0, intbuffer_type( test_data.data(), num_elements,
+                             intbuffer_type::init_mode::reference ) ).get();
+
+    hpx::opencl::kernel kernel;
+    if(batched){
+        kernel = program.create_kernel("add_one_batched");
+    } else {
+        kernel = program.create_kernel("add_one");
+    }
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+    if(batched)
+        kernel.enable_batching(2);
+
+    std::string name = batched ? "launch_batched_" : "launch_unbatched_";
+    name += std::to_string(launch_size);
+    if(hpx::get_colocation_id(hpx::launch::sync, device.get_id()) == hpx::find_here())
+        name += "_local";
+    else
+        name += "_remote";
+
+    std::map<std::string, std::string> atts;
+    atts["iterations"] = std::to_string(num_iterations);
+    atts["launches"] = std::to_string(launches_per_iteration);
+    atts["launch_size"] = std::to_string(launch_size);
+    results.start_test(name, "ms", atts);
+
+    std::vector<hpx::future<void> > futures;
+    futures.reserve(launches_per_iteration);
+
+    while(results.needs_more_testing())
+    {
+
+        // RUN!
+        hpx::util::high_resolution_timer walltime;
+        for(std::size_t it = 0; it < num_iterations; it ++)
+        {
+            futures.clear();
+            for(std::size_t i = 0; i < launches_per_iteration; i++)
+            {
+                hpx::opencl::work_size<1> size;
+                size[0].offset = i * launch_size;
+                size[0].size = launch_size;
+                futures.push_back(kernel.enqueue(size));
+            }
+            if(batched)
+                kernel.flush_batch();
+            hpx::wait_all(futures);
+        }
+
+        // Measure elapsed time
+        const double duration = walltime.elapsed();
+
+        // Check if data is still valid
+        intbuffer_type result(num_elements);
+        ensure_valid( buffer_out.enqueue_read(0, result).get(), num_elements );
+
+        // Calculate time per launch
+        const double per_launch = duration * 1000.0
+                                / (num_iterations * launches_per_iteration);
+
+        results.add(per_launch);
+    }
+
+}
+
+static void run_tests( hpx::opencl::device device )
+{
+
+    std::string src = hpx::opencl::batch_index_source;
+    src += kernel_src_str;
+
+    hpx::opencl::program program = device.create_program_with_source(
+        buffer_type(src.c_str(), src.size() + 1, buffer_type::init_mode::copy));
+    program.build();
+
+    for(std::size_t launch_size : launch_sizes)
+    {
+        launch_test(device, program, launch_size, false);
+        launch_test(device, program, launch_size, true);
+    }
+
+}
+
+static void cl_test(hpx::opencl::device local_device,
+                    hpx::opencl::device remote_device,
+                    bool distributed )
+{
+
+    if(num_iterations == 0)
+        num_iterations = 20;
+
+    // Generate random vector, large enough for the largest launch size
+    std::size_t max_elements = launch_sizes[sizeof(launch_sizes)
+                                            / sizeof(launch_sizes[0]) - 1]
+                             * launches_per_iteration;
+    std::cerr << "Generating test data ..." << std::endl;
+    test_data = intbuffer_type ( max_elements );
+    std::cerr << "Test data generated." << std::endl;
+    for(std::size_t i = 0; i < max_elements; i++){
+        test_data[i] = static_cast<uint32_t>(rand());
+    }
+
+    // Run local tests
+    run_tests(local_device);
+
+    if(distributed){
+
+        // Run remote tests
+        run_tests(remote_device);
+
+    }
+
+}
@@ -0,0 +1,125 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "util/cl_tests.hpp"
+
+#include "util/testresults.hpp"
+
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <string>
+#include <vector>
+
+
+/*
+ * Measures the rate of the operations that work on buffer handles:
+ * creating buffers and sending small amounts of data between buffers.
+ * Neither of them should need an AGAS query.
+ */
+
+static std::string get_location_name( const hpx::opencl::device & device )
+{
+    if(hpx::get_colocation_id(hpx::launch::sync, device.get_id())
+            == hpx::find_here())
+        return "local";
+    return "remote";
+}
+
+static void create_test( hpx::opencl::device device )
+{
+
+    std::string name = "create_buffer_" + get_location_name(device);
+
+    std::map<std::string, std::string> atts;
+    atts["iterations"] = std::to_string(num_iterations);
+    results.start_test(name, "1/s", atts);
+
+    while(results.needs_more_testing())
+    {
+
+        // RUN!
+        hpx::util::high_resolution_timer walltime;
+        {
+            std::vector<hpx::opencl::buffer> buffers;
+            buffers.reserve(num_iterations);
+            for(std::size_t it = 0; it < num_iterations; it ++)
+            {
+                buffers.push_back(
+                    device.create_buffer(CL_MEM_READ_WRITE, 1));
+            }
+
+            // wait for the creation of all buffers
+            for(const auto & buffer : buffers)
+                buffer.get_id();
+        }
+
+        // Measure elapsed time
+        const double duration = walltime.elapsed();
+
+        // Calculate buffers per second
+        results.add(num_iterations / duration);
+    }
+
+}
+
+static void send_test( hpx::opencl::device device1,
+                       hpx::opencl::device device2 )
+{
+
+    hpx::opencl::buffer buffer1 =
+        device1.create_buffer(CL_MEM_READ_WRITE, 1);
+    hpx::opencl::buffer buffer2 =
+        device2.create_buffer(CL_MEM_READ_WRITE, 1);
+
+    std::string name = "send_rate_" + get_location_name(device1) + "_"
+                     + get_location_name(device2);
+
+    std::map<std::string, std::string> atts;
+    atts["iterations"] = std::to_string(num_iterations);
+    results.start_test(name, "1/s", atts);
+
+    while(results.needs_more_testing())
+    {
+
+        // RUN!
+        hpx::util::high_resolution_timer walltime;
+        for(std::size_t it = 0; it < num_iterations; it ++)
+        {
+            buffer1.enqueue_send(buffer2, 0, 0, 1).dst_future.get();
+        }
+
+        // Measure elapsed time
+        const double duration = walltime.elapsed();
+
+        // Calculate sends per second
+        results.add(num_iterations / duration);
+    }
+
+}
+
+static void cl_test(hpx::opencl::device local_device,
+                    hpx::opencl::device remote_device,
+                    bool distributed )
+{
+
+    if(num_iterations == 0)
+        num_iterations = 1000;
+
+    // Run local tests
+    create_test(local_device);
+    send_test(local_device, local_device);
+
+    if(distributed){
+
+        // Run remote tests
+        create_test(remote_device);
+        send_test(local_device, remote_device);
+        send_test(remote_device, local_device);
+        send_test(remote_device, remote_device);
+
+    }
+
+}
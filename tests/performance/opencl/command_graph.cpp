@@ -0,0 +1,231 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "util/cl_tests.hpp"
+
+#include "util/testresults.hpp"
+
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstdlib>
+
+
+/*
+ * Compares the per-iteration overhead of a replayed command graph against
+ * the same chain of commands enqueued by hand.
+ *
+ * Chain: write -> kernel -> kernel -> read
+ */
+
+static const char chain_src_str[] =
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n";
+CREATE_BUFFER(chain_src, chain_src_str);
+
+
+// global variables
+static intbuffer_type test_data;
+
+static void ensure_valid( intbuffer_type result )
+{
+    if( result.size() != test_data.size() ){
+        die("result size is wrong!");
+    }
+
+    for( std::size_t i = 0; i < result.size(); i++ ){
+        if(test_data[i] + 2 != result[i])
+            die("result is wrong!");
+    }
+}
+
+static intbuffer_type to_intbuffer( buffer_type buf )
+{
+    return intbuffer_type( reinterpret_cast<uint32_t*>(buf.data()),
+                           buf.size() / sizeof(uint32_t),
+                           intbuffer_type::init_mode::copy );
+}
+
+struct chain
+{
+    hpx::opencl::buffer buffer_in;
+    hpx::opencl::buffer buffer_tmp;
+    hpx::opencl::buffer buffer_out;
+    hpx::opencl::kernel kernel1;
+    hpx::opencl::kernel kernel2;
+    hpx::opencl::work_size<1> size;
+};
+
+static chain create_chain( hpx::opencl::device device )
+{
+    std::size_t num_bytes = test_data.size() * sizeof(uint32_t);
+
+    chain c;
+    c.buffer_in  = device.create_buffer(CL_MEM_READ_WRITE, num_bytes);
+    c.buffer_tmp = device.create_buffer(CL_MEM_READ_WRITE, num_bytes);
+    c.buffer_out = device.create_buffer(CL_MEM_READ_WRITE, num_bytes);
+
+    hpx::opencl::program program = device.create_program_with_source(chain_src);
+    program.build();
+
+    c.kernel1 = program.create_kernel("add_one");
+    c.kernel2 = program.create_kernel("add_one");
+
+    c.kernel1.set_arg(0, c.buffer_in);
+    c.kernel1.set_arg(1, c.buffer_tmp);
+    c.kernel2.set_arg(0, c.buffer_tmp);
+    c.kernel2.set_arg(1, c.buffer_out);
+
+    c.size[0].offset = 0;
+    c.size[0].size = test_data.size();
+
+    return c;
+}
+
+static std::string location_name( hpx::opencl::device device )
+{
+    if(hpx::get_colocation_id(hpx::launch::sync, device.get_id()) == hpx::find_here())
+        return "local";
+    return "remote";
+}
+
+static void loop_test( hpx::opencl::device device )
+{
+
+    chain c = create_chain(device);
+
+    std::string name = "chain_loop_" + location_name(device);
+
+    std::map<std::string, std::string> atts;
+    atts["iterations"] = std::to_string(num_iterations);
+    atts["elements"] = std::to_string(test_data.size());
+    results.start_test(name, "ms", atts);
+
+    while(results.needs_more_testing())
+    {
+        intbuffer_type result;
+
+        // RUN!
+        hpx::util::high_resolution_timer walltime;
+        for(std::size_t it = 0; it < num_iterations; it ++)
+        {
+            auto fut1 = c.buffer_in.enqueue_write(0, test_data);
+            auto fut2 = c.kernel1.enqueue(c.size, fut1);
+            auto fut3 = c.kernel2.enqueue(c.size, fut2);
+            result = to_intbuffer(
+                c.buffer_out.enqueue_read( 0,
+                                           test_data.size() * sizeof(uint32_t),
+                                           fut3 ).get() );
+        }
+
+        // Measure elapsed time
+        const double duration = walltime.elapsed();
+
+        // Check if data is still valid
+        ensure_valid(result);
+
+        // Calculate overhead
+        const double overhead = duration * 1000.0 / num_iterations;
+
+        results.add(overhead);
+    }
+
+}
+
+static void graph_test( hpx::opencl::device device, bool with_arguments )
+{
+
+    chain c = create_chain(device);
+
+    hpx::opencl::command_graph graph = device.create_command_graph();
+    std::size_t write_node = graph.add_write(c.buffer_in, 0, test_data);
+    std::size_t kernel1_node = graph.add_kernel(c.kernel1, c.size, {write_node});
+    std::size_t kernel2_node = graph.add_kernel(c.kernel2, c.size, {kernel1_node});
+    graph.add_read( c.buffer_out, 0, test_data.size() * sizeof(uint32_t),
+                    {kernel2_node} );
+    graph.finalize().get();
+
+    std::string name = "chain_graph_" + location_name(device);
+    if(with_arguments)
+        name += "_args";
+
+    std::map<std::string, std::string> atts;
+    atts["iterations"] = std::to_string(num_iterations);
+    atts["elements"] = std::to_string(test_data.size());
+    results.start_test(name, "ms", atts);
+
+    while(results.needs_more_testing())
+    {
+        intbuffer_type result;
+
+        // RUN!
+        hpx::util::high_resolution_timer walltime;
+        for(std::size_t it = 0; it < num_iterations; it ++)
+        {
+            hpx::opencl::command_graph::replay_result replay_result;
+            if(with_arguments){
+                // send the input data with every replay
+                hpx::opencl::graph_arguments args;
+                args.set_write_data(write_node, test_data);
+                replay_result = graph.replay(args).get();
+            } else {
+                replay_result = graph.replay().get();
+            }
+            result = to_intbuffer(replay_result[0]);
+        }
+
+        // Measure elapsed time
+        const double duration = walltime.elapsed();
+
+        // Check if data is still valid
+        ensure_valid(result);
+
+        // Calculate overhead
+        const double overhead = duration * 1000.0 / num_iterations;
+
+        results.add(overhead);
+    }
+
+}
+
+static void cl_test(hpx::opencl::device local_device,
+                    hpx::opencl::device remote_device,
+                    bool distributed )
+{
+
+    if(testdata_size == 0)
+        testdata_size = 1024;
+
+    if(num_iterations == 0)
+        num_iterations = 50;
+
+    // Generate random vector
+    std::cerr << "Generating test data ..." << std::endl;
+    test_data = intbuffer_type ( testdata_size );
+    std::cerr << "Test data generated." << std::endl;
+    for(std::size_t i = 0; i < testdata_size; i++){
+        test_data[i] = static_cast<uint32_t>(rand());
+    }
+
+    // Run local tests
+    loop_test(local_device);
+    graph_test(local_device, false);
+    graph_test(local_device, true);
+
+    if(distributed){
+
+        // Run remote tests
+        loop_test(remote_device);
+        graph_test(remote_device, false);
+        graph_test(remote_device, true);
+
+    }
+
+}
@@ -0,0 +1,220 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "util/cl_tests.hpp"
+
+#include "util/testresults.hpp"
+
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+/*
+ * Breaks the round trip of one kernel::enqueue() down into its stages.
+ *
+ * Needs --hpx:ini=hpx.opencl.launch_stages=1. With
+ * --hpx:ini=hpx.opencl.profiling=1, the execution time on the device gets
+ * reported as well.
+ *
+ * The series give the mean of every stage per trial, their percentiles the
+ * ones of the single launches.
+ *
+ * Every launch gets waited for right away, so the server only notices the
+ * completion after the arm action of the future arrived. Stages that span
+ * two localities can only be measured on local devices, remote devices
+ * report their sum as 'transport'.
+ */
+
+static const char empty_kernel_src_str[] =
+"                                                                          \n"
+"   __kernel void empty(__global char * buf)                               \n"
+"   {                                                                      \n"
+"   }                                                                      \n"
+"                                                                          \n";
+CREATE_BUFFER(empty_kernel_src, empty_kernel_src_str);
+
+
+enum stage
+{
+    client_resolve,
+    client_send,
+    action_transfer,
+    server_enqueue,
+    server_completion,
+    server_lco_set,
+    future_ready,
+    transport,
+    device_execution,
+    total,
+    num_stages
+};
+
+static const char* stage_names[num_stages] = {
+    "client_resolve",
+    "client_send",
+    "action_transfer",
+    "server_enqueue",
+    "server_completion",
+    "server_lco_set",
+    "future_ready",
+    "transport",
+    "device_execution",
+    "total"
+};
+
+static double to_us( std::uint64_t begin, std::uint64_t end )
+{
+    return (static_cast<double>(end) - static_cast<double>(begin)) / 1000.0;
+}
+
+static void launch_stages_test( hpx::opencl::device device )
+{
+
+    bool is_local =
+        hpx::get_colocation_id(hpx::launch::sync, device.get_id())
+            == hpx::find_here();
+    bool profiling =
+        (hpx::get_config_entry("hpx.opencl.profiling", "0") == "1");
+
+    hpx::opencl::buffer buffer = device.create_buffer(CL_MEM_READ_WRITE, 1);
+
+    hpx::opencl::program program =
+        device.create_program_with_source(empty_kernel_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("empty");
+    kernel.set_arg(0, buffer);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = 1;
+
+    // warm up the code paths, the first launch pays for the setup
+    kernel.enqueue(size).get();
+
+    // the mean of every stage, per trial, and the stages of every launch.
+    // the series get reported one after another, so run enough trials for
+    // the longest one.
+    std::size_t num_trials = results.get_max_trials();
+    std::vector<std::vector<double> > trials(num_stages);
+    std::vector<std::vector<std::vector<double> > > launches(
+        num_stages, std::vector<std::vector<double> >(num_trials));
+
+    for(std::size_t trial = 0; trial < num_trials; trial++)
+    {
+        std::vector<double> values(num_stages, 0.0);
+
+        for(std::size_t it = 0; it < num_iterations; it++)
+        {
+            // RUN!
+            std::uint64_t called = hpx::util::high_resolution_clock::now();
+            hpx::future<void> fut = kernel.enqueue(size);
+            fut.wait();
+            std::uint64_t ready = hpx::util::high_resolution_clock::now();
+
+            hpx::opencl::launch_stages s =
+                hpx::opencl::get_launch_stages(fut).get();
+            if(s.resolved == 0 || s.lco_set == 0)
+                die("Launch stages are incomplete!");
+
+            values[client_resolve]    = to_us(called, s.resolved);
+            values[client_send]       = to_us(s.resolved, s.sent);
+            values[server_enqueue]    = to_us(s.action_started,
+                                              s.enqueue_returned);
+            values[server_completion] = to_us(s.enqueue_returned,
+                                              s.completed);
+            values[server_lco_set]    = to_us(s.completed, s.lco_set);
+            values[total]             = to_us(called, ready);
+
+            // the server clock is the client clock
+            if(is_local){
+                values[action_transfer] = to_us(s.sent, s.action_started);
+                values[future_ready]    = to_us(s.lco_set, ready);
+            }
+
+            values[transport] = to_us(called, ready)
+                              - to_us(called, s.sent)
+                              - to_us(s.action_started, s.lco_set);
+
+            if(profiling){
+                hpx::opencl::command_timestamps ts =
+                    hpx::opencl::get_timestamps(fut);
+                values[device_execution] = to_us(ts.started, ts.ended);
+            }
+
+            for(std::size_t i = 0; i < num_stages; i++)
+                launches[i][trial].push_back(values[i]);
+
+            fut.get();
+        }
+
+        for(std::size_t i = 0; i < num_stages; i++)
+        {
+            const std::vector<double> & stage_launches = launches[i][trial];
+            trials[i].push_back(
+                std::accumulate(stage_launches.begin(),
+                                stage_launches.end(), 0.0)
+                    / num_iterations);
+        }
+    }
+
+    // report one series per stage
+    for(std::size_t i = 0; i < num_stages; i++)
+    {
+        if(!is_local && (i == action_transfer || i == future_ready))
+            continue;
+        if(!profiling && i == device_execution)
+            continue;
+
+        std::string name = "launch_stage_";
+        name += (is_local ? "local_" : "remote_");
+        name += stage_names[i];
+
+        std::map<std::string, std::string> atts;
+        atts["iterations"] = std::to_string(num_iterations);
+        results.start_test(name, "us", atts);
+
+        // the percentiles are the ones of the single launches
+        for(std::size_t trial = 0; trial < trials[i].size(); trial++)
+        {
+            if(!results.needs_more_testing())
+                break;
+            results.add_samples(launches[i][trial]);
+            results.add(trials[i][trial]);
+        }
+    }
+
+}
+
+static void cl_test(hpx::opencl::device local_device,
+                    hpx::opencl::device remote_device,
+                    bool distributed )
+{
+
+    if(num_iterations == 0)
+        num_iterations = 100;
+
+    if(!hpx::opencl::detail::launch_stages_enabled()){
+        std::cerr << "Launch stages are disabled, run with "
+                  << "--hpx:ini=hpx.opencl.launch_stages=1" << std::endl;
+        return;
+    }
+
+    // Get localities
+    hpx::naming::id_type local_location =
+        hpx::get_colocation_id(hpx::launch::sync, local_device.get_id());
+    if(local_location != hpx::find_here())
+        die("Internal ERROR! local_location is not here.");
+
+    launch_stages_test(local_device);
+
+    if(distributed){
+        launch_stages_test(remote_device);
+    }
+
+}
@@ -15,6 +15,15 @@
 typedef hpx::serialization::serialize_buffer<char> buffer_type;
 
 
+static const char empty_kernel_src_str[] =
+"                                                                          \n"
+"   __kernel void empty(__global char * buf)                               \n"
+"   {                                                                      \n"
+"   }                                                                      \n"
+"                                                                          \n";
+CREATE_BUFFER(empty_kernel_src, empty_kernel_src_str);
+
+
 // global variables
 static buffer_type test_data;
 
@@ -305,6 +314,77 @@ static void read_test( hpx::opencl::device device , bool sync )
 
 }
 
+static void launch_test( hpx::opencl::device device , bool nowait )
+{
+
+    hpx::opencl::buffer buffer =
+        device.create_buffer(CL_MEM_READ_WRITE, test_data.size());
+
+    hpx::opencl::program program =
+        device.create_program_with_source(empty_kernel_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("empty");
+    kernel.set_arg(0, buffer);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = 1;
+
+
+    std::string name = "launch_";
+
+    if(nowait)
+        name += "nowait_";
+
+    if(hpx::get_colocation_id(hpx::launch::sync, device.get_id()) == hpx::find_here())
+        name += "local";
+    else
+        name += "remote";
+
+    std::map<std::string, std::string> atts;
+    atts["iterations"] = std::to_string(num_iterations);
+    results.start_test(name, "ms", atts);
+
+    while(results.needs_more_testing())
+    {
+        // RUN!
+        hpx::util::high_resolution_timer walltime;
+        if(nowait){
+            // Launch independent kernels without events
+            for(std::size_t it = 0; it < num_iterations; it ++)
+            {
+                kernel.enqueue_nowait(size);
+            }
+
+            // wait for finish
+            device.finish_async().get();
+        } else {
+            // Launch independent kernels
+            std::vector<hpx::future<void> > futures;
+            futures.reserve(num_iterations);
+            for(std::size_t it = 0; it < num_iterations; it ++)
+            {
+                futures.push_back(kernel.enqueue(size));
+            }
+
+            // wait for finish
+            hpx::wait_all(futures);
+            for(auto & future : futures)
+                future.get();
+        }
+
+        // Measure elapsed time
+        const double duration = walltime.elapsed();
+
+        // Calculate overhead
+        const double overhead = duration * 1000.0 / num_iterations;
+
+        results.add(overhead);
+    }
+
+}
+
 static void cl_test(hpx::opencl::device local_device,
                     hpx::opencl::device remote_device,
                     bool distributed )
@@ -347,6 +427,10 @@ static void cl_test(hpx::opencl::device local_device,
     // Run wait test
     wait_test(local_device);
 
+    // Run launch test
+    launch_test(local_device, false);
+    launch_test(local_device, true);
+
     if(distributed){
 
         // Run write test
@@ -368,6 +452,10 @@ static void cl_test(hpx::opencl::device local_device,
         // Run wait test
         wait_test(remote_device);
 
+        // Run launch test
+        launch_test(remote_device, false);
+        launch_test(remote_device, true);
+
     }
 
 
@@ -0,0 +1,414 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "util/cl_tests.hpp"
+
+#include "util/testresults.hpp"
+
+#include "../../../opencl/lcos/event.hpp"
+#include "../../../opencl/server/device.hpp"
+#include "../../../opencl/server/util/data_map.hpp"
+#include "../../../opencl/server/util/event_map.hpp"
+#include "../../../opencl/tools.hpp"
+#include "../../../opencl/util/enqueue_overloads.hpp"
+
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+/*
+ * Measures the hot paths of the OpenCL server without a kernel in between:
+ *  - event_map add/get/remove, and get() waiting for a later add()
+ *  - data_map add/get/remove
+ *  - enqueue_overloads::resolver with 0 to 64 event dependencies
+ *  - the event create -> register -> ready -> release cycle, until the
+ *    device server released the cl_event
+ *
+ * Every benchmark runs with 1, 2, 4, ... up to one concurrent task per HPX
+ * worker thread, so run it with --hpx:threads=N. Every task runs
+ * --iterations operations. The throughput series count the operations of
+ * all tasks per second. The latency series give the mean latency of every
+ * phase of an operation per trial, their percentiles the ones of the
+ * single operations.
+ */
+
+using hpx::naming::id_type;
+
+typedef hpx::opencl::lcos::event<void> event_type;
+
+// The phases of one operation. An operation stores one timestamp before
+// every phase and one after the last.
+typedef std::function<void(std::uint64_t key, std::uint64_t* stamps)>
+    operation;
+
+static const std::size_t max_phases = 4;
+
+
+static std::vector<std::size_t> get_worker_counts()
+{
+    std::size_t max_workers = hpx::get_os_thread_count();
+
+    std::vector<std::size_t> worker_counts;
+    for(std::size_t workers = 1; workers < max_workers; workers *= 2)
+        worker_counts.push_back(workers);
+    worker_counts.push_back(max_workers);
+    return worker_counts;
+}
+
+static void run_scaled( const std::string & name,
+                        const std::vector<std::string> & phases,
+                        const operation & op )
+{
+
+    for(std::size_t workers : get_worker_counts())
+    {
+        // the series get reported one after another, so run enough
+        // trials for the longest one
+        std::size_t num_trials = results.get_max_trials();
+        std::vector<double> throughputs;
+        // the latencies of every phase, per trial
+        std::vector<std::vector<std::vector<double> > > trial_latencies(
+            phases.size());
+
+        for(std::size_t trial = 0; trial < num_trials; trial++)
+        {
+            // the latencies of every phase, per task
+            std::vector<std::vector<std::vector<double> > > latencies(
+                workers, std::vector<std::vector<double> >(phases.size()));
+
+            std::uint64_t begin = hpx::util::high_resolution_clock::now();
+
+            std::vector<hpx::future<void> > futures;
+            for(std::size_t worker = 0; worker < workers; worker++)
+            {
+                futures.push_back(hpx::async(
+                    [&op, &latencies, &phases, worker]()
+                    {
+                        std::vector<std::vector<double> > & own_latencies =
+                            latencies[worker];
+                        for(auto & phase_latencies : own_latencies)
+                            phase_latencies.reserve(num_iterations);
+
+                        for(std::size_t it = 0; it < num_iterations; it++)
+                        {
+                            // unique among the operations of this trial
+                            std::uint64_t key =
+                                1 + worker * num_iterations + it;
+
+                            std::uint64_t stamps[max_phases + 1];
+                            op(key, stamps);
+
+                            for(std::size_t i = 0; i < phases.size(); i++)
+                                own_latencies[i].push_back(
+                                    (stamps[i + 1] - stamps[i]) / 1000.0);
+                        }
+                    }));
+            }
+            hpx::wait_all(futures);
+            for(auto & future : futures)
+                future.get();
+
+            std::uint64_t end = hpx::util::high_resolution_clock::now();
+
+            double seconds = (end - begin) / 1e9;
+            throughputs.push_back(workers * num_iterations / seconds);
+
+            for(std::size_t i = 0; i < phases.size(); i++)
+            {
+                std::vector<double> phase_latencies;
+                for(const auto & own_latencies : latencies)
+                    phase_latencies.insert(phase_latencies.end(),
+                                           own_latencies[i].begin(),
+                                           own_latencies[i].end());
+                trial_latencies[i].push_back(std::move(phase_latencies));
+            }
+        }
+
+        std::map<std::string, std::string> atts;
+        atts["iterations"] = std::to_string(num_iterations);
+        atts["tasks"] = std::to_string(workers);
+        std::string suffix = "_t" + std::to_string(workers);
+
+        results.start_test(name + suffix, "ops/s", atts);
+        for(double value : throughputs)
+        {
+            if(!results.needs_more_testing())
+                break;
+            results.add(value);
+        }
+
+        for(std::size_t i = 0; i < phases.size(); i++)
+        {
+            results.start_test(name + "_" + phases[i] + "_latency" + suffix,
+                               "us", atts);
+            for(const auto & phase_latencies : trial_latencies[i])
+            {
+                if(!results.needs_more_testing())
+                    break;
+                results.add_samples(phase_latencies);
+                results.add(std::accumulate(phase_latencies.begin(),
+                                            phase_latencies.end(), 0.0)
+                                / phase_latencies.size());
+            }
+        }
+    }
+
+}
+
+// The maps only compare the events, any non-null value will do
+static cl_event to_event( std::uint64_t key )
+{
+    return reinterpret_cast<cl_event>(static_cast<std::uintptr_t>(key));
+}
+
+static void ignore_deleted_event( cl_event )
+{
+}
+
+static void event_map_test()
+{
+
+    hpx::opencl::server::util::event_map map;
+    map.register_deletion_callback(&ignore_deleted_event);
+
+    {
+        std::vector<std::string> phases;
+        phases.push_back("add");
+        phases.push_back("get");
+        phases.push_back("remove");
+
+        run_scaled("event_map", phases,
+            [&map](std::uint64_t key, std::uint64_t* stamps)
+            {
+                id_type id(0, key, id_type::management_type::unmanaged);
+                cl_event event = to_event(key);
+
+                stamps[0] = hpx::util::high_resolution_clock::now();
+                map.add(id, event);
+                stamps[1] = hpx::util::high_resolution_clock::now();
+                if(map.get(id) != event)
+                    die("event_map returned the wrong event!");
+                stamps[2] = hpx::util::high_resolution_clock::now();
+                map.remove(id.get_gid());
+                stamps[3] = hpx::util::high_resolution_clock::now();
+            });
+    }
+
+    // get() waits before the event got added. The getter usually blocks
+    // by the time of the add(), as it got the chance to run first.
+    {
+        std::vector<std::string> phases;
+        phases.push_back("add");
+        phases.push_back("wakeup");
+
+        run_scaled("event_map_wait", phases,
+            [&map](std::uint64_t key, std::uint64_t* stamps)
+            {
+                id_type id(0, key, id_type::management_type::unmanaged);
+                cl_event event = to_event(key);
+
+                std::atomic<bool> started(false);
+                hpx::future<cl_event> getter = hpx::async(
+                    [&map, &started, id]()
+                    {
+                        started = true;
+                        return map.get(id);
+                    });
+                while(!started)
+                    hpx::this_thread::yield();
+                hpx::this_thread::yield();
+
+                stamps[0] = hpx::util::high_resolution_clock::now();
+                map.add(id, event);
+                stamps[1] = hpx::util::high_resolution_clock::now();
+                if(getter.get() != event)
+                    die("event_map returned the wrong event!");
+                stamps[2] = hpx::util::high_resolution_clock::now();
+
+                map.remove(id.get_gid());
+            });
+    }
+
+}
+
+static void data_map_test()
+{
+
+    hpx::opencl::server::util::data_map map;
+    buffer_type data(16);
+    std::fill(data.data(), data.data() + data.size(), '\0');
+
+    std::vector<std::string> phases;
+    phases.push_back("add");
+    phases.push_back("get");
+    phases.push_back("remove");
+
+    run_scaled("data_map", phases,
+        [&map, &data](std::uint64_t key, std::uint64_t* stamps)
+        {
+            cl_event event = to_event(key);
+
+            stamps[0] = hpx::util::high_resolution_clock::now();
+            map.add(event, data);
+            stamps[1] = hpx::util::high_resolution_clock::now();
+            map.get(event);
+            stamps[2] = hpx::util::high_resolution_clock::now();
+            map.remove(event);
+            stamps[3] = hpx::util::high_resolution_clock::now();
+        });
+
+}
+
+static void resolver_test( hpx::opencl::device device )
+{
+
+    static const std::size_t max_dependencies = 64;
+
+    // completed events of the device, they resolve without an import
+    hpx::opencl::buffer buffer = device.create_buffer(CL_MEM_READ_WRITE, 1);
+    buffer_type data(1);
+    data[0] = '\0';
+
+    std::vector<hpx::shared_future<void> > events;
+    for(std::size_t i = 0; i < max_dependencies; i++)
+        events.push_back(buffer.enqueue_write(0, data).share());
+    hpx::wait_all(events);
+
+    hpx::naming::gid_type device_gid = device.get_id().get_gid();
+
+    std::vector<std::string> phases;
+    phases.push_back("resolve");
+
+    for(std::size_t num_dependencies = 0;
+        num_dependencies <= max_dependencies;
+        num_dependencies = (num_dependencies == 0 ? 1 : num_dependencies * 2))
+    {
+        std::vector<hpx::shared_future<void> > dependencies(
+            events.begin(), events.begin() + num_dependencies);
+
+        run_scaled("resolver_" + std::to_string(num_dependencies) + "deps",
+                   phases,
+            [&dependencies, &device_gid, num_dependencies](
+                std::uint64_t, std::uint64_t* stamps)
+            {
+                stamps[0] = hpx::util::high_resolution_clock::now();
+                hpx::opencl::util::resolved_events resolved =
+                    hpx::opencl::util::enqueue_overloads::resolver(
+                        device_gid, dependencies);
+                stamps[1] = hpx::util::high_resolution_clock::now();
+
+                if(resolved.event_ids.size() != num_dependencies)
+                    die("resolver dropped dependencies!");
+            });
+    }
+
+}
+
+static void event_lifecycle_test( hpx::opencl::device device )
+{
+
+    std::shared_ptr<hpx::opencl::server::device> parent_device =
+        hpx::get_ptr<hpx::opencl::server::device>(device.get_id()).get();
+    cl_context context = parent_device->get_context();
+    id_type device_id = device.get_id();
+
+    std::vector<std::string> phases;
+    phases.push_back("create");
+    phases.push_back("register");
+    phases.push_back("ready");
+    phases.push_back("release");
+
+    // Runs every operation on a medium stack thread, OpenCL calls only run
+    // properly on large stack size. The hop is not part of the phases.
+    auto lifecycle = [&parent_device, context, device_id](
+            std::uint64_t* stamps)
+        {
+            HPX_ASSERT(hpx::opencl::tools::runs_on_medium_stack());
+
+            // a completed OpenCL event, as if a command finished. The extra
+            // reference tells when the server released its own one.
+            cl_int err;
+            cl_event event_cl = clCreateUserEvent(context, &err);
+            cl_ensure(err, "clCreateUserEvent()");
+            err = clSetUserEventStatus(event_cl, CL_COMPLETE);
+            cl_ensure(err, "clSetUserEventStatus()");
+            err = clRetainEvent(event_cl);
+            cl_ensure(err, "clRetainEvent()");
+
+            stamps[0] = hpx::util::high_resolution_clock::now();
+            {
+                event_type event(device_id);
+                hpx::future<void> future = event.get_future();
+                stamps[1] = hpx::util::high_resolution_clock::now();
+
+                parent_device->register_event(event.get_event_id(), event_cl);
+                stamps[2] = hpx::util::high_resolution_clock::now();
+
+                future.get();
+                stamps[3] = hpx::util::high_resolution_clock::now();
+            }
+
+            // the event unregisters itself asynchronously, wait until the
+            // server removed it from its event map
+            for(;;)
+            {
+                cl_uint references;
+                err = clGetEventInfo(event_cl, CL_EVENT_REFERENCE_COUNT,
+                                     sizeof(cl_uint), &references, NULL);
+                cl_ensure(err, "clGetEventInfo()");
+                if(references <= 1)
+                    break;
+                hpx::this_thread::yield();
+            }
+            stamps[4] = hpx::util::high_resolution_clock::now();
+
+            err = clReleaseEvent(event_cl);
+            cl_ensure(err, "clReleaseEvent()");
+        };
+
+    run_scaled("event_lifecycle", phases,
+        [&lifecycle](std::uint64_t, std::uint64_t* stamps)
+        {
+            hpx::threads::executors::default_executor exec(
+                                      hpx::threads::thread_priority_normal,
+                                      hpx::threads::thread_stacksize_medium);
+
+            hpx::threads::async_execute(exec, lifecycle, stamps).get();
+        });
+
+}
+
+static void cl_test(hpx::opencl::device local_device,
+                    hpx::opencl::device remote_device,
+                    bool distributed )
+{
+
+    if(num_iterations == 0)
+        num_iterations = 1000;
+
+    // Get localities
+    hpx::naming::id_type local_location =
+        hpx::get_colocation_id(hpx::launch::sync, local_device.get_id());
+    if(local_location != hpx::find_here())
+        die("Internal ERROR! local_location is not here.");
+
+    event_map_test();
+
+    data_map_test();
+
+    // the server objects are only reachable on the local device
+    resolver_test(local_device);
+
+    event_lifecycle_test(local_device);
+
+}
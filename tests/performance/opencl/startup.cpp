@@ -0,0 +1,153 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "util/cl_tests.hpp"
+
+#include "util/testresults.hpp"
+
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <string>
+
+
+/*
+ * Measures how long it takes to create all devices of a locality, including
+ * their contexts and command queues, and to create the first buffer.
+ *
+ * create_devices shares the devices of a locality through its device
+ * registry. The cold series releases the devices after every iteration,
+ * so every iteration creates them anew. The cached series keeps one
+ * reference, so every iteration only looks them up.
+ */
+
+static std::vector<hpx::opencl::device>
+create_all_devices( hpx::naming::id_type locality )
+{
+    return hpx::opencl::create_devices( locality, CL_DEVICE_TYPE_ALL,
+                                        "OpenCL 1.1" ).get();
+}
+
+// The test harness holds a reference of the registry entries, which would
+// turn every creation into a lookup. Drops it, together with our own. The
+// harness keeps its devices alive through their clients.
+static void drop_registry_entries( hpx::naming::id_type locality )
+{
+    std::vector<hpx::opencl::device> devices = create_all_devices(locality);
+
+    // releasing entries that are gone already has no effect
+    hpx::opencl::release_devices(devices).get();
+    hpx::opencl::release_devices(devices).get();
+}
+
+static void startup_test( hpx::naming::id_type locality )
+{
+
+    std::string suffix;
+    if(locality == hpx::find_here())
+        suffix = "_local";
+    else
+        suffix = "_remote";
+
+    std::map<std::string, std::string> atts;
+    atts["iterations"] = std::to_string(num_iterations);
+
+    std::size_t num_devices = 0;
+
+    // Cold: every iteration creates the devices
+    drop_registry_entries(locality);
+    hpx::naming::gid_type previous_gid;
+
+    results.start_test("create_devices_cold" + suffix, "ms", atts);
+    while(results.needs_more_testing())
+    {
+
+        // RUN!
+        double duration = 0.0;
+        for(std::size_t it = 0; it < num_iterations; it ++)
+        {
+            hpx::util::high_resolution_timer walltime;
+
+            std::vector<hpx::opencl::device> devices =
+                create_all_devices(locality);
+            num_devices = devices.size();
+
+            // first use of one device
+            if(!devices.empty())
+                devices[0].create_buffer(CL_MEM_READ_WRITE, 1).get_id();
+
+            duration += walltime.elapsed();
+
+            if(devices.empty())
+                continue;
+
+            // make sure this was no lookup
+            if(devices[0].get_id().get_gid() == previous_gid)
+                die("create_devices returned cached devices!");
+            previous_gid = devices[0].get_id().get_gid();
+
+            hpx::opencl::release_devices(devices).get();
+        }
+
+        // Calculate time per startup
+        results.add(duration * 1000.0 / num_iterations);
+    }
+
+    // Cached: every iteration looks the devices up
+    std::vector<hpx::opencl::device> kept_devices =
+        create_all_devices(locality);
+
+    results.start_test("create_devices_cached" + suffix, "ms", atts);
+    while(results.needs_more_testing())
+    {
+
+        // RUN!
+        hpx::util::high_resolution_timer walltime;
+        for(std::size_t it = 0; it < num_iterations; it ++)
+        {
+            std::vector<hpx::opencl::device> devices =
+                create_all_devices(locality);
+
+            // first use of one device
+            if(!devices.empty())
+                devices[0].create_buffer(CL_MEM_READ_WRITE, 1).get_id();
+
+            hpx::opencl::release_devices(devices).get();
+        }
+
+        // Measure elapsed time
+        const double duration = walltime.elapsed();
+
+        // Calculate time per startup
+        results.add(duration * 1000.0 / num_iterations);
+    }
+
+    hpx::opencl::release_devices(kept_devices).get();
+
+    std::cerr << "create_devices" << suffix << ": " << num_devices
+              << " devices" << std::endl;
+
+}
+
+static void cl_test(hpx::opencl::device local_device,
+                    hpx::opencl::device remote_device,
+                    bool distributed )
+{
+
+    if(num_iterations == 0)
+        num_iterations = 5;
+
+    // Run local tests
+    startup_test(hpx::find_here());
+
+    if(distributed){
+
+        // Run remote tests
+        startup_test(hpx::get_colocation_id(hpx::launch::sync,
+                                            remote_device.get_id()));
+
+    }
+
+}
@@ -149,6 +149,7 @@ static std::vector<hpx::opencl::device> init(variables_map & vm)
 
 int hpx_main(variables_map & vm)
 {
+    std::size_t num_regressions = 0;
     {
         if (vm.count("format")){
             std::string format = vm["format"].as<std::string>();
@@ -169,6 +170,10 @@ int hpx_main(variables_map & vm)
         if (vm.count("iterations")){
             num_iterations = vm["iterations"].as<std::size_t>();
         }
+        results.set_warmup_trials( vm["warmup"].as<std::size_t>() );
+        results.set_trials( vm["min-trials"].as<std::size_t>(),
+                            vm["max-trials"].as<std::size_t>() );
+        results.set_confidence_target( vm["confidence"].as<double>() );
 
         auto devices = init(vm);   
 
@@ -180,10 +185,24 @@ int hpx_main(variables_map & vm)
         std::cout << results;
 
         std::cerr << std::endl;
+
+        if (vm.count("save-baseline")){
+            results.save_baseline( vm["save-baseline"].as<std::string>() );
+        }
+        if (vm.count("baseline")){
+            num_regressions = results.compare_to_baseline(
+                                    vm["baseline"].as<std::string>(),
+                                    vm["threshold"].as<double>(),
+                                    std::cerr );
+        }
     }
     
     hpx::finalize();
-    return hpx::util::report_errors();
+
+    int errors = hpx::util::report_errors();
+    if(errors == 0 && num_regressions > 0)
+        return 1;
+    return errors;
 }
 
 
@@ -209,6 +228,31 @@ int main(int argc, char* argv[])
         ( "enable"
         , value<std::vector<std::string> >()
         , "only enables certain tests" )
+        ( "warmup"
+        , value<std::size_t>()->default_value(1)
+        , "the number of trials per test that get discarded as warm-up" )
+        ( "min-trials"
+        , value<std::size_t>()->default_value(10)
+        , "the minimum number of trials per test" )
+        ( "max-trials"
+        , value<std::size_t>()->default_value(100)
+        , "the maximum number of trials per test" )
+        ( "confidence"
+        , value<double>()->default_value(0.02)
+        , "stop a test once the 95% confidence interval of its mean is "
+          "narrower than this fraction of the mean" )
+        ( "baseline"
+        , value<std::string>()
+        , "compares the results with a JSON file of an earlier run and "
+          "fails on regressions" )
+        ( "save-baseline"
+        , value<std::string>()
+        , "writes the results to a JSON file, for later runs to compare "
+          "with" )
+        ( "threshold"
+        , value<double>()->default_value(0.05)
+        , "the slowdown, as fraction of the baseline median, past which a "
+          "significant difference counts as regression" )
         ;
 
     return hpx::init(cmdline, argc, argv);
@@ -9,7 +9,14 @@
 #include <hpx/hpx.hpp>
 #include <hpx/include/iostreams.hpp>
 
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
 #include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 using hpx::opencl::tests::performance::testresults;
 
@@ -33,6 +40,36 @@ testresults::set_output_tabbed()
     output_format = TABBED;
 }
 
+void
+testresults::set_warmup_trials( std::size_t num )
+{
+    warmup_trials = num;
+}
+
+void
+testresults::set_trials( std::size_t min, std::size_t max )
+{
+    if(min < 2)
+        min = 2;
+    if(max < min)
+        max = min;
+
+    min_trials = min;
+    max_trials = max;
+}
+
+void
+testresults::set_confidence_target( double relative )
+{
+    confidence_target = relative;
+}
+
+std::size_t
+testresults::get_max_trials() const
+{
+    return warmup_trials + max_trials;
+}
+
 void
 testresults::start_test( std::string name,
                          std::string unit,
@@ -67,10 +104,32 @@ void
 testresults::add( double result )
 {
     std::cerr << "." << std::flush;
-    results.back().test_entries.push_back(result);
-    if(results.back().test_entries.size() >= 10){
-        std::cerr << std::endl;
-    }
+
+    testseries& series = results.back();
+    if(series.warmup_entries.size() < warmup_trials)
+        series.warmup_entries.push_back(result);
+    else
+        series.test_entries.push_back(result);
+}
+
+void
+testresults::add_samples( const std::vector<double> & samples )
+{
+    testseries& series = results.back();
+    if(series.warmup_entries.size() < warmup_trials)
+        return;
+
+    for(double sample : samples)
+        series.samples.add(sample);
+}
+
+bool
+testresults::has_converged( const testseries & series ) const
+{
+    double mean = series.get_mean();
+    double interval = series.get_confidence_interval();
+
+    return interval <= confidence_target * std::fabs(mean);
 }
 
 bool
@@ -79,10 +138,22 @@ testresults::needs_more_testing()
     if(!current_test_valid)
         return false;
 
-    if(results.back().test_entries.size() >= 10)
-        return false;
+    const testseries& series = results.back();
+    std::size_t num_trials = series.test_entries.size();
+
+    if(series.warmup_entries.size() < warmup_trials)
+        return true;
+
+    if(num_trials < min_trials)
+        return true;
+
+    if(num_trials < max_trials && !has_converged(series))
+        return true;
 
-    return true;
+    // series is done
+    std::cerr << " " << num_trials << " trials" << std::endl;
+    current_test_valid = false;
+    return false;
 }
 
 static std::size_t
@@ -113,55 +184,52 @@ double_to_str(double num)
     return str.str();
 }
 
-void
-testresults::print_default( std::ostream& os ) const
+static std::vector<std::string>
+get_headline()
 {
-    std::vector<std::vector<std::string> > output;
-
     std::vector<std::string> headline;
     headline.push_back("test");
     headline.push_back("atts");
     headline.push_back("units");
+    headline.push_back("trials");
     headline.push_back("median");
     headline.push_back("mean");
     headline.push_back("stddev");
+    headline.push_back("ci95");
     headline.push_back("min");
     headline.push_back("max");
-    headline.push_back("trial0");
-    headline.push_back("trial1");
-    headline.push_back("trial2");
-    headline.push_back("trial3");
-    headline.push_back("trial4");
-    headline.push_back("trial5");
-    headline.push_back("trial6");
-    headline.push_back("trial7");
-    headline.push_back("trial8");
-    headline.push_back("trial9");
+    headline.push_back("p90");
+    headline.push_back("p99");
+    headline.push_back("p99.9");
+    return headline;
+}
+
+void
+testresults::print_default( std::ostream& os ) const
+{
+    std::vector<std::vector<std::string> > output;
+
+    std::vector<std::string> headline = get_headline();
     output.push_back(headline);
 
     // fill with results
     for(const auto& row : results){
 
-        if(row.test_entries.size() != 10)
-        {
-            os << "ERROR! test_entries.size() != 10!" << std::endl;
-            break;
-        }
-
         std::vector<std::string> line;
 
         line.push_back(row.series_name);
         line.push_back(row.get_atts());
         line.push_back(row.unit);
+        line.push_back(std::to_string(row.test_entries.size()));
         line.push_back(double_to_str(row.get_median()));
         line.push_back(double_to_str(row.get_mean()));
         line.push_back(double_to_str(row.get_stddev()));
+        line.push_back(double_to_str(row.get_confidence_interval()));
         line.push_back(double_to_str(row.get_min()));
         line.push_back(double_to_str(row.get_max()));
-
-        for(const auto& res : row.test_entries){
-            line.push_back(double_to_str(res));
-        }
+        line.push_back(double_to_str(row.get_percentile(90.0)));
+        line.push_back(double_to_str(row.get_percentile(99.0)));
+        line.push_back(double_to_str(row.get_percentile(99.9)));
 
         output.push_back(line);
     }
@@ -193,39 +261,32 @@ void
 testresults::print_tabbed( std::ostream& os ) const
 {
     // print headline
-    os << "test\tatts\tunits\tmedian\tmean\tstddev\tmin\tmax\ttrial0\ttrial1\t"
-       << "trial2\ttrial3\ttrial4\ttrial5\ttrial6\ttrial7\ttrial8\ttrial9"
-       << std::endl;
+    std::vector<std::string> headline = get_headline();
+    for(std::size_t i = 0; i < headline.size(); i++){
+        if(i != 0)
+            os << "\t";
+        os << headline[i];
+    }
+    os << std::endl;
 
     for(const auto& row : results){
 
-        if(row.test_entries.size() != 10)
-        {
-            os << "ERROR! test_entries.size() != 10!" << std::endl;
-            break;
-        }
-
         os << row.series_name << "\t";
 
         os << row.get_atts() << "\t";
 
         os << row.unit << "\t";
 
+        os << row.test_entries.size() << "\t";
         os << row.get_median() << "\t";
         os << row.get_mean() << "\t";
         os << row.get_stddev() << "\t";
+        os << row.get_confidence_interval() << "\t";
         os << row.get_min() << "\t";
         os << row.get_max() << "\t";
-
-        bool is_first = true;
-        for(const auto& res : row.test_entries){
-            if(is_first){
-                is_first = false;
-            } else {
-                os << "\t";
-            }
-            os << res;
-        }
+        os << row.get_percentile(90.0) << "\t";
+        os << row.get_percentile(99.0) << "\t";
+        os << row.get_percentile(99.9);
 
         os << std::endl;
 
@@ -233,6 +294,20 @@ testresults::print_tabbed( std::ostream& os ) const
 
 }
 
+static void
+print_json_array( std::ostream& os, const std::vector<double> & entries )
+{
+    os << "[";
+    for(std::size_t j = 0; j < entries.size(); j++){
+        if(j != 0)
+            os << ",";
+        os << std::endl << "        " << entries[j];
+    }
+    if(!entries.empty())
+        os << std::endl << "      ";
+    os << "]";
+}
+
 void
 testresults::print_json( std::ostream& os ) const
 {
@@ -243,8 +318,6 @@ testresults::print_json( std::ostream& os ) const
         const auto& row = results[i];
         os << "    \"" << row.series_name << "\": {" << std::endl;
 
-        HPX_ASSERT(row.test_entries.size() == 10);
-
         // atts
         os << "      \"atts\": {" << std::endl;
         for( auto it = row.atts.begin(); it != row.atts.end(); ){
@@ -266,22 +339,51 @@ testresults::print_json( std::ostream& os ) const
         os << "      \"median\": " << row.get_median() << "," << std::endl;
         os << "      \"mean\":   " << row.get_mean() << "," << std::endl;
         os << "      \"stddev\": " << row.get_stddev() << "," << std::endl;
+        os << "      \"ci95\":   " << row.get_confidence_interval() << ","
+           << std::endl;
         os << "      \"min\":    " << row.get_min() << "," << std::endl;
         os << "      \"max\":    " << row.get_max() << "," << std::endl;
+        os << "      \"converged\": "
+           << (has_converged(row) ? "true" : "false") << "," << std::endl;
+
+        // percentiles
+        os << "      \"percentiles_of\": \""
+           << (row.samples.get_count() == 0 ? "trials" : "operations")
+           << "\"," << std::endl;
+        os << "      \"operations\": " << row.samples.get_count() << ","
+           << std::endl;
+        os << "      \"percentiles\": {" << std::endl;
+        os << "        \"p50\":   " << row.get_percentile(50.0) << ","
+           << std::endl;
+        os << "        \"p90\":   " << row.get_percentile(90.0) << ","
+           << std::endl;
+        os << "        \"p99\":   " << row.get_percentile(99.0) << ","
+           << std::endl;
+        os << "        \"p99.9\": " << row.get_percentile(99.9) << std::endl;
+        os << "      }," << std::endl;
 
-        // trials
-        os << "      \"trials\": [" << std::endl;
-        for(std::size_t j = 0; j < row.test_entries.size(); j++){
-            const auto& res = row.test_entries[j];
-
-            os << "        " << res;
-
-            if(j < row.test_entries.size() - 1)
-                os << "," << std::endl;
-            else
-                os << std::endl;
+        // raw samples
+        os << "      \"warmup\": ";
+        print_json_array(os, row.warmup_entries);
+        os << "," << std::endl;
+
+        os << "      \"trials\": ";
+        print_json_array(os, row.test_entries);
+
+        // the operations, as [value, count] per bucket
+        if(row.samples.get_count() != 0){
+            os << "," << std::endl << "      \"histogram\": [";
+            bool first = true;
+            for(const auto & bucket : row.samples.get_buckets()){
+                if(!first)
+                    os << ",";
+                first = false;
+                os << std::endl << "        [" << bucket.first << ", "
+                   << bucket.second << "]";
+            }
+            os << std::endl << "      ]";
         }
-        os << "      ]" << std::endl;
+        os << std::endl;
 
         if(i < results.size() - 1)
             os << "    }," << std::endl;
@@ -293,6 +395,220 @@ testresults::print_json( std::ostream& os ) const
     os << "}" << std::endl;
 }
 
+void
+testresults::save_baseline( const std::string & filename ) const
+{
+    std::ofstream file(filename.c_str(), std::ios::trunc);
+    if(!file)
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "testresults::save_baseline()",
+                            "Unable to write '" + filename + "'!");
+
+    print_json(file);
+}
+
+static double student_t_975( std::size_t degrees_of_freedom );
+
+namespace {
+
+    struct baseline_series
+    {
+        std::string unit;
+        std::vector<double> trials;
+    };
+
+    std::map<std::string, baseline_series>
+    read_baseline( const std::string & filename )
+    {
+        boost::property_tree::ptree tree;
+        try {
+            boost::property_tree::read_json(filename, tree);
+        } catch (std::exception const& e) {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "testresults::compare_to_baseline()",
+                                "Unable to read baseline '" + filename
+                                + "': " + e.what());
+        }
+
+        // iterate instead of get(), names and keys like p99.9 contain the
+        // path separator
+        std::map<std::string, baseline_series> series;
+        for(const auto & test : tree.get_child("tests",
+                                        boost::property_tree::ptree())){
+            baseline_series & entry = series[test.first];
+            for(const auto & field : test.second){
+                if(field.first == "unit"){
+                    entry.unit = field.second.data();
+                } else if(field.first == "trials"){
+                    for(const auto & trial : field.second)
+                        entry.trials.push_back(
+                            trial.second.get_value<double>());
+                }
+            }
+        }
+
+        return series;
+    }
+
+    double get_mean( const std::vector<double> & values )
+    {
+        double sum = 0;
+        for(const double& val : values)
+            sum += val;
+        return sum / values.size();
+    }
+
+    double get_sample_variance( const std::vector<double> & values )
+    {
+        double mean = get_mean(values);
+        double sum = 0;
+        for(const double& val : values)
+            sum += (val - mean) * (val - mean);
+        return sum / (values.size() - 1);
+    }
+
+    double get_median( std::vector<double> values )
+    {
+        std::sort(values.begin(), values.end());
+        std::size_t size = values.size();
+        if(size % 2 == 0)
+            return (values[size / 2 - 1] + values[size / 2]) / 2;
+        return values[size / 2];
+    }
+
+    // Welch's t-test, two-sided at 5%
+    bool differs_significantly( const std::vector<double> & a,
+                                const std::vector<double> & b )
+    {
+        if(a.size() < 2 || b.size() < 2)
+            return false;
+
+        double va = get_sample_variance(a) / a.size();
+        double vb = get_sample_variance(b) / b.size();
+
+        if(va + vb == 0)
+            return get_mean(a) != get_mean(b);
+
+        double t = (get_mean(a) - get_mean(b)) / std::sqrt(va + vb);
+
+        // Welch-Satterthwaite
+        double df = (va + vb) * (va + vb)
+                  / ( va * va / (a.size() - 1) + vb * vb / (b.size() - 1) );
+
+        return std::fabs(t) > student_t_975(
+                                static_cast<std::size_t>(std::floor(df)));
+    }
+
+    // rates are better when higher, times when lower
+    bool higher_is_better( const std::string & unit )
+    {
+        return unit.find("/s") != std::string::npos;
+    }
+}
+
+std::size_t
+testresults::compare_to_baseline( const std::string & filename,
+                                  double threshold,
+                                  std::ostream & os ) const
+{
+    std::map<std::string, baseline_series> baseline =
+        read_baseline(filename);
+
+    std::vector<std::vector<std::string> > output;
+
+    std::vector<std::string> headline;
+    headline.push_back("test");
+    headline.push_back("units");
+    headline.push_back("baseline");
+    headline.push_back("current");
+    headline.push_back("change");
+    headline.push_back("significant");
+    headline.push_back("status");
+    output.push_back(headline);
+
+    std::size_t num_regressions = 0;
+    for(const auto& row : results){
+
+        std::vector<std::string> line;
+        line.push_back(row.series_name);
+        line.push_back(row.unit);
+
+        auto it = baseline.find(row.series_name);
+        if(it == baseline.end() || it->second.trials.empty()
+                                || row.test_entries.empty()){
+            line.push_back("-");
+            line.push_back(double_to_str(row.get_median()));
+            line.push_back("-");
+            line.push_back("-");
+            line.push_back("new");
+            output.push_back(line);
+            continue;
+        }
+
+        const baseline_series& base = it->second;
+        double base_median = get_median(base.trials);
+        double median = row.get_median();
+
+        // positive changes are slowdowns
+        double change = 0;
+        if(base_median != 0){
+            change = (median - base_median) / std::fabs(base_median);
+            if(higher_is_better(row.unit) && change != 0)
+                change = -change;
+        }
+
+        bool significant =
+            differs_significantly(row.test_entries, base.trials);
+
+        std::string status = "ok";
+        if(base.unit != row.unit){
+            status = "unit changed";
+        } else if(significant && change > threshold){
+            status = "REGRESSION";
+            num_regressions++;
+        } else if(significant && change < -threshold){
+            status = "improved";
+        }
+
+        std::stringstream change_str;
+        change_str << std::showpos << std::fixed << std::setprecision(1)
+                   << change * 100.0 << "%";
+
+        line.push_back(double_to_str(base_median));
+        line.push_back(double_to_str(median));
+        line.push_back(change_str.str());
+        line.push_back(significant ? "yes" : "no");
+        line.push_back(status);
+        output.push_back(line);
+    }
+
+    // compute widths of columns
+    std::vector<std::size_t> column_widths;
+    for(std::size_t col = 0; col < headline.size(); col++){
+        column_widths.push_back(get_column_width(output,col));
+    }
+
+    // print
+    for(const auto& row : output){
+        for(std::size_t i = 0; i < row.size(); i++){
+            if(i != 0)
+                os << " ";
+
+            os << row[i];
+
+            for(std::size_t j = row[i].length(); j < column_widths[i]; j++){
+                os << " ";
+            }
+        }
+        os << std::endl;
+    }
+
+    os << num_regressions << " regression(s) past "
+       << threshold * 100.0 << "%" << std::endl;
+
+    return num_regressions;
+}
+
 std::ostream&
 hpx::opencl::tests::performance::operator<<(std::ostream& os, const testresults& result)
 {
@@ -312,6 +628,9 @@ hpx::opencl::tests::performance::operator<<(std::ostream& os, const testresults&
 double
 testresults::testseries::get_min() const
 {
+    if(test_entries.empty())
+        return 0;
+
     double min = test_entries[0];
     
     for(const double& val : test_entries){
@@ -325,6 +644,9 @@ testresults::testseries::get_min() const
 double
 testresults::testseries::get_max() const
 {
+    if(test_entries.empty())
+        return 0;
+
     double max = test_entries[0];
     
     for(const double& val : test_entries){
@@ -338,6 +660,9 @@ testresults::testseries::get_max() const
 double
 testresults::testseries::get_stddev() const
 {
+    if(test_entries.empty())
+        return 0;
+
     double mean = get_mean();
 
     double sum = 0;
@@ -347,12 +672,14 @@ testresults::testseries::get_stddev() const
         sum += (diff*diff);
     }
 
-    return sum/test_entries.size();
+    return std::sqrt(sum/test_entries.size());
 }
 
 double
 testresults::testseries::get_mean() const
 {
+    if(test_entries.empty())
+        return 0;
 
     double sum = 0;
     
@@ -363,32 +690,179 @@ testresults::testseries::get_mean() const
     return sum/test_entries.size();
 }
 
-double
-testresults::testseries::get_median() const
+// p in [0,100], interpolated between the values
+static double
+get_percentile_of( const std::vector<double> & values, double p )
 {
-
-    double median;
-    std::size_t size = test_entries.size();
+    std::size_t size = values.size();
 
     if(size == 0)
         return 0;
 
     if(size == 1)
-        return test_entries[0];
+        return values[0];
 
-    std::vector<double> sorted_entries(test_entries);
+    std::vector<double> sorted_entries(values);
     std::sort(sorted_entries.begin(), sorted_entries.end());
 
-    if (size  % 2 == 0)
-    {
-        median = (sorted_entries[size / 2 - 1] + sorted_entries[size / 2]) / 2;
+    // linear interpolation between the closest ranks
+    double rank = p / 100.0 * (size - 1);
+    std::size_t lower = static_cast<std::size_t>(std::floor(rank));
+    if(lower >= size - 1)
+        return sorted_entries[size - 1];
+
+    double fraction = rank - lower;
+    return sorted_entries[lower]
+         + fraction * (sorted_entries[lower + 1] - sorted_entries[lower]);
+}
+
+double
+testresults::testseries::get_median() const
+{
+    // the baselines compare the trials
+    return get_percentile_of(test_entries, 50.0);
+}
+
+double
+testresults::testseries::get_percentile( double p ) const
+{
+    if(samples.get_count() != 0)
+        return samples.get_percentile(p);
+    return get_percentile_of(test_entries, p);
+}
+
+// Shifts the binary exponents of all doubles, down to -1074, above zero
+static const std::int64_t histogram_exponent_offset = 1100;
+
+// Bucket 0 holds zero. The others count up with the magnitude and down
+// for negative values.
+std::int64_t
+testresults::histogram::get_bucket( double value )
+{
+    if(value == 0)
+        return 0;
+
+    int exponent;
+    double mantissa = std::frexp(std::fabs(value), &exponent);
+
+    // mantissa is in [0.5, 1)
+    std::int64_t sub_bucket =
+        static_cast<std::int64_t>((mantissa - 0.5) * 2 * sub_buckets);
+    if(sub_bucket >= sub_buckets)
+        sub_bucket = sub_buckets - 1;
+
+    std::int64_t bucket =
+        (exponent + histogram_exponent_offset) * sub_buckets + sub_bucket + 1;
+    return value < 0 ? -bucket : bucket;
+}
+
+// The middle of a bucket
+double
+testresults::histogram::get_bucket_value( std::int64_t bucket )
+{
+    if(bucket == 0)
+        return 0;
+
+    std::int64_t magnitude = (bucket < 0 ? -bucket : bucket) - 1;
+    int exponent = static_cast<int>(magnitude / sub_buckets
+                                    - histogram_exponent_offset);
+    double sub_bucket = static_cast<double>(magnitude % sub_buckets);
+
+    double value = std::ldexp(0.5 + (sub_bucket + 0.5) / (2 * sub_buckets),
+                              exponent);
+    return bucket < 0 ? -value : value;
+}
+
+void
+testresults::histogram::add( double value )
+{
+    if(count == 0 || value < min)
+        min = value;
+    if(count == 0 || value > max)
+        max = value;
+
+    buckets[get_bucket(value)]++;
+    count++;
+}
+
+double
+testresults::histogram::get_percentile( double p ) const
+{
+    if(count == 0)
+        return 0;
+
+    // the sample of the nearest rank, counted from 1
+    std::uint64_t rank =
+        static_cast<std::uint64_t>(std::ceil(p / 100.0 * count));
+    if(rank < 1)
+        rank = 1;
+
+    std::uint64_t seen = 0;
+    for(const auto & bucket : buckets){
+        seen += bucket.second;
+        if(seen >= rank){
+            // the extremes are exact
+            double value = get_bucket_value(bucket.first);
+            return std::min(std::max(value, min), max);
+        }
     }
-    else 
-    {
-        median = sorted_entries[size / 2];
+
+    return max;
+}
+
+std::vector<std::pair<double, std::uint64_t> >
+testresults::histogram::get_buckets() const
+{
+    std::vector<std::pair<double, std::uint64_t> > result;
+    result.reserve(buckets.size());
+    for(const auto & bucket : buckets)
+        result.push_back(std::make_pair(get_bucket_value(bucket.first),
+                                        bucket.second));
+    return result;
+}
+
+// The 97.5% quantile of the Student's t-distribution
+static double
+student_t_975( std::size_t degrees_of_freedom )
+{
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+        2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+        2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+        2.048, 2.045, 2.042 };
+
+    if(degrees_of_freedom == 0)
+        return 0;
+    if(degrees_of_freedom <= 30)
+        return table[degrees_of_freedom - 1];
+    if(degrees_of_freedom <= 60)
+        return 2.000;
+    if(degrees_of_freedom <= 120)
+        return 1.980;
+    return 1.960;
+}
+
+double
+testresults::testseries::get_confidence_interval() const
+{
+    std::size_t size = test_entries.size();
+
+    if(size < 2)
+        return 0;
+
+    double mean = get_mean();
+
+    double sum = 0;
+
+    for(const double& val : test_entries){
+        double diff = val - mean;
+        sum += (diff*diff);
     }
 
-    return median;
+    // sample standard deviation
+    double stddev = std::sqrt(sum/(size - 1));
+
+    return student_t_975(size - 1) * stddev / std::sqrt(double(size));
 }
 
 std::string
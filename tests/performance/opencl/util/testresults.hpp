@@ -3,6 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <cstdint>
 #include <string>
 #include <map>
 #include <set>
@@ -15,12 +16,57 @@
 
 namespace hpx{ namespace opencl{ namespace tests{ namespace performance{
 
+    // Collects the trials of the test series and prints their statistics.
+    //
+    // The first trials of every series are warm-up and get discarded.
+    // After min_trials, a series stops as soon as the 95% confidence
+    // interval of its mean is narrower than the confidence target, or
+    // at max_trials.
+    //
+    // Series that measure many operations per trial can add the samples
+    // of the single operations as well. Their percentiles are the ones of
+    // the operations, not of the trials. The samples get counted in a
+    // histogram, so millions of operations take little memory.
     class testresults
     {
         private:
+            // Counts values in logarithmic buckets that are split into
+            // linear sub-buckets, like an HDR histogram. Percentiles have
+            // a relative error below 1 / sub_buckets.
+            class histogram{
+                public:
+                    histogram() : count(0), min(0), max(0) {}
+
+                    void add( double value );
+
+                    std::uint64_t get_count() const { return count; }
+
+                    // p in [0,100], the bucket of the nearest rank
+                    double get_percentile( double p ) const;
+
+                    // The value and count of every non-empty bucket
+                    std::vector<std::pair<double, std::uint64_t> >
+                    get_buckets() const;
+
+                private:
+                    static const int sub_buckets = 256;
+
+                    static std::int64_t get_bucket( double value );
+                    static double get_bucket_value( std::int64_t bucket );
+
+                    // ordered like the values
+                    std::map<std::int64_t, std::uint64_t> buckets;
+                    std::uint64_t count;
+                    double min;
+                    double max;
+            };
+
             class testseries{
                 public:
+                    std::vector<double> warmup_entries;
                     std::vector<double> test_entries;
+                    // The operations of the trials, without warm-up
+                    histogram samples;
                     std::string series_name;
                     std::map<std::string, std::string> atts;
                     std::string unit;
@@ -29,6 +75,11 @@ namespace hpx{ namespace opencl{ namespace tests{ namespace performance{
                     double get_stddev() const;
                     double get_min() const;
                     double get_max() const;
+                    // p in [0,100], of the samples, or interpolated
+                    // between the trials if there are none
+                    double get_percentile( double p ) const;
+                    // Half width of the 95% confidence interval of the mean
+                    double get_confidence_interval() const;
                     std::string get_atts() const;
             };
 
@@ -40,6 +91,15 @@ namespace hpx{ namespace opencl{ namespace tests{ namespace performance{
             void set_output_json();
             void set_output_tabbed();
 
+            void set_warmup_trials( std::size_t num );
+            void set_trials( std::size_t min, std::size_t max );
+
+            // The confidence interval to reach, relative to the mean
+            void set_confidence_target( double relative );
+
+            // The most trials a series can take, warm-up included
+            std::size_t get_max_trials() const;
+
             void start_test( std::string name,
                              std::string unit,
                              std::map<std::string, std::string> atts
@@ -47,9 +107,28 @@ namespace hpx{ namespace opencl{ namespace tests{ namespace performance{
 
             void add( double result );
 
+            // Adds the samples of the operations of a trial. Needs to be
+            // called before the add() of the trial.
+            void add_samples( const std::vector<double> & samples );
+
             bool needs_more_testing();
 
+            // Writes the results in the JSON format, as baseline for
+            // later runs
+            void save_baseline( const std::string & filename ) const;
+
+            // Compares every series with the one of the same name in a
+            // baseline file and prints a table to os. Returns the number
+            // of regressions: series whose median got worse by more than
+            // threshold, relative to the baseline, with a significant
+            // difference in Welch's t-test.
+            std::size_t compare_to_baseline( const std::string & filename,
+                                             double threshold,
+                                             std::ostream & os ) const;
+
         private:
+            bool has_converged( const testseries & series ) const;
+
             void print_default( std::ostream& os ) const;
             void print_tabbed( std::ostream& os ) const;
             void print_json( std::ostream& os ) const;
@@ -65,11 +144,16 @@ namespace hpx{ namespace opencl{ namespace tests{ namespace performance{
             enum output_formats { DEFAULT, TABBED, JSON };
             output_formats output_format = DEFAULT;
 
+            std::size_t warmup_trials = 1;
+            std::size_t min_trials = 10;
+            std::size_t max_trials = 100;
+            double confidence_target = 0.02;
+
     };
 
     std::ostream& operator<<(std::ostream& os, const testresults& result);
 
 }}}}
-    
-    
+
+
 #endif
@@ -0,0 +1,97 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify the local work size autotuner.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void times_two(__global uint * in, __global uint * out)       \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = 2 * in[tid];                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 1024
+
+static void check_local_size(std::size_t local_size)
+{
+    // 0 means driver default
+    HPX_TEST(local_size == 0 || NUM_ELEMENTS % local_size == 0);
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    hpx::opencl::program program =
+        cldevice.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("times_two");
+
+    // create and initialize buffers
+    hpx::opencl::buffer buffer_in =
+        cldevice.create_buffer(CL_MEM_READ_ONLY, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        cldevice.create_buffer(CL_MEM_WRITE_ONLY, NUM_ELEMENTS * sizeof(uint32_t));
+
+    intbuffer_type initdata(NUM_ELEMENTS);
+    intbuffer_type refdata(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        initdata[i] = static_cast<uint32_t>(i);
+        refdata[i] = static_cast<uint32_t>(2 * i);
+    }
+    auto write_future = buffer_in.enqueue_write(0, initdata);
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    // test automatic candidate space, with dependency
+    {
+        hpx::opencl::work_size<1> tuned_size =
+            kernel.autotune(size, {}, write_future).get();
+        HPX_TEST_EQ(tuned_size[0].size, std::size_t(NUM_ELEMENTS));
+        check_local_size(tuned_size[0].local_size);
+    }
+
+    // test explicit candidates
+    {
+        hpx::opencl::work_size<1> tuned_size =
+            kernel.autotune(size, {{{1}}, {{16}}, {{64}}}).get();
+        std::size_t local_size = tuned_size[0].local_size;
+        HPX_TEST( local_size == 0 || local_size == 1 ||
+                  local_size == 16 || local_size == 64 );
+    }
+
+    // test if invalid candidates get ignored
+    {
+        hpx::opencl::work_size<1> tuned_size =
+            kernel.autotune(size, {{{3}}, {{0}}}).get();
+        HPX_TEST_EQ(tuned_size[0].local_size, std::size_t(0));
+    }
+
+    // test if enqueue uses the tuned value
+    {
+        size[0].local_size = hpx::opencl::local_size_auto;
+        auto kernel_future = kernel.enqueue(size);
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer,
+                                                     kernel_future);
+        COMPARE_RESULT_INT(result_future.get(), refdata);
+    }
+
+}
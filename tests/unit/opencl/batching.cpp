@@ -0,0 +1,148 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+#include <string>
+
+
+/*
+ * This test is meant to verify the launch batching of kernels.
+ */
+
+static const char kernel_src[] =
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out,         \n"
+"                         __global const ulong * table, uint num_launches) \n"
+"   {                                                                      \n"
+"       ulong tid = hpxcl_batch_global_id(table, num_launches);            \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n";
+
+#define NUM_ELEMENTS 64
+#define NUM_LAUNCHES 8
+
+static intbuffer_type create_data( uint32_t offset )
+{
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(i + offset);
+    }
+    return data;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    std::string src = hpx::opencl::batch_index_source;
+    src += kernel_src;
+
+    hpx::opencl::program program = cldevice.create_program_with_source(
+        buffer_type(src.c_str(), src.size() + 1, buffer_type::init_mode::copy));
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+
+    // create buffers
+    hpx::opencl::buffer buffer_in =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    // a long window, to make sure launches end up in one batch
+    kernel.enable_batching(2, std::chrono::microseconds(10000));
+
+    const std::size_t launch_size = NUM_ELEMENTS / NUM_LAUNCHES;
+
+    // test many small launches, in reverse order of their offsets
+    {
+        buffer_in.enqueue_write(0, create_data(0)).get();
+
+        std::vector<hpx::future<void> > futures;
+        for(std::size_t i = NUM_LAUNCHES; i > 0; i--){
+            hpx::opencl::work_size<1> size;
+            size[0].offset = (i - 1) * launch_size;
+            size[0].size = launch_size;
+            futures.push_back(kernel.enqueue(size));
+        }
+        hpx::wait_all(futures);
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer);
+        COMPARE_RESULT_INT(result_future.get(), create_data(1));
+    }
+
+    // test batched launches as dependencies of other commands
+    {
+        buffer_in.enqueue_write(0, create_data(10)).get();
+
+        std::vector<hpx::future<void> > futures;
+        for(std::size_t i = 0; i < NUM_LAUNCHES; i++){
+            hpx::opencl::work_size<1> size;
+            size[0].offset = i * launch_size;
+            size[0].size = launch_size;
+            futures.push_back(kernel.enqueue(size));
+        }
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer, futures);
+        COMPARE_RESULT_INT(result_future.get(), create_data(11));
+    }
+
+    // test launches with dependencies that are not satisfied yet
+    {
+        auto write_future = buffer_in.enqueue_write(0, create_data(20));
+
+        hpx::opencl::work_size<1> size;
+        size[0].offset = 0;
+        size[0].size = NUM_ELEMENTS;
+        auto kernel_future = kernel.enqueue(size, write_future);
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer,
+                                                     kernel_future);
+        COMPARE_RESULT_INT(result_future.get(), create_data(21));
+    }
+
+    // test flush_batch
+    {
+        buffer_in.enqueue_write(0, create_data(30)).get();
+
+        hpx::opencl::work_size<1> size;
+        size[0].offset = 0;
+        size[0].size = NUM_ELEMENTS;
+        auto kernel_future = kernel.enqueue(size);
+        kernel.flush_batch();
+        kernel_future.get();
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer);
+        COMPARE_RESULT_INT(result_future.get(), create_data(31));
+    }
+
+    // test if multi-dimensional launches get rejected
+    {
+        hpx::opencl::work_size<2> size;
+        size[0].size = NUM_ELEMENTS / 2;
+        size[1].size = 2;
+
+        bool caught_exception = false;
+        try{
+            kernel.enqueue(size).get();
+        } catch (hpx::exception e){
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    kernel.disable_batching();
+
+}
@@ -0,0 +1,174 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify the recording and replay of command graphs.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void scale(__global uint * in, __global uint * out,           \n"
+"                       uint factor)                                       \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = factor * in[tid];                                       \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+static intbuffer_type to_intbuffer( buffer_type buf )
+{
+    return intbuffer_type( reinterpret_cast<uint32_t*>(buf.data()),
+                           buf.size() / sizeof(uint32_t),
+                           intbuffer_type::init_mode::copy );
+}
+
+static intbuffer_type create_data( uint32_t factor )
+{
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(factor * i);
+    }
+    return data;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    hpx::opencl::program program =
+        cldevice.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("scale");
+
+    // create buffers
+    hpx::opencl::buffer buffer_in =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_copy =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    // record: write -> kernel -> copy -> read, kernel -> read
+    hpx::opencl::command_graph graph = cldevice.create_command_graph();
+    std::size_t write_node = graph.add_write(buffer_in, 0, create_data(1));
+    std::size_t kernel_node = graph.add_kernel(kernel, size, {write_node});
+    std::size_t copy_node = graph.add_copy( buffer_out, buffer_copy, 0, 0,
+                                            NUM_ELEMENTS * sizeof(uint32_t),
+                                            {kernel_node} );
+    graph.add_read( buffer_out, 0, NUM_ELEMENTS * sizeof(uint32_t),
+                    {kernel_node} );
+    graph.add_read( buffer_copy, 0, NUM_ELEMENTS * sizeof(uint32_t),
+                    {copy_node} );
+
+    // test if dependencies on later nodes get rejected
+    {
+        bool caught_exception = false;
+        try{
+            graph.add_read( buffer_out, 0, sizeof(uint32_t), {100} );
+        } catch (hpx::exception e){
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    graph.finalize().get();
+
+    // test replay with scalar argument
+    {
+        hpx::opencl::graph_arguments args;
+        args.set_scalar(kernel_node, 2, static_cast<uint32_t>(3));
+
+        auto result = graph.replay(args).get();
+        HPX_TEST_EQ(result.size(), std::size_t(2));
+        COMPARE_RESULT_INT(to_intbuffer(result[0]), create_data(3));
+        COMPARE_RESULT_INT(to_intbuffer(result[1]), create_data(3));
+    }
+
+    // test replay with new write data and scalar argument
+    {
+        hpx::opencl::graph_arguments args;
+        args.set_scalar(kernel_node, 2, static_cast<uint32_t>(5));
+        args.set_write_data(write_node, create_data(2));
+
+        auto result = graph.replay(args).get();
+        COMPARE_RESULT_INT(to_intbuffer(result[0]), create_data(10));
+        COMPARE_RESULT_INT(to_intbuffer(result[1]), create_data(10));
+    }
+
+    // test multiple replays in flight, with dependency
+    {
+        auto write_future = buffer_in.enqueue_write(0, create_data(1));
+
+        hpx::opencl::graph_arguments args;
+        args.set_scalar(kernel_node, 2, static_cast<uint32_t>(7));
+
+        auto future1 = graph.replay(args, write_future);
+        auto future2 = graph.replay(args);
+        COMPARE_RESULT_INT(to_intbuffer(future1.get()[0]), create_data(7));
+        COMPARE_RESULT_INT(to_intbuffer(future2.get()[1]), create_data(7));
+    }
+
+    // test two nodes of the same kernel with different scalar arguments
+    {
+        hpx::opencl::command_graph graph2 = cldevice.create_command_graph();
+        std::size_t write2 = graph2.add_write(buffer_in, 0, create_data(1));
+        std::size_t kernel2a = graph2.add_kernel(kernel, size, {write2});
+        std::size_t copy2 = graph2.add_copy( buffer_out, buffer_copy, 0, 0,
+                                             NUM_ELEMENTS * sizeof(uint32_t),
+                                             {kernel2a} );
+        std::size_t kernel2b = graph2.add_kernel(kernel, size, {copy2});
+        graph2.add_read( buffer_copy, 0, NUM_ELEMENTS * sizeof(uint32_t),
+                         {kernel2b} );
+        graph2.add_read( buffer_out, 0, NUM_ELEMENTS * sizeof(uint32_t),
+                         {kernel2b} );
+        graph2.finalize().get();
+
+        hpx::opencl::graph_arguments args;
+        args.set_scalar(kernel2a, 2, static_cast<uint32_t>(2));
+        args.set_scalar(kernel2b, 2, static_cast<uint32_t>(9));
+
+        auto result = graph2.replay(args).get();
+        COMPARE_RESULT_INT(to_intbuffer(result[0]), create_data(2));
+        COMPARE_RESULT_INT(to_intbuffer(result[1]), create_data(9));
+
+        // the scalars stay with their nodes, and don't leak into the
+        // other graph
+        result = graph2.replay().get();
+        COMPARE_RESULT_INT(to_intbuffer(result[0]), create_data(2));
+        COMPARE_RESULT_INT(to_intbuffer(result[1]), create_data(9));
+
+        result = graph.replay().get();
+        COMPARE_RESULT_INT(to_intbuffer(result[0]), create_data(7));
+    }
+
+    // test if write data of wrong size gets rejected
+    {
+        hpx::opencl::graph_arguments args;
+        args.set_write_data(write_node, intbuffer_type(1));
+
+        bool caught_exception = false;
+        try{
+            graph.replay(args).get();
+        } catch (hpx::exception e){
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+}
@@ -0,0 +1,115 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify enqueue calls that depend on events of
+ * other devices.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+static intbuffer_type create_data( uint32_t offset )
+{
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(i + offset);
+    }
+    return data;
+}
+
+static hpx::opencl::kernel create_kernel( hpx::opencl::device device,
+                                          hpx::opencl::buffer in,
+                                          hpx::opencl::buffer out )
+{
+    hpx::opencl::program program =
+        device.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+    kernel.set_arg(0, in);
+    kernel.set_arg(1, out);
+
+    return kernel;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    // create buffers
+    hpx::opencl::buffer local_in =
+        local_device.create_buffer(CL_MEM_READ_WRITE,
+                                   NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer local_out =
+        local_device.create_buffer(CL_MEM_READ_WRITE,
+                                   NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer remote_in =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer remote_out =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+
+    hpx::opencl::kernel local_kernel =
+        create_kernel(local_device, local_in, local_out);
+    hpx::opencl::kernel remote_kernel =
+        create_kernel(cldevice, remote_in, remote_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    // test a kernel that waits for a write on another device
+    {
+        auto local_write = local_in.enqueue_write(0, create_data(0));
+        auto remote_write = remote_in.enqueue_write(0, create_data(10));
+        auto local_kernel_future = local_kernel.enqueue(size, local_write);
+        auto remote_kernel_future = remote_kernel.enqueue(size, remote_write,
+                                                          local_kernel_future);
+
+        // read from the other device each
+        intbuffer_type local_result(NUM_ELEMENTS);
+        auto local_read = local_out.enqueue_read(0, local_result,
+                                                 remote_kernel_future);
+        intbuffer_type remote_result(NUM_ELEMENTS);
+        auto remote_read = remote_out.enqueue_read(0, remote_result,
+                                                   local_kernel_future);
+
+        COMPARE_RESULT_INT(local_read.get(), create_data(1));
+        COMPARE_RESULT_INT(remote_read.get(), create_data(11));
+    }
+
+    // test a chain that alternates between the devices
+    {
+        auto write_future = local_in.enqueue_write(0, create_data(20));
+        auto local_kernel_future = local_kernel.enqueue(size, write_future);
+        auto send_future = local_out.enqueue_send( remote_in, 0, 0,
+                                                   NUM_ELEMENTS * sizeof(uint32_t),
+                                                   local_kernel_future );
+        auto remote_kernel_future = remote_kernel.enqueue( size,
+                                                   send_future.dst_future );
+
+        // the local device waits for the remote kernel
+        auto copy_future = local_out.enqueue_write(0, create_data(0),
+                                                   remote_kernel_future);
+
+        intbuffer_type remote_result(NUM_ELEMENTS);
+        auto remote_read = remote_out.enqueue_read(0, remote_result,
+                                                   copy_future);
+        COMPARE_RESULT_INT(remote_read.get(), create_data(22));
+    }
+
+}
@@ -0,0 +1,84 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify that repeated create_devices calls share
+ * their device components.
+ */
+
+static bool same_devices( const std::vector<hpx::opencl::device> & devices1,
+                          const std::vector<hpx::opencl::device> & devices2 )
+{
+    if(devices1.size() != devices2.size())
+        return false;
+
+    for(std::size_t i = 0; i < devices1.size(); i++){
+        if(devices1[i].get_id() != devices2[i].get_id())
+            return false;
+    }
+    return true;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    hpx::naming::id_type locality =
+        hpx::get_colocation_id(hpx::launch::sync, cldevice.get_id());
+
+    // test if repeated calls return the same devices
+    {
+        std::vector<hpx::opencl::device> devices1 =
+            hpx::opencl::create_devices( locality, CL_DEVICE_TYPE_ALL,
+                                         "OpenCL 1.1" ).get();
+        std::vector<hpx::opencl::device> devices2 =
+            hpx::opencl::create_devices( locality, CL_DEVICE_TYPE_ALL,
+                                         "OpenCL 1.1" ).get();
+        HPX_TEST(same_devices(devices1, devices2));
+
+        hpx::opencl::release_devices(devices1).get();
+        hpx::opencl::release_devices(devices2).get();
+    }
+
+    // test concurrent calls
+    {
+        std::vector<hpx::future<std::vector<hpx::opencl::device> > > futures;
+        for(std::size_t i = 0; i < 8; i++){
+            futures.push_back(
+                hpx::opencl::create_devices( locality, CL_DEVICE_TYPE_ALL,
+                                             "OpenCL 1.1" ) );
+        }
+
+        std::vector<std::vector<hpx::opencl::device> > results;
+        for(auto & f : futures){
+            results.push_back(f.get());
+        }
+        for(const auto & devices : results){
+            HPX_TEST(same_devices(devices, results[0]));
+        }
+
+        for(const auto & devices : results){
+            hpx::opencl::release_devices(devices).get();
+        }
+    }
+
+    // test if the devices stay usable as long as clients exist
+    {
+        std::vector<hpx::opencl::device> devices =
+            hpx::opencl::create_devices( locality, CL_DEVICE_TYPE_ALL,
+                                         "OpenCL 1.1" ).get();
+        HPX_TEST(!devices.empty());
+        hpx::opencl::release_devices(devices).get();
+
+        hpx::opencl::buffer buffer =
+            devices[0].create_buffer(CL_MEM_READ_WRITE, 4);
+        HPX_TEST(buffer.get_id());
+    }
+
+}
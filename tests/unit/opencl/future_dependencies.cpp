@@ -0,0 +1,139 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify enqueue calls that depend on futures that
+ * are no OpenCL events.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+static intbuffer_type create_data( uint32_t offset )
+{
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(i + offset);
+    }
+    return data;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    hpx::opencl::program program =
+        cldevice.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+
+    // create buffers
+    hpx::opencl::buffer buffer_in =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    // test a kernel that waits for a promise
+    {
+        buffer_in.enqueue_write(0, create_data(0)).get();
+
+        hpx::lcos::local::promise<void> promise;
+        auto kernel_future = kernel.enqueue(size, promise.get_future());
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer,
+                                                     kernel_future);
+
+        // the commands are enqueued, but can't run yet
+        buffer_in.enqueue_write(0, create_data(10)).get();
+        promise.set_value();
+
+        COMPARE_RESULT_INT(result_future.get(), create_data(11));
+    }
+
+    // test a chain that waits for a host computation
+    {
+        hpx::future<int> host_future = hpx::async([](){ return 42; });
+        hpx::shared_future<int> shared_host_future = host_future.share();
+
+        auto write_future = buffer_in.enqueue_write(0, create_data(20),
+                                                    shared_host_future);
+        auto kernel_future = kernel.enqueue(size, write_future,
+                                            shared_host_future);
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer,
+                                                     kernel_future);
+        COMPARE_RESULT_INT(result_future.get(), create_data(21));
+
+        // the host future stays valid
+        HPX_TEST_EQ(shared_host_future.get(), 42);
+    }
+
+    // test satisfied dependencies
+    {
+        std::vector<hpx::future<void> > ready_futures;
+        ready_futures.push_back(hpx::make_ready_future());
+        ready_futures.push_back(hpx::make_ready_future());
+
+        auto write_future = buffer_in.enqueue_write(0, create_data(30),
+                                                    ready_futures);
+        auto kernel_future = kernel.enqueue(size, write_future);
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer,
+                                                     kernel_future);
+        COMPARE_RESULT_INT(result_future.get(), create_data(31));
+    }
+
+    // test if the dependencies keep their values
+    {
+        hpx::lcos::local::promise<int> int_promise;
+        hpx::future<int> int_future = int_promise.get_future();
+
+        hpx::lcos::local::promise<std::vector<uint32_t> > vector_promise;
+        hpx::shared_future<std::vector<uint32_t> > vector_future =
+            vector_promise.get_future().share();
+
+        auto write_future = buffer_in.enqueue_write(0, create_data(40),
+                                                    int_future,
+                                                    vector_future);
+
+        // the dependencies are not ready before the enqueue
+        int_promise.set_value(42);
+        vector_promise.set_value(
+            std::vector<uint32_t>(NUM_ELEMENTS, 7));
+        write_future.get();
+
+        HPX_TEST_EQ(int_future.get(), 42);
+
+        const std::vector<uint32_t> & values = vector_future.get();
+        HPX_TEST_EQ(values.size(), static_cast<std::size_t>(NUM_ELEMENTS));
+        for(std::size_t i = 0; i < values.size(); i++){
+            HPX_TEST_EQ(values[i], 7u);
+        }
+    }
+
+}
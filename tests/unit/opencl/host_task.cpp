@@ -0,0 +1,134 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+#include <atomic>
+
+
+/*
+ * This test is meant to verify host tasks inside the device command stream.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+static intbuffer_type create_data( uint32_t offset )
+{
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(i + offset);
+    }
+    return data;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    hpx::opencl::program program =
+        cldevice.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+
+    // create buffers
+    hpx::opencl::buffer buffer_in =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    // test a host task between two device commands
+    {
+        std::atomic<int> steps(0);
+
+        auto write_future = buffer_in.enqueue_write(0, create_data(0));
+        auto host_future = cldevice.enqueue_host_task(
+            [&steps](){
+                steps++;
+            }, write_future);
+        auto kernel_future = kernel.enqueue(size, host_future);
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer,
+                                                     kernel_future);
+        COMPARE_RESULT_INT(result_future.get(), create_data(1));
+        HPX_TEST_EQ(steps.load(), 1);
+    }
+
+    // test if a read the host task depends on keeps its data
+    {
+        std::atomic<int> steps(0);
+
+        auto write_future = buffer_in.enqueue_write(0, create_data(50));
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto read_future = buffer_in.enqueue_read(0, readbuffer,
+                                                  write_future);
+        auto host_future = cldevice.enqueue_host_task(
+            [&steps](){
+                steps++;
+            }, read_future);
+        host_future.get();
+
+        HPX_TEST_EQ(steps.load(), 1);
+        COMPARE_RESULT_INT(read_future.get(), create_data(50));
+    }
+
+    // test host tasks that depend on each other
+    {
+        std::atomic<int> steps(0);
+        std::atomic<bool> in_order(true);
+
+        auto first = cldevice.enqueue_host_task(
+            [&steps](){
+                steps++;
+            });
+        auto second = cldevice.enqueue_host_task(
+            [&steps, &in_order](){
+                if(steps.load() != 1)
+                    in_order = false;
+                steps++;
+            }, first);
+        second.get();
+
+        HPX_TEST_EQ(steps.load(), 2);
+        HPX_TEST(in_order.load());
+    }
+
+    // test if errors of host tasks get reported
+    {
+        auto host_future = cldevice.enqueue_host_task(
+            [](){
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "host_task",
+                                    "Expected error");
+            });
+
+        bool caught_exception = false;
+        try{
+            host_future.get();
+        } catch (hpx::exception e){
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+}
@@ -30,6 +30,15 @@ CREATE_BUFFER(program_src,
 "                                                                          \n");
 
 
+CREATE_BUFFER(specialize_src,
+"                                                                          \n"
+"   __kernel void hello_world(__global char * in, __global char * out)     \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = (char)(in[tid] + SCALE * tid);                          \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
 
 #define DATASIZE (sizeof("Hello, World!"))
 
@@ -169,6 +178,62 @@ static void cl_test( hpx::opencl::device local_device,
         create_and_run_kernel(cldevice, program);
     }
 
+    // test concurrent identical builds
+    {
+        // create two programs from the same source
+        hpx::opencl::program program1 =
+            cldevice.create_program_with_source(program_src);
+        hpx::opencl::program program2 =
+            cldevice.create_program_with_source(program_src);
+
+        // build both at the same time. the build service merges these.
+        auto future1 = program1.build_async("-cl-std=CL1.1");
+        auto future2 = program2.build_async("-cl-std=CL1.1");
+        future1.get();
+        future2.get();
+
+        // test if both programs can be used for computation
+        create_and_run_kernel(cldevice, program1);
+        create_and_run_kernel(cldevice, program2);
+    }
+
+    // test program specialization
+    {
+        // SCALE is undefined, the unspecialized program does not compile
+        hpx::opencl::program program =
+            cldevice.create_program_with_source(specialize_src);
+
+        // test if a specialized variant can be used for computation
+        hpx::opencl::program variant = program.specialize({{"SCALE", 1}});
+        create_and_run_kernel(cldevice, variant);
+
+        // test if the definitions reach the compiler: SCALE 0 copies the
+        // input, SCALE 1 (from the cache) adds the thread ids
+        hpx::opencl::buffer buffer_src =
+            cldevice.create_buffer(CL_MEM_READ_WRITE, DATASIZE);
+        hpx::opencl::buffer buffer_dst =
+            cldevice.create_buffer(CL_MEM_READ_WRITE, DATASIZE);
+        buffer_src.enqueue_write(0, initdata).get();
+
+        hpx::opencl::work_size<1> size;
+        size[0].offset = 0;
+        size[0].size = DATASIZE;
+
+        hpx::opencl::kernel copy_kernel =
+            program.specialize("hello_world", {{"SCALE", 0}});
+        copy_kernel.set_arg(0, buffer_src);
+        copy_kernel.set_arg(1, buffer_dst);
+        copy_kernel.enqueue(size).get();
+        COMPARE_RESULT(buffer_dst.enqueue_read(0, DATASIZE).get(), initdata);
+
+        hpx::opencl::kernel add_kernel =
+            program.specialize("hello_world", {{"SCALE", 1}});
+        add_kernel.set_arg(0, buffer_src);
+        add_kernel.set_arg(1, buffer_dst);
+        add_kernel.enqueue(size).get();
+        COMPARE_RESULT(buffer_dst.enqueue_read(0, DATASIZE).get(), refdata1);
+    }
+
     // test with create_from_binary
     {
         // test if program can be created from source
@@ -0,0 +1,109 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify the enqueue_nowait functions and the
+ * device barriers.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+static intbuffer_type create_data( uint32_t offset )
+{
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(i + offset);
+    }
+    return data;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    hpx::opencl::program program =
+        cldevice.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+
+    // create buffers
+    hpx::opencl::buffer buffer_in =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        cldevice.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_local =
+        local_device.create_buffer(CL_MEM_READ_WRITE,
+                                   NUM_ELEMENTS * sizeof(uint32_t));
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    // test write and kernel, separated by a barrier
+    {
+        buffer_in.enqueue_write_nowait(0, create_data(0));
+        cldevice.barrier_async().get();
+        kernel.enqueue_nowait(size);
+        cldevice.finish_async().get();
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer);
+        COMPARE_RESULT_INT(result_future.get(), create_data(1));
+    }
+
+    // test nowait commands with dependencies on tracked commands
+    {
+        auto write_future = buffer_in.enqueue_write(0, create_data(5));
+        kernel.enqueue_nowait(size, write_future);
+        cldevice.finish_async().get();
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_out.enqueue_read(0, readbuffer);
+        COMPARE_RESULT_INT(result_future.get(), create_data(6));
+    }
+
+    // test send, possibly to another device
+    {
+        buffer_out.enqueue_send_nowait( buffer_local, 0, 0,
+                                        NUM_ELEMENTS * sizeof(uint32_t) );
+        cldevice.finish_async().get();
+        local_device.finish_async().get();
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_local.enqueue_read(0, readbuffer);
+        COMPARE_RESULT_INT(result_future.get(), create_data(6));
+    }
+
+    // test a long stream of writes, the data gets released in between
+    {
+        // the writes are unordered, so they all write the same data
+        for(std::size_t i = 0; i < 1000; i++){
+            buffer_in.enqueue_write_nowait(0, create_data(3));
+        }
+        cldevice.finish_async().get();
+
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto result_future = buffer_in.enqueue_read(0, readbuffer);
+        COMPARE_RESULT_INT(result_future.get(), create_data(3));
+    }
+
+}
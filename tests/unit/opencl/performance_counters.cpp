@@ -0,0 +1,128 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+#include <hpx/include/performance_counters.hpp>
+
+#include <chrono>
+#include <string>
+
+
+/*
+ * This test is meant to verify the performance counters of the devices.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+// Devices of a locality that get checked. Nonexistent devices read 0.
+#define MAX_DEVICES 16
+
+// Sums up a counter over all devices of a locality
+static std::int64_t read_counter( std::uint32_t locality_id,
+                                  const std::string & name )
+{
+    std::int64_t sum = 0;
+    for(std::size_t i = 0; i < MAX_DEVICES; i++){
+        hpx::performance_counters::performance_counter counter(
+            "/opencl{locality#" + std::to_string(locality_id) +
+            "/device#" + std::to_string(i) + "}/" + name );
+        sum += counter.get_value<std::int64_t>().get();
+    }
+    return sum;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    std::uint32_t locality_id = hpx::naming::get_locality_id_from_id(
+        cldevice.get_id() );
+
+    std::int64_t written = read_counter(locality_id, "data/written");
+    std::int64_t read = read_counter(locality_id, "data/read");
+    std::int64_t kernels =
+        read_counter(locality_id, "commands/enqueued/kernel");
+    std::int64_t allocated = read_counter(locality_id, "buffers/allocated");
+
+    hpx::opencl::program program =
+        cldevice.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+
+    // test if allocations get counted
+    {
+        hpx::opencl::buffer buffer_in =
+            cldevice.create_buffer(CL_MEM_READ_WRITE,
+                                   NUM_ELEMENTS * sizeof(uint32_t));
+        hpx::opencl::buffer buffer_out =
+            cldevice.create_buffer(CL_MEM_READ_WRITE,
+                                   NUM_ELEMENTS * sizeof(uint32_t));
+        buffer_in.get_id();
+        buffer_out.get_id();
+
+        HPX_TEST_EQ(read_counter(locality_id, "buffers/allocated"),
+                    allocated +
+                        static_cast<std::int64_t>(
+                            2 * NUM_ELEMENTS * sizeof(uint32_t)));
+
+        kernel.set_arg(0, buffer_in);
+        kernel.set_arg(1, buffer_out);
+
+        hpx::opencl::work_size<1> size;
+        size[0].offset = 0;
+        size[0].size = NUM_ELEMENTS;
+
+        // test if commands and their data get counted
+        intbuffer_type data(NUM_ELEMENTS);
+        for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+            data[i] = static_cast<uint32_t>(i);
+        }
+
+        auto write_future = buffer_in.enqueue_write(0, data);
+        auto kernel_future = kernel.enqueue(size, write_future);
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        buffer_out.enqueue_read(0, readbuffer, kernel_future).get();
+
+        HPX_TEST_EQ(read_counter(locality_id, "data/written"),
+                    written +
+                        static_cast<std::int64_t>(
+                            NUM_ELEMENTS * sizeof(uint32_t)));
+        HPX_TEST_EQ(read_counter(locality_id, "data/read"),
+                    read +
+                        static_cast<std::int64_t>(
+                            NUM_ELEMENTS * sizeof(uint32_t)));
+        HPX_TEST_EQ(read_counter(locality_id, "commands/enqueued/kernel"),
+                    kernels + 1);
+
+        // without hpx.opencl.track_commands, no command gets tracked
+        HPX_TEST_EQ(read_counter(locality_id, "commands/in_flight"), 0);
+    }
+
+    // test if released buffers get subtracted. buffers get destroyed
+    // asynchronously.
+    {
+        bool released = false;
+        for(std::size_t i = 0; i < 1000 && !released; i++){
+            released =
+                (read_counter(locality_id, "buffers/allocated") == allocated);
+            if(!released)
+                hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        HPX_TEST(released);
+    }
+
+}
@@ -0,0 +1,85 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify the device placement.
+ */
+
+static bool is_one_of( hpx::opencl::device device,
+                       hpx::opencl::device device1,
+                       hpx::opencl::device device2 )
+{
+    return device.get_id() == device1.get_id() ||
+           device.get_id() == device2.get_id();
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    std::vector<hpx::opencl::device> devices;
+    devices.push_back(local_device);
+    if(cldevice.get_id() != local_device.get_id())
+        devices.push_back(cldevice);
+
+    hpx::opencl::device_placement placement(devices);
+    HPX_TEST(placement.get_score(local_device) > 0.0);
+
+    // test if the work gets charged and released
+    {
+        hpx::opencl::device device = placement.pick_device();
+        HPX_TEST(is_one_of(device, local_device, cldevice));
+        HPX_TEST_EQ(placement.get_outstanding_work(device), 1.0);
+
+        hpx::lcos::local::promise<void> promise;
+        hpx::future<void> job_future =
+            placement.release_on_completion(device, promise.get_future());
+        HPX_TEST_EQ(placement.get_outstanding_work(device), 1.0);
+
+        promise.set_value();
+        job_future.get();
+        HPX_TEST_EQ(placement.get_outstanding_work(device), 0.0);
+    }
+
+    // test if loaded devices get avoided
+    if(devices.size() > 1)
+    {
+        placement.set_remote_penalty(1.0);
+
+        hpx::opencl::placement_hint hint;
+        hint.work = 1e30;
+        hpx::opencl::device loaded_device = placement.pick_device(hint);
+        hpx::opencl::device other_device = placement.pick_device();
+        HPX_TEST(loaded_device.get_id() != other_device.get_id());
+
+        placement.release(loaded_device, hint.work);
+        placement.release(other_device);
+    }
+
+    // test the calibration
+    {
+        placement.calibrate();
+        HPX_TEST(placement.get_score(local_device) > 0.0);
+    }
+
+    // test if unsatisfiable requirements get reported
+    {
+        hpx::opencl::placement_hint hint;
+        hint.min_global_memory = static_cast<cl_ulong>(-1);
+
+        bool caught_exception = false;
+        try{
+            placement.pick_device(hint);
+        } catch (hpx::exception e){
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+}
@@ -0,0 +1,189 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+
+/*
+ * This test is meant to verify the command timestamps and kernel profiles.
+ * Timestamps need hpx.opencl.profiling=1, without it they must throw.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+static void check_timestamps( const hpx::opencl::command_timestamps & ts )
+{
+    HPX_TEST(ts.queued <= ts.submitted);
+    HPX_TEST(ts.submitted <= ts.started);
+    HPX_TEST(ts.started <= ts.ended);
+    HPX_TEST(ts.ended > 0);
+}
+
+template<typename Future>
+static void test_timestamps( const Future & fut, bool profiling )
+{
+    bool caught_exception = false;
+    try {
+        check_timestamps(hpx::opencl::get_timestamps(fut));
+    } catch (hpx::exception e) {
+        caught_exception = true;
+    }
+    HPX_TEST_EQ(caught_exception, !profiling);
+}
+
+// Returns the profile of a kernel name, once its launches got profiled
+static hpx::opencl::kernel_profile
+get_kernel_profile( hpx::opencl::device & cldevice, const std::string & name,
+                    std::uint64_t launches, bool profiling )
+{
+    hpx::opencl::kernel_profile result;
+
+    // launches get profiled asynchronously
+    for(std::size_t i = 0; i < 1000; i++){
+        std::vector<hpx::opencl::kernel_profile> profiles =
+            cldevice.get_kernel_profiles().get();
+
+        for(const auto & profile : profiles){
+            if(profile.name == name)
+                result = profile;
+        }
+
+        if(!profiling || result.profiled_launches >= launches)
+            break;
+
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return result;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    bool profiling =
+        (hpx::get_config_entry("hpx.opencl.profiling", "0") == "1");
+
+    hpx::opencl::program program =
+        cldevice.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+
+    hpx::opencl::buffer buffer_in =
+        cldevice.create_buffer(CL_MEM_READ_WRITE,
+                               NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        cldevice.create_buffer(CL_MEM_READ_WRITE,
+                               NUM_ELEMENTS * sizeof(uint32_t));
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(i);
+    }
+
+    std::uint64_t launches =
+        get_kernel_profile(cldevice, "add_one", 0, false).launches;
+
+    // test the timestamps of writes, kernels and reads
+    {
+        auto write_future = buffer_in.enqueue_write(0, data);
+        auto kernel_future = kernel.enqueue(size, write_future);
+        intbuffer_type readbuffer(NUM_ELEMENTS);
+        auto read_future = buffer_out.enqueue_read(0, readbuffer,
+                                                   kernel_future);
+        read_future.wait();
+
+        test_timestamps(write_future, profiling);
+        test_timestamps(kernel_future, profiling);
+        test_timestamps(read_future, profiling);
+
+        // the kernel ran after the write and before the read
+        if(profiling){
+            hpx::opencl::command_timestamps write_ts =
+                hpx::opencl::get_timestamps(write_future);
+            hpx::opencl::command_timestamps kernel_ts =
+                hpx::opencl::get_timestamps(kernel_future);
+            hpx::opencl::command_timestamps read_ts =
+                hpx::opencl::get_timestamps(read_future);
+            HPX_TEST(write_ts.ended <= kernel_ts.started);
+            HPX_TEST(kernel_ts.ended <= read_ts.started);
+        }
+
+        intbuffer_type result = read_future.get();
+        for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+            HPX_TEST_EQ(result[i], static_cast<uint32_t>(i + 1));
+        }
+    }
+
+    // test the timestamps of reads to a local buffer
+    {
+        auto read_future = buffer_out.enqueue_read(0,
+                                        NUM_ELEMENTS * sizeof(uint32_t));
+        read_future.wait();
+        test_timestamps(read_future, profiling);
+    }
+
+    // test the timestamps of sends
+    {
+        auto send_result = buffer_in.enqueue_send(buffer_out, 0, 0,
+                                NUM_ELEMENTS * sizeof(uint32_t));
+        send_result.dst_future.wait();
+        send_result.src_future.wait();
+        test_timestamps(send_result.src_future, profiling);
+        test_timestamps(send_result.dst_future, profiling);
+    }
+
+    // futures that are no OpenCL commands have no timestamps
+    {
+        hpx::future<void> fut = hpx::make_ready_future();
+        bool caught_exception = false;
+        try {
+            hpx::opencl::get_timestamps(fut);
+        } catch (hpx::exception e) {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    // test the kernel profiles
+    {
+        hpx::opencl::kernel_profile profile =
+            get_kernel_profile(cldevice, "add_one", 1, profiling);
+
+        HPX_TEST_EQ(profile.name, std::string("add_one"));
+        HPX_TEST_EQ(profile.launches, launches + 1);
+
+        if(profiling){
+            HPX_TEST(profile.profiled_launches >= 1);
+            HPX_TEST(profile.min_time <= profile.max_time);
+            HPX_TEST(profile.max_time <= profile.total_time);
+        } else {
+            HPX_TEST_EQ(profile.profiled_launches, 0u);
+        }
+    }
+
+}
@@ -0,0 +1,118 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify the partitioning of devices into sub-devices.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+// the maximum number of sub-devices to run the kernel on
+#define MAX_TESTED_SUB_DEVICES 4
+
+static intbuffer_type create_data( uint32_t offset )
+{
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(i + offset);
+    }
+    return data;
+}
+
+static void run_kernel( hpx::opencl::device device )
+{
+    hpx::opencl::program program =
+        device.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+
+    hpx::opencl::buffer buffer_in =
+        device.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        device.create_buffer(CL_MEM_READ_WRITE, NUM_ELEMENTS * sizeof(uint32_t));
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    auto write_future = buffer_in.enqueue_write(0, create_data(0));
+    auto kernel_future = kernel.enqueue(size, write_future);
+
+    intbuffer_type readbuffer(NUM_ELEMENTS);
+    auto result_future = buffer_out.enqueue_read(0, readbuffer, kernel_future);
+    COMPARE_RESULT_INT(result_future.get(), create_data(1));
+}
+
+static void test_partition( hpx::naming::id_type locality,
+                            std::size_t num_devices,
+                            hpx::opencl::device_partition partition )
+{
+    std::vector<hpx::opencl::device> sub_devices =
+        hpx::opencl::create_devices( locality, CL_DEVICE_TYPE_ALL,
+                                     "OpenCL 1.1", partition ).get();
+
+    // Devices that can't be partitioned are returned as a whole
+    HPX_TEST(sub_devices.size() >= num_devices);
+
+    for(std::size_t i = 0; i < sub_devices.size() &&
+                           i < MAX_TESTED_SUB_DEVICES; i++){
+        run_kernel(sub_devices[i]);
+    }
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    hpx::naming::id_type locality =
+        hpx::get_colocation_id(hpx::launch::sync, cldevice.get_id());
+
+    std::size_t num_devices =
+        hpx::opencl::create_devices( locality, CL_DEVICE_TYPE_ALL,
+                                     "OpenCL 1.1" ).get().size();
+
+    // test partitioning by NUMA domain
+    test_partition( locality, num_devices,
+                    hpx::opencl::device_partition(
+                        hpx::opencl::device_partition::by_numa_domain) );
+
+    // test partitioning into single compute units
+    test_partition( locality, num_devices,
+                    hpx::opencl::device_partition(
+                        hpx::opencl::device_partition::equally, 1) );
+
+    // test if invalid partitions get reported
+    {
+        bool caught_exception = false;
+        try{
+            hpx::opencl::create_devices( locality, CL_DEVICE_TYPE_ALL,
+                                         "OpenCL 1.1",
+                                         hpx::opencl::device_partition(
+                                         hpx::opencl::device_partition::equally,
+                                         0) ).get();
+        } catch (hpx::exception e){
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+}
@@ -0,0 +1,114 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+
+/*
+ * This test is meant to verify the trace of the OpenCL operations.
+ * Needs hpx.opencl.trace=1.
+ */
+
+CREATE_BUFFER(program_src,
+"                                                                          \n"
+"   __kernel void add_one(__global uint * in, __global uint * out)         \n"
+"   {                                                                      \n"
+"       size_t tid = get_global_id(0);                                     \n"
+"       out[tid] = in[tid] + 1;                                            \n"
+"   }                                                                      \n"
+"                                                                          \n");
+
+#define NUM_ELEMENTS 64
+
+static std::string read_trace( std::uint32_t locality_id )
+{
+    std::string filename =
+        hpx::get_config_entry("hpx.opencl.trace_file", "hpxcl_trace") + "." +
+        std::to_string(locality_id) + ".json";
+
+    std::ifstream file(filename.c_str());
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static bool contains( const std::string & trace, const std::string & str )
+{
+    return trace.find(str) != std::string::npos;
+}
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    HPX_TEST(hpx::opencl::util::tracer::enabled());
+
+    hpx::opencl::program program =
+        cldevice.create_program_with_source(program_src);
+    program.build();
+
+    hpx::opencl::kernel kernel = program.create_kernel("add_one");
+
+    hpx::opencl::buffer buffer_in =
+        cldevice.create_buffer(CL_MEM_READ_WRITE,
+                               NUM_ELEMENTS * sizeof(uint32_t));
+    hpx::opencl::buffer buffer_out =
+        cldevice.create_buffer(CL_MEM_READ_WRITE,
+                               NUM_ELEMENTS * sizeof(uint32_t));
+
+    kernel.set_arg(0, buffer_in);
+    kernel.set_arg(1, buffer_out);
+
+    hpx::opencl::work_size<1> size;
+    size[0].offset = 0;
+    size[0].size = NUM_ELEMENTS;
+
+    intbuffer_type data(NUM_ELEMENTS);
+    for(std::size_t i = 0; i < NUM_ELEMENTS; i++){
+        data[i] = static_cast<uint32_t>(i);
+    }
+
+    auto write_future = buffer_in.enqueue_write(0, data);
+    auto kernel_future = kernel.enqueue(size, write_future);
+    intbuffer_type readbuffer(NUM_ELEMENTS);
+    buffer_out.enqueue_read(0, readbuffer, kernel_future).get();
+
+    std::uint32_t client_locality = hpx::get_locality_id();
+    std::uint32_t device_locality = hpx::naming::get_locality_id_from_id(
+        cldevice.get_id() );
+
+    // device records arrive through completion callbacks, which can run
+    // after the futures got ready
+    for(std::size_t i = 0; i < 100; i++){
+        hpx::opencl::util::tracer::flush_all().get();
+        if(contains(read_trace(device_locality),
+                    "\"add_one\",\"cat\":\"device\""))
+            break;
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // the client calls get traced on this locality
+    std::string client_trace = read_trace(client_locality);
+    HPX_TEST(contains(client_trace, "\"traceEvents\""));
+    HPX_TEST(contains(client_trace, "\"program::build\",\"cat\":\"client\""));
+    HPX_TEST(contains(client_trace, "\"kernel::set_arg\",\"cat\":\"client\""));
+    HPX_TEST(contains(client_trace, "\"kernel::enqueue\",\"cat\":\"client\""));
+    HPX_TEST(contains(client_trace,
+                      "\"buffer::enqueue_write\",\"cat\":\"client\""));
+
+    // the server side and the device on the locality of the device
+    std::string device_trace = read_trace(device_locality);
+    HPX_TEST(contains(device_trace, "\"kernel::enqueue\",\"cat\":\"server\""));
+    HPX_TEST(contains(device_trace, "\"add_one\",\"cat\":\"submit\""));
+    HPX_TEST(contains(device_trace, "\"add_one\",\"cat\":\"device\""));
+    HPX_TEST(contains(device_trace, "\"write\",\"cat\":\"device\""));
+
+}
@@ -0,0 +1,95 @@
+// Copyright (c)       2026 agent
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include "cl_tests.hpp"
+
+
+/*
+ * This test is meant to verify the transfer model.
+ */
+
+static void cl_test( hpx::opencl::device local_device,
+                     hpx::opencl::device cldevice )
+{
+
+    hpx::opencl::device host;
+
+    std::vector<hpx::opencl::device> devices;
+    devices.push_back(local_device);
+    if(cldevice.get_id() != local_device.get_id())
+        devices.push_back(cldevice);
+
+    // test the kinds
+    {
+        HPX_TEST(hpx::opencl::transfer_model::get_transfer_kind(
+                    host, local_device)
+                        == hpx::opencl::transfer_kind::host_to_device);
+        HPX_TEST(hpx::opencl::transfer_model::get_transfer_kind(
+                    local_device, host)
+                        == hpx::opencl::transfer_kind::device_to_host);
+        HPX_TEST(hpx::opencl::transfer_model::get_transfer_kind(
+                    local_device, local_device)
+                        == hpx::opencl::transfer_kind::same_context);
+
+        // the host memory is the one of this locality
+        if(hpx::get_colocation_id(hpx::launch::sync, cldevice.get_id())
+                != hpx::find_here())
+        {
+            HPX_TEST(hpx::opencl::transfer_model::get_transfer_kind(
+                        host, cldevice)
+                            == hpx::opencl::transfer_kind::cross_locality);
+            HPX_TEST(hpx::opencl::transfer_model::get_transfer_kind(
+                        cldevice, host)
+                            == hpx::opencl::transfer_kind::cross_locality);
+        }
+    }
+
+    // test the calibration
+    {
+        hpx::opencl::transfer_model model;
+        model.calibrate(devices, 1024, 1 << 18, 3);
+
+        for(const auto & dev : devices)
+        {
+            HPX_TEST(model.has_fit(host, dev));
+            HPX_TEST(model.has_fit(dev, host));
+            HPX_TEST(model.has_fit(dev, dev));
+
+            hpx::opencl::transfer_fit fit = model.get_fit(host, dev);
+            HPX_TEST(fit.latency >= 0.0);
+            HPX_TEST(fit.bandwidth > 0.0);
+
+            // larger copies take longer
+            double small_time =
+                model.estimate_transfer_time(host, dev, 1024);
+            double large_time =
+                model.estimate_transfer_time(host, dev, 1 << 18);
+            HPX_TEST(small_time > 0.0);
+            HPX_TEST(large_time > small_time);
+        }
+    }
+
+    // test if the fits got stored
+    {
+        hpx::opencl::transfer_model model;
+        HPX_TEST(model.has_fit(host, local_device));
+        HPX_TEST(model.estimate_transfer_time(host, local_device, 4096) > 0.0);
+    }
+
+    // test if missing fits get reported
+    {
+        hpx::opencl::transfer_model model;
+
+        bool caught_exception = false;
+        try{
+            model.estimate_transfer_time(host, host, 4096);
+        } catch (hpx::exception e){
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+}